@@ -2,7 +2,7 @@
   "targets": [
     {
       "target_name": "glpk",
-      "sources": [ "src/nodeglpk.cc", "src/problem.hpp", "src/tree.hpp"],
+      "sources": [ "src/nodeglpk.cc", "src/pool.hpp", "src/progress.hpp", "src/solution.hpp", "src/file.hpp", "src/problem.hpp", "src/tree.hpp", "src/batch.hpp"],
       "cflags": [ "-fexceptions" ],
       "cflags_cc": [ "-fexceptions" ],
       "conditions": [
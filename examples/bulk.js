@@ -0,0 +1,42 @@
+var glp = require('..');
+
+var lp = new glp.Problem();
+lp.setProbName("bulk");
+lp.setObjDir(glp.MAX);
+
+lp.addRows(3);
+lp.setRowNames(Buffer.from("p\0q\0r\0"));
+lp.setRowsBnds(new Int32Array([0, glp.UP, glp.UP, glp.UP]),
+               new Float64Array([0, 0.0, 0.0, 0.0]),
+               new Float64Array([0, 100.0, 600.0, 300.0]));
+
+lp.addCols(3);
+lp.setColNames(Buffer.from("x1\0x2\0x3\0"));
+lp.setColsBnds(new Int32Array([0, glp.LO, glp.LO, glp.LO]),
+               new Float64Array(4),
+               new Float64Array(4));
+lp.setObjCoefs(new Float64Array([0, 10.0, 6.0, 4.0]));
+
+var ia = new Int32Array([0, 1, 1, 1, 2, 3, 2, 3, 2, 3]);
+var ja = new Int32Array([0, 1, 2, 3, 1, 1, 2, 2, 3, 3]);
+var ar = new Float64Array([0, 1.0, 1.0, 1.0, 10.0, 2.0, 4.0, 2.0, 5.0, 6.0]);
+lp.loadMatrix(9, ia, ja, ar);
+
+lp.createIndex();
+console.log("rows q, r = " + Array.prototype.slice.call(lp.findRows(["q", "r"])) +
+            "; cols x3, x1, y = " + Array.prototype.slice.call(lp.findCols(Buffer.from("x3\0x1\0y\0"))));
+lp.deleteIndex();
+
+lp.simplex({presolve: glp.OFF}, function(err){
+    if (err){
+        console.log(err);
+        return;
+    }
+    var x = new Float64Array(4);
+    var stat = new Int32Array(4);
+    lp.getColPrims(x);
+    lp.getColStats(stat);
+    console.log("z = " + lp.getObjVal() + "; x = " + Array.prototype.slice.call(x, 1) +
+                "; stat = " + Array.prototype.slice.call(stat, 1));
+    lp.delete();
+});
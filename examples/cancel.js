@@ -0,0 +1,24 @@
+var glp = require('..');
+
+var lp = new glp.Problem();
+lp.readMpsSync(glp.MPS_DECK, null, "25fv47.mps");
+
+var controller = new AbortController();
+controller.signal.addEventListener('abort', function(){
+    lp.cancel();
+});
+
+lp.simplex({msgLev: glp.MSG_ALL}, function(err, ret){
+    if (err){
+        console.log(err);
+    } else if (ret == glp.ESTOP){
+        console.log("search cancelled");
+    } else {
+        console.log("objective: " + lp.getObjVal());
+    }
+    lp.delete();
+});
+
+setTimeout(function(){
+    controller.abort();
+}, 50);
@@ -0,0 +1,45 @@
+// Solves a problem and a clone of it side by side and checks that both report the same
+// row and column values. A clone shares the constraint matrix of its source, so this
+// covers the solver paths that read the matrix back when storing the solution.
+// Usage: node clone.js [file.mps]
+var glp = require('..');
+
+var file = process.argv[2] || __dirname + "/25fv47.mps";
+
+function compare(name, lp, copy, get){
+    var bad = 0;
+    [["row", lp.getNumRows()], ["col", lp.getNumCols()]].forEach(function(k){
+        for (var i = 1; i <= k[1]; i++){
+            get[k[0]].forEach(function(f){
+                var a = lp[f](i), b = copy[f](i);
+                if (Math.abs(a - b) > 1e-9 * (1 + Math.abs(a))){
+                    if (bad++ < 5) console.log(name + ": " + f + "(" + i + ") = " + a + " vs " + b);
+                }
+            });
+        }
+    });
+    console.log(name + ": " + (bad ? bad + " mismatches" : "ok"));
+    return bad;
+}
+
+var sol = {row: ["getRowPrim", "getRowDual"], col: ["getColPrim", "getColDual"]};
+var ipt = {row: ["iptRowPrim", "iptRowDual"], col: ["iptColPrim", "iptColDual"]};
+
+var modes = [
+    ["simplex", sol, function(lp){ lp.simplexSync({msgLev: glp.MSG_OFF, presolve: glp.OFF}); }],
+    ["simplex+presolve", sol, function(lp){ lp.simplexSync({msgLev: glp.MSG_OFF, presolve: glp.ON}); }],
+    ["interior", ipt, function(lp){ lp.interiorSync({msgLev: glp.MSG_OFF}); }]
+];
+
+var failed = 0;
+modes.forEach(function(m){
+    var lp = new glp.Problem();
+    lp.readMpsSync(glp.MPS_FILE, null, file);
+    var copy = lp.clone();
+    m[2](lp);
+    m[2](copy);
+    failed += compare(m[0], lp, copy, m[1]);
+    copy.delete();
+    lp.delete();
+});
+process.exitCode = failed ? 1 : 0;
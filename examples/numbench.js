@@ -0,0 +1,85 @@
+// Reports the time taken to write and read back a large generated model in MPS and
+// CPLEX LP format. Half of the coefficients have a short decimal form and half use
+// full precision, which exercises both the fast and the fallback number conversions.
+// Usage: node numbench.js [rows] [cols] [repeat]
+// To compare with the sprintf/strtod paths, rebuild with NUM_NO_FAST defined for libglpk.
+var glp = require('..');
+var os = require('os');
+var fs = require('fs');
+var path = require('path');
+
+var m = parseInt(process.argv[2] || "20000");
+var n = parseInt(process.argv[3] || "20000");
+var repeat = parseInt(process.argv[4] || "3");
+var perCol = 10;
+
+// a simple linear congruential generator keeps the model the same from run to run
+var seed = 1;
+function rand(){
+    seed = (seed * 16807) % 2147483647;
+    return (seed - 1) / 2147483646;
+}
+function value(){
+    return rand() < 0.5 ? Math.round(rand() * 1000) / 100 : rand() * 100;
+}
+
+var lp = new glp.Problem();
+lp.setProbName("numbench");
+lp.setObjName("obj");
+lp.addRows(m);
+for (var i = 1; i <= m; i++){
+    lp.setRowName(i, "r" + i);
+    lp.setRowBnds(i, glp.UP, 0.0, value());
+}
+lp.addCols(n);
+for (var j = 1; j <= n; j++){
+    lp.setColName(j, "x" + j);
+    lp.setColBnds(j, glp.DB, 0.0, value());
+    lp.setObjCoef(j, value());
+}
+var nnz = n * perCol;
+var ia = new Int32Array(nnz + 1);
+var ja = new Int32Array(nnz + 1);
+var ar = new Float64Array(nnz + 1);
+for (var j = 1, k = 0; j <= n; j++){
+    var first = Math.floor(rand() * m);
+    for (var t = 0; t < perCol; t++){
+        k++;
+        ia[k] = 1 + (first + t * Math.floor(m / perCol)) % m;
+        ja[k] = j;
+        ar[k] = value();
+    }
+}
+lp.loadMatrix(nnz, ia, ja, ar);
+
+function time(f){
+    var best = Infinity;
+    for (var r = 0; r < repeat; r++){
+        var t = process.hrtime();
+        f();
+        t = process.hrtime(t);
+        best = Math.min(best, t[0] * 1e3 + t[1] / 1e6);
+    }
+    return best;
+}
+
+[
+    ["mps", function(file){ lp.writeMpsSync(glp.MPS_FILE, null, file); },
+        function(p, file){ p.readMpsSync(glp.MPS_FILE, null, file); }],
+    ["lp", function(file){ lp.writeLpSync(file); },
+        function(p, file){ p.readLpSync(file); }]
+].forEach(function(f){
+    var file = path.join(os.tmpdir(), "numbench-" + process.pid + "." + f[0]);
+    var write = time(function(){ f[1](file); });
+    var size = fs.statSync(file).size / 1048576;
+    var read = time(function(){
+        var p = new glp.Problem();
+        f[2](p, file);
+        p.delete();
+    });
+    fs.unlinkSync(file);
+    console.log(f[0] + ": " + size.toFixed(1) + " MB; write " + write.toFixed(0) + " ms ("
+        + (size / write * 1e3).toFixed(1) + " MB/s); read " + read.toFixed(0) + " ms ("
+        + (size / read * 1e3).toFixed(1) + " MB/s)");
+});
+lp.delete();
@@ -0,0 +1,25 @@
+// Reports the average time of one simplex iteration (primal and dual) on an MPS model.
+// Usage: node simplexbench.js [file.mps] [repeat]
+// To compare with the scalar kernels, rebuild with SPX_NO_SIMD defined for libglpk.
+var glp = require('..');
+
+var file = process.argv[2] || __dirname + "/25fv47.mps";
+var repeat = parseInt(process.argv[3] || "3");
+
+[["primal", glp.PRIMAL], ["dual", glp.DUAL]].forEach(function(m){
+    var best = Infinity, its = 0, z = 0;
+    for (var r = 0; r < repeat; r++){
+        var lp = new glp.Problem();
+        lp.readMpsSync(glp.MPS_FILE, null, file);
+        lp.scaleSync(glp.SF_AUTO);
+        lp.advBasis(0);
+        var t = process.hrtime();
+        lp.simplexSync({meth: m[1], msgLev: glp.MSG_OFF, presolve: glp.OFF});
+        t = process.hrtime(t);
+        its = lp.getItCnt();
+        z = lp.getObjVal();
+        best = Math.min(best, (t[0] * 1e6 + t[1] / 1e3) / its);
+        lp.delete();
+    }
+    console.log(m[0] + ": z = " + z + "; " + its + " iterations; " + best.toFixed(2) + " us/iteration");
+});
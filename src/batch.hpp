@@ -0,0 +1,184 @@
+#ifndef _batch_hpp
+#define _batch_hpp
+
+#include <node.h>
+#include <string>
+#include <vector>
+
+#include "glpk/glpk.h"
+#include "common.h"
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    // glp.solveBatch(problems, params, callback) solves every problem with the simplex method.
+    // At most one job per solver thread is queued, each job pulls the next problem until none
+    // is left, and the callback runs once with packed per-problem results. A problem for which
+    // GLPK raised an error gets ret -1 and its message in errors[i] (null for the others).
+    class Batch {
+    public:
+        static void Init(Handle<Object> exports){
+            exports->Set(Nan::New<String>("solveBatch").ToLocalChecked(), Nan::New<FunctionTemplate>(SolveBatch)->GetFunction());
+        }
+
+    private:
+        Batch(): callback(NULL), next(0), workers(0) {
+            uv_mutex_init(&mutex);
+            glp_init_smcp(&smcp);
+        }
+
+        ~Batch(){
+            uv_mutex_destroy(&mutex);
+            for (size_t i = 0; i < handles.size(); i++) {
+                handles[i]->Reset();
+                delete handles[i];
+            }
+            delete callback;
+        }
+
+        int Next(){
+            uv_mutex_lock(&mutex);
+            int ret = (next < (int)lps.size()) ? next++ : -1;
+            uv_mutex_unlock(&mutex);
+            return ret;
+        }
+
+        void Finish(){
+            Nan::HandleScope scope;
+            int count = (int)lps.size();
+            for (int i = 0; i < count; i++) lps[i]->thread = false;
+
+            Local<ArrayBuffer> rbuf = ArrayBuffer::New(Isolate::GetCurrent(), count * sizeof(int));
+            Local<ArrayBuffer> sbuf = ArrayBuffer::New(Isolate::GetCurrent(), count * sizeof(int));
+            Local<ArrayBuffer> obuf = ArrayBuffer::New(Isolate::GetCurrent(), count * sizeof(double));
+            if (count > 0) {
+                memcpy(rbuf->GetContents().Data(), &ret[0], count * sizeof(int));
+                memcpy(sbuf->GetContents().Data(), &status[0], count * sizeof(int));
+                memcpy(obuf->GetContents().Data(), &obj[0], count * sizeof(double));
+            }
+
+            Local<Object> result = Nan::New<Object>();
+            result->Set(Nan::New<String>("ret").ToLocalChecked(), Int32Array::New(rbuf, 0, count));
+            result->Set(Nan::New<String>("status").ToLocalChecked(), Int32Array::New(sbuf, 0, count));
+            result->Set(Nan::New<String>("obj").ToLocalChecked(), Float64Array::New(obuf, 0, count));
+            Local<Array> elist = Nan::New<Array>(count);
+            for (int i = 0; i < count; i++) {
+                if (errors[i].empty()) elist->Set(i, Nan::Null());
+                else elist->Set(i, Nan::New<String>(errors[i]).ToLocalChecked());
+            }
+            result->Set(Nan::New<String>("errors").ToLocalChecked(), elist);
+
+            Local<Value> info[] = {Nan::Null(), result};
+            callback->Call(2, info);
+        }
+
+        class Worker : public Nan::AsyncWorker {
+        public:
+            Worker(Batch *batch): Nan::AsyncWorker(NULL), batch(batch) {}
+
+            void Execute(){
+                int i;
+                while ((i = batch->Next()) >= 0) {
+                    glp_prob *lp = batch->lps[i]->handle;
+                    try {
+                        batch->ret[i] = glp_simplex(lp, &batch->smcp);
+                        batch->status[i] = glp_get_status(lp);
+                        batch->obj[i] = glp_get_obj_val(lp);
+                    } catch (std::string s){
+                        batch->errors[i] = s.empty() ? "glpk error" : s;
+                        batch->ret[i] = -1;
+                        batch->status[i] = GLP_UNDEF;
+                        batch->obj[i] = 0.0;
+                    }
+                }
+            }
+
+            void WorkComplete(){
+                if (--batch->workers == 0) {
+                    batch->Finish();
+                    delete batch;
+                }
+            }
+
+        private:
+            Batch *batch;
+        };
+
+        static NAN_METHOD(SolveBatch) {
+            V8CHECK(info.Length() != 3, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsArray() || !(info[1]->IsObject() || info[1]->IsNull())
+                    || !info[2]->IsFunction(), "Wrong arguments");
+
+            Local<Array> list = Local<Array>::Cast(info[0]);
+            Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(Problem::constructor);
+            Batch *batch = new Batch();
+            batch->callback = new Nan::Callback(info[2].As<Function>());
+
+            // problems are marked busy as they are collected, so a duplicate is rejected too
+            for (uint32_t i = 0; i < list->Length(); i++) {
+                Local<Value> val = list->Get(i);
+                Problem *lp = tpl->HasInstance(val) ? ObjectWrap::Unwrap<Problem>(val->ToObject()) : NULL;
+                const char *error = !lp ? "problems: should be an array of Problem"
+                    : !lp->handle ? "object deleted"
+                    : lp->thread ? "an async operation is inprogress" : NULL;
+                if (error) {
+                    for (size_t j = 0; j < batch->lps.size(); j++) batch->lps[j]->thread = false;
+                    delete batch;
+                    Nan::ThrowError(error);
+                    return;
+                }
+                lp->thread = true;
+                batch->lps.push_back(lp);
+                // each Problem is rooted, so it can't be collected while a pool thread solves
+                // it even if the caller changes the array
+                batch->handles.push_back(new Nan::Persistent<Object>(val->ToObject()));
+            }
+
+            if (info[1]->IsObject() && !Problem::SmcpInit(&batch->smcp, info[1])) {
+                for (size_t j = 0; j < batch->lps.size(); j++) batch->lps[j]->thread = false;
+                SolverProgress::Release(&batch->smcp);
+                delete batch;
+                return;
+            }
+            // progress reports can't be delivered from several threads at once
+            SolverProgress::Release(&batch->smcp);
+
+            size_t count = batch->lps.size();
+            batch->ret.resize(count);
+            batch->status.resize(count);
+            batch->obj.resize(count);
+            batch->errors.resize(count);
+
+            int threads = SolverPool::Size();
+            if ((size_t)threads > count) threads = (int)count;
+            if (threads < 1) threads = 1;
+            for (int i = 0; i < threads; i++) {
+                Worker *worker = new Worker(batch);
+                if (!SolverPool::Queue(worker, 0)) {
+                    worker->Destroy();
+                    break;
+                }
+                batch->workers++;
+            }
+
+            if (batch->workers == 0) {
+                for (size_t j = 0; j < count; j++) batch->lps[j]->thread = false;
+                delete batch;
+                Nan::ThrowError("the solver queue is full");
+            }
+        }
+
+        std::vector<Problem*> lps;
+        std::vector<int> ret, status;
+        std::vector<double> obj;
+        std::vector<std::string> errors;
+        glp_smcp smcp;
+        Nan::Callback *callback;
+        std::vector<Nan::Persistent<Object>*> handles;
+        uv_mutex_t mutex;
+        int next, workers;
+    };
+}
+
+#endif
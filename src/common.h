@@ -159,27 +159,19 @@ static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 3, "Wrong number of arguments");\
     V8CHECK(!info[0]->IsUint32() || !info[1]->IsInt32Array() || !info[2]->IsFloat64Array(), "Wrong arguments");\
     \
-    Local<Int32Array> ja = Local<Int32Array>::Cast(info[1]);\
-    Local<Float64Array> ar = Local<Float64Array>::Cast(info[2]);\
+    Nan::TypedArrayContents<int> ja(info[1]);\
+    Nan::TypedArrayContents<double> ar(info[2]);\
     \
-    uint32_t count = ja->Length();\
-    V8CHECK(ar->Length() != count, "the tow arrays must have the same length");\
+    size_t count = ja.length();\
+    V8CHECK(ar.length() != count, "the tow arrays must have the same length");\
+    V8CHECK(count < 1, "Invalid Array size");\
     count--;\
     \
     CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
     V8CHECK(!host->handle, "object deleted");\
     V8CHECK(host->thread, "an async operation is inprogress")\
     \
-    int* pja = (int*)malloc(ja->Length() * sizeof(int));\
-    double* par = (double*)malloc(ar->Length() * sizeof(double));\
-    \
-    for (size_t i = 0; i < ja->Length(); i++) pja[i] = ja->Get(i)->Int32Value();\
-    for (size_t i = 0; i < ar->Length(); i++) par[i] = ar->Get(i)->NumberValue();\
-    \
-    GLP_CATCH_RET(API(host->handle, info[0]->Int32Value(), count, pja, par);)\
-    \
-    free(pja);\
-    free(par);\
+    GLP_CATCH_RET(API(host->handle, info[0]->Int32Value(), (int)count, *ja, *ar);)\
 }
 
 #define GLP_BIND_VALUE_INT32_CALLBACK(CLASS, NAME, API)\
@@ -217,6 +209,158 @@ static NAN_METHOD(NAME) {\
     }\
 }
 
+#define GLP_BULK_INDEX(IDX, I) ((IDX) ? (IDX)[I] : (I))
+
+#define GLP_BULK_COUNT(ARGC, HANDLE, COUNT)\
+    int* pidx = NULL;\
+    int count = COUNT(HANDLE);\
+    Nan::TypedArrayContents<int> idx(info[ARGC]);\
+    if (info.Length() == ARGC + 1) {\
+        V8CHECK(!info[ARGC]->IsInt32Array() || (idx.length() < 1), "Invalid index array");\
+        pidx = *idx;\
+        count = (int)idx.length() - 1;\
+    }
+
+#define GLP_BIND_BULK_ARRAY(CLASS, NAME, API, COUNT, ISARRAY, TYPE)\
+static NAN_METHOD(NAME) {\
+    V8CHECK((info.Length() < 1) || (info.Length() > 2), "Wrong number of arguments");\
+    V8CHECK(!info[0]->ISARRAY(), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    Nan::TypedArrayContents<TYPE> out(info[0]);\
+    GLP_CATCH_RET(\
+        GLP_BULK_COUNT(1, host->handle, COUNT)\
+        V8CHECK(out.length() <= (size_t)count, "Invalid arrays length");\
+        for (int i = 1; i <= count; i++) (*out)[i] = API(host->handle, GLP_BULK_INDEX(pidx, i));\
+        info.GetReturnValue().Set(count);\
+    )\
+}
+
+#define GLP_BIND_BULK_FLOAT64ARRAY(CLASS, NAME, API, COUNT)\
+GLP_BIND_BULK_ARRAY(CLASS, NAME, API, COUNT, IsFloat64Array, double)
+
+#define GLP_BIND_BULK_INT32ARRAY(CLASS, NAME, API, COUNT)\
+GLP_BIND_BULK_ARRAY(CLASS, NAME, API, COUNT, IsInt32Array, int)
+
+#define GLP_BIND_BULK_SET_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(CLASS, NAME, API, COUNT)\
+static NAN_METHOD(NAME) {\
+    V8CHECK((info.Length() < 3) || (info.Length() > 4), "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsInt32Array() || !info[1]->IsFloat64Array() || !info[2]->IsFloat64Array(), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    Nan::TypedArrayContents<int> type(info[0]);\
+    Nan::TypedArrayContents<double> lb(info[1]);\
+    Nan::TypedArrayContents<double> ub(info[2]);\
+    GLP_CATCH_RET(\
+        GLP_BULK_COUNT(3, host->handle, COUNT)\
+        V8CHECK((type.length() <= (size_t)count) || (lb.length() <= (size_t)count)\
+                || (ub.length() <= (size_t)count), "Invalid arrays length");\
+        for (int i = 1; i <= count; i++)\
+            API(host->handle, GLP_BULK_INDEX(pidx, i), (*type)[i], (*lb)[i], (*ub)[i]);\
+    )\
+}
+
+#define GLP_BIND_BULK_SET_ARRAY(CLASS, NAME, API, COUNT, ISARRAY, TYPE)\
+static NAN_METHOD(NAME) {\
+    V8CHECK((info.Length() < 1) || (info.Length() > 2), "Wrong number of arguments");\
+    V8CHECK(!info[0]->ISARRAY(), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    Nan::TypedArrayContents<TYPE> val(info[0]);\
+    GLP_CATCH_RET(\
+        GLP_BULK_COUNT(1, host->handle, COUNT)\
+        V8CHECK(val.length() <= (size_t)count, "Invalid arrays length");\
+        for (int i = 1; i <= count; i++)\
+            API(host->handle, GLP_BULK_INDEX(pidx, i), (*val)[i]);\
+    )\
+}
+
+#define GLP_BIND_BULK_SET_FLOAT64ARRAY(CLASS, NAME, API, COUNT)\
+GLP_BIND_BULK_SET_ARRAY(CLASS, NAME, API, COUNT, IsFloat64Array, double)
+
+#define GLP_BIND_BULK_SET_INT32ARRAY(CLASS, NAME, API, COUNT)\
+GLP_BIND_BULK_SET_ARRAY(CLASS, NAME, API, COUNT, IsInt32Array, int)
+
+// names are packed back to back in a Buffer, each one terminated by '\0'
+#define GLP_BIND_BULK_SET_NAMES(CLASS, NAME, API, COUNT)\
+static NAN_METHOD(NAME) {\
+    V8CHECK((info.Length() < 1) || (info.Length() > 2), "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsUint8Array(), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    Nan::TypedArrayContents<char> names(info[0]);\
+    GLP_CATCH_RET(\
+        GLP_BULK_COUNT(1, host->handle, COUNT)\
+        const char* p = *names;\
+        const char* end = p + names.length();\
+        for (int i = 1; i <= count; i++) {\
+            V8CHECK(p >= end, "Invalid names buffer");\
+            const char* q = (const char*)memchr(p, 0, end - p);\
+            if (q) {\
+                API(host->handle, GLP_BULK_INDEX(pidx, i), p);\
+                p = q + 1;\
+            } else {\
+                API(host->handle, GLP_BULK_INDEX(pidx, i), std::string(p, end - p).c_str());\
+                p = end;\
+            }\
+        }\
+    )\
+}
+
+// names are given as an Array of strings or packed like for GLP_BIND_BULK_SET_NAMES, the
+// returned Int32Array holds the ordinal number of every name in the same order, 0 if not found
+#define GLP_BIND_BULK_FIND(CLASS, NAME, API)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 1, "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsArray() && !info[0]->IsUint8Array(), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    std::vector<int> ret;\
+    GLP_CATCH_RET(\
+        if (info[0]->IsArray()) {\
+            Local<Array> names = Local<Array>::Cast(info[0]);\
+            ret.resize(names->Length());\
+            for (uint32_t k = 0; k < names->Length(); k++) {\
+                Local<Value> name = names->Get(k);\
+                V8CHECK(!name->IsString(), "names: should be an array of strings");\
+                ret[k] = API(host->handle, V8TOCSTRING(name));\
+            }\
+        } else {\
+            Nan::TypedArrayContents<char> names(info[0]);\
+            const char* p = *names;\
+            const char* end = p + names.length();\
+            while (p < end) {\
+                const char* q = (const char*)memchr(p, 0, end - p);\
+                if (q) {\
+                    ret.push_back(API(host->handle, p));\
+                    p = q + 1;\
+                } else {\
+                    ret.push_back(API(host->handle, std::string(p, end - p).c_str()));\
+                    p = end;\
+                }\
+            }\
+        }\
+    )\
+    Local<Int32Array> result = Int32Array::New(ArrayBuffer::New(Isolate::GetCurrent(), ret.size() * sizeof(int)), 0, ret.size());\
+    if (!ret.empty()) memcpy(result->Buffer()->GetContents().Data(), &ret[0], ret.size() * sizeof(int));\
+    info.GetReturnValue().Set(result);\
+}
+
 #define GLP_BIND_VOID(CLASS, NAME, API)\
 static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 0, "Wrong number of arguments");\
@@ -232,20 +376,17 @@ static NAN_METHOD(NAME) {\
 static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 1, "Wrong number of arguments");\
     V8CHECK(!info[0]->IsInt32Array(), "Wrong arguments");\
-    Local<Int32Array> num = Local<Int32Array>::Cast(info[0]);\
+    Nan::TypedArrayContents<int> num(info[0]);\
     \
-    int count = num->Length();\
+    int count = (int)num.length();\
     V8CHECK(count <= 1, "Invalid Array size");\
     \
-    int* idx = (int*)malloc(count * sizeof(int));\
-    for (int i = 0; i < count; i++) idx[i] = num->Get(i)->Int32Value();\
     CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
     V8CHECK(!host->handle, "object deleted");\
     V8CHECK(host->thread, "an async operation is inprogress")\
     \
     count--;\
-    GLP_CATCH_RET(API(host->handle, count, idx);)\
-    free(idx);\
+    GLP_CATCH_RET(API(host->handle, count, *num);)\
 }
 
 #define GLP_BIND_VALUE_STR(CLASS, NAME, API)\
@@ -284,6 +425,42 @@ static NAN_METHOD(NAME) {\
     GLP_CATCH_RET(info.GetReturnValue().Set(API(host->handle, info[0]->Int32Value(), V8TOCSTRING(info[1])));)\
 }
 
+#define GLP_BIND_VALUE_FILE(CLASS, NAME, API)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 1, "Wrong number of arguments");\
+    V8CHECK(!FileArg::Check(info[0]), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    FileArg file;\
+    if (!file.Init(info[0])) return;\
+    GLP_CATCH_RET(int ret = API(host->handle, file.Name());\
+    if (file.Output())\
+        info.GetReturnValue().Set(file.Content(ret));\
+    else\
+        info.GetReturnValue().Set(ret);)\
+}
+
+#define GLP_BIND_VALUE_INT32_FILE(CLASS, NAME, API)\
+static NAN_METHOD(NAME) {\
+    V8CHECK(info.Length() != 2, "Wrong number of arguments");\
+    V8CHECK(!info[0]->IsInt32() || !FileArg::Check(info[1]), "Wrong arguments");\
+    \
+    CLASS* host = ObjectWrap::Unwrap<CLASS>(info.Holder());\
+    V8CHECK(!host->handle, "object deleted");\
+    V8CHECK(host->thread, "an async operation is inprogress")\
+    \
+    FileArg file;\
+    if (!file.Init(info[1])) return;\
+    GLP_CATCH_RET(int ret = API(host->handle, info[0]->Int32Value(), file.Name());\
+    if (file.Output())\
+        info.GetReturnValue().Set(file.Content(ret));\
+    else\
+        info.GetReturnValue().Set(ret);)\
+}
+
 #define GLP_BIND_VALUE_STR_INT32(CLASS, NAME, API)\
 static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 2, "Wrong number of arguments");\
@@ -316,14 +493,14 @@ OBJ->Set(Nan::New<String>(KEY).ToLocalChecked(), Nan::New<Number>(VALUE));
 #define GLP_ASYNC_INT32_STR(CLASS, NAME, API)\
 class NAME##Worker : public Nan::AsyncWorker {\
 public:\
-NAME##Worker(Nan::Callback *callback, CLASS *lp, std::string file)\
-: Nan::AsyncWorker(callback), lp(lp), file(file){\
+NAME##Worker(Nan::Callback *callback, CLASS *lp)\
+: Nan::AsyncWorker(callback), lp(lp){\
     \
 }\
 \
 void Execute () {\
     try {\
-        ret = API(lp->handle, file.c_str());\
+        ret = API(lp->handle, file.Name());\
     } catch (std::string s) {\
         Nan::ThrowError(s.c_str());\
     }\
@@ -333,35 +510,43 @@ void WorkComplete() {\
     Nan::AsyncWorker::WorkComplete();\
 }\
 virtual void HandleOKCallback() {\
-    Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};\
-    callback->Call(2, info);\
+    Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};\
+    callback->Call(file.Output() ? 3 : 2, info);\
 }\
 \
 public:\
     int ret;\
     CLASS *lp;\
-    std::string file;\
+    FileArg file;\
 };\
 \
 static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 2, "Wrong number of arguments");\
-    V8CHECK(!info[0]->IsString() || !info[1]->IsFunction(), "Wrong arguments");\
+    V8CHECK(!FileArg::Check(info[0]) || !info[1]->IsFunction(), "Wrong arguments");\
     \
     CLASS* lp = ObjectWrap::Unwrap<CLASS>(info.Holder());\
     V8CHECK(!lp->handle, "object deleted");\
     V8CHECK(lp->thread, "an async operation is inprogress")\
     \
     Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());\
-    NAME##Worker *worker = new NAME##Worker(callback, lp, V8TOCSTRING(info[0]));\
+    NAME##Worker *worker = new NAME##Worker(callback, lp);\
+    if (!worker->file.Init(info[0], true)) {\
+        worker->Destroy();\
+        return;\
+    }\
+    if (worker->file.Stream()) {\
+        GLP_SOLVER_QUEUE(worker, lp->priority);\
+    } else {\
+        Nan::AsyncQueueWorker(worker);\
+    }\
     lp->thread = true;\
-    Nan::AsyncQueueWorker(worker);\
 }\
 
 #define GLP_ASYNC_INT32_INT32_STR(CLASS, NAME, API)\
 class NAME##Worker : public Nan::AsyncWorker {\
 public:\
-    NAME##Worker(Nan::Callback *callback, CLASS *lp, int flags, std::string file)\
-    : Nan::AsyncWorker(callback), flags(flags), lp(lp), file(file){\
+    NAME##Worker(Nan::Callback *callback, CLASS *lp, int flags)\
+    : Nan::AsyncWorker(callback), flags(flags), lp(lp){\
         \
     }\
     void WorkComplete() {\
@@ -370,35 +555,43 @@ public:\
     }\
     void Execute () {\
         try {\
-            ret = API(lp->handle, flags, file.c_str());\
+            ret = API(lp->handle, flags, file.Name());\
         } catch (std::string s) {\
             Nan::ThrowError(s.c_str());\
         }\
     }\
     \
     virtual void HandleOKCallback() {\
-        Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};\
-        callback->Call(2, info);\
+        Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};\
+        callback->Call(file.Output() ? 3 : 2, info);\
     }\
     \
 public:\
     int ret, flags;\
     CLASS *lp;\
-    std::string file;\
+    FileArg file;\
 };\
 \
 static NAN_METHOD(NAME) {\
     V8CHECK(info.Length() != 3, "Wrong number of arguments");\
-    V8CHECK(!info[0]->IsInt32() || !info[1]->IsString() || !info[2]->IsFunction(), "Wrong arguments");\
+    V8CHECK(!info[0]->IsInt32() || !FileArg::Check(info[1]) || !info[2]->IsFunction(), "Wrong arguments");\
     \
     CLASS* lp = ObjectWrap::Unwrap<CLASS>(info.Holder());\
     V8CHECK(!lp->handle, "object deleted");\
     V8CHECK(lp->thread, "an async operation is inprogress")\
     \
     Nan::Callback *callback = new Nan::Callback(info[2].As<Function>());\
-    NAME##Worker *worker = new NAME##Worker(callback, lp, info[0]->Int32Value(), V8TOCSTRING(info[1]));\
+    NAME##Worker *worker = new NAME##Worker(callback, lp, info[0]->Int32Value());\
+    if (!worker->file.Init(info[1], true)) {\
+        worker->Destroy();\
+        return;\
+    }\
+    if (worker->file.Stream()) {\
+        GLP_SOLVER_QUEUE(worker, lp->priority);\
+    } else {\
+        Nan::AsyncQueueWorker(worker);\
+    }\
     lp->thread = true;\
-    Nan::AsyncQueueWorker(worker);\
 }\
 
 #define GLP_ASYNC_VOID(CLASS, NAME, API)\
@@ -0,0 +1,268 @@
+#ifndef _file_hpp
+#define _file_hpp
+
+#include <node.h>
+#include <deque>
+#include <string>
+
+#include "glpk/glpk.h"
+#include "common.h"
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    // Feeds the content of a Readable to a glp_buffer read on a solver thread. The reader
+    // waits for chunks as they arrive, the stream is paused while too much data is queued.
+    class StreamSource {
+    public:
+        explicit StreamSource(Local<Object> readable): queued(0), offset(0), ended(false), failed(false), paused(false){
+            uv_mutex_init(&mutex);
+            uv_cond_init(&cond);
+            async = new uv_async_t;
+            uv_async_init(Nan::GetCurrentEventLoop(), async, Resume);
+            async->data = this;
+
+            stream.Reset(readable);
+            onData.Reset(Listener(OnData));
+            onEnd.Reset(Listener(OnEnd));
+            onError.Reset(Listener(OnError));
+            onClose.Reset(Listener(OnClose));
+            Listen("on");
+        }
+
+        ~StreamSource(){
+            Nan::HandleScope scope;
+            Listen("removeListener");
+            stream.Reset();
+            onData.Reset();
+            onEnd.Reset();
+            onError.Reset();
+            onClose.Reset();
+            uv_mutex_destroy(&mutex);
+            uv_cond_destroy(&cond);
+            uv_close((uv_handle_t*)async, Close);
+        }
+
+        static bool IsReadable(Local<Value> val){
+            if (!val->IsObject() || val->IsUint8Array()) return false;
+            Local<Object> obj = val->ToObject();
+            return obj->Get(Nan::New<String>("on").ToLocalChecked())->IsFunction()
+                && obj->Get(Nan::New<String>("pause").ToLocalChecked())->IsFunction()
+                && obj->Get(Nan::New<String>("resume").ToLocalChecked())->IsFunction();
+        }
+
+        // glp_create_stream producer, runs on the solver thread.
+        static int Read(void *info, void *buf, int size){
+            StreamSource *self = (StreamSource*)info;
+            int count = 0;
+            uv_mutex_lock(&self->mutex);
+            while (self->chunks.empty() && !self->ended && !self->failed)
+                uv_cond_wait(&self->cond, &self->mutex);
+            if (self->failed) count = -1;
+            while ((count >= 0) && (count < size) && !self->chunks.empty()) {
+                std::string &chunk = self->chunks.front();
+                size_t len = chunk.size() - self->offset;
+                if (len > (size_t)(size - count)) len = size - count;
+                memcpy((char*)buf + count, chunk.data() + self->offset, len);
+                count += (int)len;
+                self->offset += len;
+                self->queued -= len;
+                if (self->offset == chunk.size()) {
+                    self->chunks.pop_front();
+                    self->offset = 0;
+                }
+            }
+            bool resume = self->paused && (self->queued <= LowWater);
+            if (resume) self->paused = false;
+            uv_mutex_unlock(&self->mutex);
+            if (resume) uv_async_send(self->async);
+            return count;
+        }
+
+    private:
+        static const size_t HighWater = 4 << 20;
+        static const size_t LowWater = 1 << 20;
+
+        Local<Function> Listener(Nan::FunctionCallback func){
+            return Nan::New<FunctionTemplate>(func, Nan::New<External>(this))->GetFunction();
+        }
+
+        void Listen(const char *method){
+            Local<Object> obj = Nan::New(stream);
+            Local<Value> data[] = {Nan::New<String>("data").ToLocalChecked(), Nan::New(onData)};
+            Nan::MakeCallback(obj, method, 2, data);
+            Local<Value> end[] = {Nan::New<String>("end").ToLocalChecked(), Nan::New(onEnd)};
+            Nan::MakeCallback(obj, method, 2, end);
+            Local<Value> error[] = {Nan::New<String>("error").ToLocalChecked(), Nan::New(onError)};
+            Nan::MakeCallback(obj, method, 2, error);
+            Local<Value> close[] = {Nan::New<String>("close").ToLocalChecked(), Nan::New(onClose)};
+            Nan::MakeCallback(obj, method, 2, close);
+        }
+
+        static StreamSource* Self(Nan::NAN_METHOD_ARGS_TYPE info){
+            return (StreamSource*)info.Data().As<External>()->Value();
+        }
+
+        static NAN_METHOD(OnData) {
+            StreamSource *self = Self(info);
+            std::string chunk;
+            if (info.Length() > 0 && info[0]->IsUint8Array()) {
+                Nan::TypedArrayContents<char> contents(info[0]);
+                chunk.assign(*contents, contents.length());
+            } else if (info.Length() > 0 && info[0]->IsString()) {
+                chunk = V8TOCSTRING(info[0]);
+            }
+            if (chunk.empty()) return;
+
+            uv_mutex_lock(&self->mutex);
+            self->queued += chunk.size();
+            self->chunks.push_back(std::string());
+            self->chunks.back().swap(chunk);
+            bool pause = !self->paused && (self->queued >= HighWater);
+            if (pause) self->paused = true;
+            uv_cond_signal(&self->cond);
+            uv_mutex_unlock(&self->mutex);
+            if (pause) Nan::MakeCallback(Nan::New(self->stream), "pause", 0, NULL);
+        }
+
+        static NAN_METHOD(OnEnd) {
+            StreamSource *self = Self(info);
+            uv_mutex_lock(&self->mutex);
+            self->ended = true;
+            uv_cond_signal(&self->cond);
+            uv_mutex_unlock(&self->mutex);
+        }
+
+        static NAN_METHOD(OnError) {
+            StreamSource *self = Self(info);
+            uv_mutex_lock(&self->mutex);
+            self->failed = true;
+            uv_cond_signal(&self->cond);
+            uv_mutex_unlock(&self->mutex);
+        }
+
+        // A stream destroyed without an error emits only 'close'; unless the content has
+        // ended, the reader must not wait for more.
+        static NAN_METHOD(OnClose) {
+            StreamSource *self = Self(info);
+            uv_mutex_lock(&self->mutex);
+            if (!self->ended) self->failed = true;
+            uv_cond_signal(&self->cond);
+            uv_mutex_unlock(&self->mutex);
+        }
+
+        static NAUV_WORK_CB(Resume) {
+            Nan::HandleScope scope;
+            StreamSource *self = (StreamSource*)async->data;
+            Nan::MakeCallback(Nan::New(self->stream), "resume", 0, NULL);
+        }
+
+        static void Close(uv_handle_t* handle) {
+            delete (uv_async_t*)handle;
+        }
+
+        Nan::Persistent<Object> stream;
+        Nan::Persistent<Function> onData, onEnd, onError, onClose;
+        uv_mutex_t mutex;
+        uv_cond_t cond;
+        uv_async_t *async;
+        std::deque<std::string> chunks;
+        size_t queued, offset;
+        bool ended, failed, paused;
+    };
+
+    // File argument of the read/write methods. Besides a path it accepts a Buffer/Uint8Array
+    // or, for async reads, a Readable to read from, or null/{gzip: bool} to write into memory;
+    // the written content is handed back as a Buffer. Gzipped input is detected from its content.
+    class FileArg {
+    public:
+        FileArg(): buf(NULL), source(NULL), output(false) {}
+
+        ~FileArg(){
+            if (buf) glp_delete_buffer(buf);
+            delete source;
+            data.Reset();
+        }
+
+        static bool Check(Local<Value> val){
+            return val->IsString() || val->IsNull() || val->IsObject();
+        }
+
+        // Main thread. Returns false with a pending exception if the argument is invalid.
+        bool Init(Local<Value> val, bool async = false){
+            if (val->IsString()) {
+                name = V8TOCSTRING(val);
+                // in-memory files are only reachable through the arguments that create them
+                V8CHECKBOOL(name.compare(0, 12, "/dev/buffer/") == 0, "invalid file name");
+                return true;
+            }
+            if (StreamSource::IsReadable(val)) {
+                V8CHECKBOOL(!async, "a stream can only be read by an async method");
+                source = new StreamSource(val->ToObject());
+                buf = glp_create_stream(StreamSource::Read, source);
+            } else if (val->IsUint8Array()) {
+                Nan::TypedArrayContents<unsigned char> contents(val);
+                // the Buffer is kept alive until the operation completes, its content is not copied
+                data.Reset(val->ToObject());
+                buf = glp_create_buffer(*contents, contents.length(), GLP_OFF);
+            } else {
+                int gzip = GLP_OFF;
+                if (val->IsObject()) {
+                    Local<Object> obj = val->ToObject();
+                    Local<Array> props = obj->GetPropertyNames();
+                    for(uint32_t i = 0; i < props->Length(); i++){
+                        Local<Value> key = props->Get(i);
+                        Local<Value> value = obj->Get(key);
+                        std::string keystr = std::string(V8TOCSTRING(key));
+                        if (keystr == "gzip"){
+                            V8CHECKBOOL(!value->IsBoolean(), "gzip: should be a boolean");
+                            gzip = value->BooleanValue() ? GLP_ON : GLP_OFF;
+                        } else {
+                            std::string error("Unknow field: ");
+                            error += keystr;
+                            V8CHECKBOOL(true, error.c_str());
+                        }
+                    }
+                }
+                buf = glp_create_buffer(NULL, 0, gzip);
+                output = true;
+            }
+            name = glp_buffer_name(buf);
+            return true;
+        }
+
+        const char* Name(){
+            return name.c_str();
+        }
+
+        bool Output(){
+            return buf && output;
+        }
+
+        // The reader may wait for a producer, so it must not occupy a libuv threadpool slot.
+        bool Stream(){
+            return source != NULL;
+        }
+
+        // Main thread. Buffer holding the written content, or null if the operation failed.
+        Local<Value> Content(int ret){
+            if (!Output() || ret != 0) return Nan::Null();
+            size_t size;
+            const char *content = (const char*)glp_buffer_data(buf, &size);
+            return Nan::CopyBuffer(content, (uint32_t)size).ToLocalChecked();
+        }
+
+    private:
+        FileArg(const FileArg&);
+        FileArg& operator=(const FileArg&);
+
+        std::string name;
+        glp_buffer *buf;
+        StreamSource *source;
+        bool output;
+        Nan::Persistent<Object> data;
+    };
+}
+
+#endif
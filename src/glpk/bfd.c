@@ -59,8 +59,16 @@ struct BFD
       double i_norm;
       /* estimated 1-norm of matrix inv(B) */
 #endif
+      double f_dens, b_dens;
+      /* predicted density of FTRAN and BTRAN results, used to choose
+       * between sparse and dense solvers */
 };
 
+/* FTRAN/BTRAN is performed with sparse solvers only if both the
+ * right-hand side and the predicted result have density not exceeding
+ * this value; otherwise the dense solvers are faster */
+#define HYPER_DENS 0.10
+
 BFD *bfd_create_it(void)
 {     /* create LP basis factorization */
       BFD *bfd;
@@ -76,6 +84,7 @@ BFD *bfd_create_it(void)
       bfd->B = NULL;
 #endif
       bfd->upd_cnt = 0;
+      bfd->f_dens = bfd->b_dens = 0.0;
       return bfd;
 }
 
@@ -399,6 +408,46 @@ void bfd_btran(BFD *bfd, double x[])
       return;
 }
 
+void bfd_ftran_s(BFD *bfd, FVS *x)
+{     /* sparse version of bfd_ftran */
+      int m = x->n;
+      xassert(bfd->valid);
+      xassert(m > 0);
+      if (bfd->type == 1 && bfd->f_dens <= HYPER_DENS &&
+         x->nnz <= HYPER_DENS * m)
+      {  /* hypersparse case */
+         x->nnz = fhvint_ftran_s(bfd->u.fhvi, x->vec, x->nnz, x->ind);
+      }
+      else
+      {  bfd_ftran(bfd, x->vec);
+         fvs_gather_vec(x, 0.0);
+      }
+      /* update prediction with density of the result */
+      bfd->f_dens = 0.90 * bfd->f_dens + 0.10 * (double)x->nnz /
+         (double)m;
+      return;
+}
+
+void bfd_btran_s(BFD *bfd, FVS *x)
+{     /* sparse version of bfd_btran */
+      int m = x->n;
+      xassert(bfd->valid);
+      xassert(m > 0);
+      if (bfd->type == 1 && bfd->b_dens <= HYPER_DENS &&
+         x->nnz <= HYPER_DENS * m)
+      {  /* hypersparse case */
+         x->nnz = fhvint_btran_s(bfd->u.fhvi, x->vec, x->nnz, x->ind);
+      }
+      else
+      {  bfd_btran(bfd, x->vec);
+         fvs_gather_vec(x, 0.0);
+      }
+      /* update prediction with density of the result */
+      bfd->b_dens = 0.90 * bfd->b_dens + 0.10 * (double)x->nnz /
+         (double)m;
+      return;
+}
+
 int bfd_update(BFD *bfd, int j, int len, const int ind[], const double
       val[])
 {     /* update LP basis factorization */
@@ -25,6 +25,8 @@
 #ifndef BFD_H
 #define BFD_H
 
+#include "fvs.h"
+
 typedef struct BFD BFD;
 
 /* return codes: */
@@ -73,6 +75,14 @@ void bfd_ftran(BFD *bfd, double x[]);
 void bfd_btran(BFD *bfd, double x[]);
 /* perform backward transformation (solve system B'*x = b) */
 
+#define bfd_ftran_s _glp_bfd_ftran_s
+void bfd_ftran_s(BFD *bfd, FVS *x);
+/* sparse version of bfd_ftran */
+
+#define bfd_btran_s _glp_bfd_btran_s
+void bfd_btran_s(BFD *bfd, FVS *x);
+/* sparse version of bfd_btran */
+
 #define bfd_update _glp_bfd_update
 int bfd_update(BFD *bfd, int j, int len, const int ind[], const double
       val[]);
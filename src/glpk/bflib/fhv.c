@@ -583,4 +583,78 @@ void fhv_ht_solve(FHV *fhv, double x[/*1+n*/])
       return;
 }
 
+/***********************************************************************
+*  fhv_h_solve_s - solve system H * x = b with sparse right-hand side
+*
+*  This routine is a sparse version of the routine fhv_h_solve. On
+*  entry the list of indices of non-zero elements of the right-hand
+*  side vector b should be stored in locations ind[1], ..., ind[nnz].
+*  On exit the routine extends this list with indices of elements which
+*  become non-zero and returns its new length. (The list may include
+*  indices of elements which become zero due to cancellation.)
+*
+*  The array mark is a working array, which should be zero on entry
+*  and is zero on exit. */
+
+int fhv_h_solve_s(FHV *fhv, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], char mark[/*1+n*/])
+{     SVA *sva = fhv->luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      int nfs = fhv->nfs;
+      int *hh_ind = fhv->hh_ind;
+      int hh_ref = fhv->hh_ref;
+      int *hh_ptr = &sva->ptr[hh_ref-1];
+      int *hh_len = &sva->len[hh_ref-1];
+      int i, k, end, ptr;
+      double x_i;
+      for (k = 1; k <= nnz; k++)
+         mark[ind[k]] = 1;
+      for (k = 1; k <= nfs; k++)
+      {  x_i = x[i = hh_ind[k]];
+         for (end = (ptr = hh_ptr[k]) + hh_len[k]; ptr < end; ptr++)
+            x_i -= sv_val[ptr] * x[sv_ind[ptr]];
+         x[i] = x_i;
+         if (x_i != 0.0 && !mark[i])
+            mark[i] = 1, ind[++nnz] = i;
+      }
+      for (k = 1; k <= nnz; k++)
+         mark[ind[k]] = 0;
+      return nnz;
+}
+
+/***********************************************************************
+*  fhv_ht_solve_s - solve system H' * x = b with sparse right-hand side
+*
+*  This routine is a sparse version of the routine fhv_ht_solve. Its
+*  parameters are the same as for the routine fhv_h_solve_s. */
+
+int fhv_ht_solve_s(FHV *fhv, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], char mark[/*1+n*/])
+{     SVA *sva = fhv->luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      int nfs = fhv->nfs;
+      int *hh_ind = fhv->hh_ind;
+      int hh_ref = fhv->hh_ref;
+      int *hh_ptr = &sva->ptr[hh_ref-1];
+      int *hh_len = &sva->len[hh_ref-1];
+      int j, k, end, ptr;
+      double x_j;
+      for (k = 1; k <= nnz; k++)
+         mark[ind[k]] = 1;
+      for (k = nfs; k >= 1; k--)
+      {  if ((x_j = x[hh_ind[k]]) == 0.0)
+            continue;
+         for (end = (ptr = hh_ptr[k]) + hh_len[k]; ptr < end; ptr++)
+         {  x[j = sv_ind[ptr]] -= sv_val[ptr] * x_j;
+            if (!mark[j])
+               mark[j] = 1, ind[++nnz] = j;
+         }
+      }
+      for (k = 1; k <= nnz; k++)
+         mark[ind[k]] = 0;
+      return nnz;
+}
+
 /* eof */
@@ -109,6 +109,16 @@ void fhv_h_solve(FHV *fhv, double x[/*1+n*/]);
 void fhv_ht_solve(FHV *fhv, double x[/*1+n*/]);
 /* solve system H' * x = b */
 
+#define fhv_h_solve_s _glp_fhv_h_solve_s
+int fhv_h_solve_s(FHV *fhv, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], char mark[/*1+n*/]);
+/* solve system H * x = b with sparse right-hand side */
+
+#define fhv_ht_solve_s _glp_fhv_ht_solve_s
+int fhv_ht_solve_s(FHV *fhv, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], char mark[/*1+n*/]);
+/* solve system H' * x = b with sparse right-hand side */
+
 #endif
 
 /* eof */
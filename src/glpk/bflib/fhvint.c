@@ -142,6 +142,86 @@ void fhvint_btran(FHVINT *fi, double x[])
       return;
 }
 
+static void alloc_s(FHVINT *fi, int n)
+{     /* allocate working arrays used by sparse solvers */
+      int k;
+      if (fi->s_n_max >= n)
+         return;
+      if (fi->s_iw != NULL)
+         tfree(fi->s_iw);
+      if (fi->s_mark != NULL)
+         tfree(fi->s_mark);
+      if (fi->s_work != NULL)
+         tfree(fi->s_work);
+      fi->s_n_max = n;
+      fi->s_iw = talloc(1+2*n, int);
+      fi->s_mark = talloc(1+n, char);
+      fi->s_work = talloc(1+n, double);
+      for (k = 1; k <= n; k++)
+      {  fi->s_mark[k] = 0;
+         fi->s_work[k] = 0.0;
+      }
+      return;
+}
+
+int fhvint_ftran_s(FHVINT *fi, double x[], int nnz, int ind[])
+{     /* solve system A * x = b with sparse right-hand side */
+      FHV *fhv = &fi->fhv;
+      LUF *luf = fhv->luf;
+      int n = luf->n;
+      int *pp_ind = luf->pp_ind;
+      int *pp_inv = luf->pp_inv;
+      int *iw, j, k;
+      char *mark;
+      double *work;
+      xassert(fi->valid);
+      alloc_s(fi, n);
+      iw = fi->s_iw, mark = fi->s_mark, work = fi->s_work;
+      /* x = inv(V) * inv(H) * inv(F) * b (see fhvint_ftran) */
+      luf->pp_ind = fhv->p0_ind;
+      luf->pp_inv = fhv->p0_inv;
+      nnz = luf_f_solve_s(luf, x, nnz, ind, iw, mark);
+      luf->pp_ind = pp_ind;
+      luf->pp_inv = pp_inv;
+      nnz = fhv_h_solve_s(fhv, x, nnz, ind, mark);
+      nnz = luf_v_solve_s(luf, x, nnz, ind, work, iw, mark);
+      /* now x = 0, so move the solution back from work to x */
+      for (k = 1; k <= nnz; k++)
+      {  j = ind[k];
+         x[j] = work[j], work[j] = 0.0;
+      }
+      return nnz;
+}
+
+int fhvint_btran_s(FHVINT *fi, double x[], int nnz, int ind[])
+{     /* solve system A'* x = b with sparse right-hand side */
+      FHV *fhv = &fi->fhv;
+      LUF *luf = fhv->luf;
+      int n = luf->n;
+      int *pp_ind = luf->pp_ind;
+      int *pp_inv = luf->pp_inv;
+      int *iw, j, k;
+      char *mark;
+      double *work;
+      xassert(fi->valid);
+      alloc_s(fi, n);
+      iw = fi->s_iw, mark = fi->s_mark, work = fi->s_work;
+      /* x = inv(F') * inv(H') * inv(V') * b (see fhvint_btran) */
+      nnz = luf_vt_solve_s(luf, x, nnz, ind, work, iw, mark);
+      nnz = fhv_ht_solve_s(fhv, work, nnz, ind, mark);
+      luf->pp_ind = fhv->p0_ind;
+      luf->pp_inv = fhv->p0_inv;
+      nnz = luf_ft_solve_s(luf, work, nnz, ind, iw, mark);
+      luf->pp_ind = pp_ind;
+      luf->pp_inv = pp_inv;
+      /* now x = 0, so move the solution back from work to x */
+      for (k = 1; k <= nnz; k++)
+      {  j = ind[k];
+         x[j] = work[j], work[j] = 0.0;
+      }
+      return nnz;
+}
+
 double fhvint_estimate(FHVINT *fi)
 {     /* estimate 1-norm of inv(A) */
       double norm;
@@ -161,6 +241,12 @@ void fhvint_delete(FHVINT *fi)
          tfree(fi->fhv.p0_ind);
       if (fi->fhv.p0_inv != NULL)
          tfree(fi->fhv.p0_inv);
+      if (fi->s_iw != NULL)
+         tfree(fi->s_iw);
+      if (fi->s_mark != NULL)
+         tfree(fi->s_mark);
+      if (fi->s_work != NULL)
+         tfree(fi->s_work);
       tfree(fi);
       return;
 }
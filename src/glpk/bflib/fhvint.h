@@ -41,6 +41,14 @@ struct FHVINT
       /* control parameters */
       int nfs_max;
       /* required maximal number of row-like factors */
+      /*--------------------------------------------------------------*/
+      /* working arrays used by sparse solvers */
+      int s_n_max;
+      /* length of working arrays */
+      int *s_iw; /* int s_iw[1+2*s_n_max]; */
+      char *s_mark; /* char s_mark[1+s_n_max]; */
+      double *s_work; /* double s_work[1+s_n_max]; */
+      /* s_mark and s_work are kept zero between calls */
 };
 
 #define fhvint_create _glp_fhvint_create
@@ -65,6 +73,14 @@ void fhvint_ftran(FHVINT *fi, double x[]);
 void fhvint_btran(FHVINT *fi, double x[]);
 /* solve system A'* x = b */
 
+#define fhvint_ftran_s _glp_fhvint_ftran_s
+int fhvint_ftran_s(FHVINT *fi, double x[], int nnz, int ind[]);
+/* solve system A * x = b with sparse right-hand side */
+
+#define fhvint_btran_s _glp_fhvint_btran_s
+int fhvint_btran_s(FHVINT *fi, double x[], int nnz, int ind[]);
+/* solve system A'* x = b with sparse right-hand side */
+
 #define fhvint_estimate _glp_fhvint_estimate
 double fhvint_estimate(FHVINT *fi);
 /* estimate 1-norm of inv(A) */
@@ -24,6 +24,7 @@
 #include "glpenv.h"
 #include "luf.h"
 
+
 /***********************************************************************
 *  luf_store_v_cols - store matrix V = A in column-wise format
 *
@@ -656,6 +657,249 @@ void luf_vt_solve1(LUF *luf, double e[/*1+n*/], double y[/*1+n*/])
       return;
 }
 
+/***********************************************************************
+*  Sparse versions of the routines luf_f_solve, luf_ft_solve,
+*  luf_v_solve, and luf_vt_solve
+*
+*  These routines are intended for solving systems whose right-hand
+*  side vector b is sparse. On entry the array x (or b) should contain
+*  elements of b in locations x[1], ..., x[n], and the list of indices
+*  of its non-zero elements should be stored in locations ind[1], ...,
+*  ind[nnz]. On exit the routines store the list of indices of non-zero
+*  elements of the solution vector in ind[1], ..., ind[nnz'] and return
+*  nnz'. Elements not listed in ind are exact zeros both on entry and
+*  on exit (in luf_v_solve_s and luf_vt_solve_s the array b is zero on
+*  exit, and the array x should be zero on entry).
+*
+*  Only those eliminations which can change the right-hand side are
+*  performed. The set of such eliminations is determined symbolically,
+*  as the set of nodes reachable from non-zeros of b in the graph of
+*  the triangular factor, as suggested by Gilbert and Peierls, so the
+*  time spent does not depend on n. The reachable nodes are then sorted
+*  by their pivot positions, so the eliminations are performed in the
+*  same order and produce the same results as the dense routines do.
+*
+*  The arrays iw and mark are working arrays. The array mark should be
+*  zero on entry and is zero on exit. */
+
+static void sort_keys(int n, int cnt, int key[], int buf[])
+{     /* sort keys key[1], ..., key[cnt], where 1 <= key[k] <= n, in
+       * ascending order; buf[1+cnt] is a working array */
+      int count[256], shift, i, j, k, t, *src, *dst, *tmp;
+      if (cnt <= 32)
+      {  /* sort short sequence by insertions */
+         for (i = 2; i <= cnt; i++)
+         {  t = key[i];
+            for (j = i; j > 1 && key[j-1] > t; j--)
+               key[j] = key[j-1];
+            key[j] = t;
+         }
+         return;
+      }
+      /* use LSD radix sort with 8-bit digits */
+      src = key, dst = buf;
+      for (shift = 0; shift < 32 && (n >> shift) != 0; shift += 8)
+      {  memset(count, 0, sizeof(count));
+         for (k = 1; k <= cnt; k++)
+            count[(src[k] >> shift) & 255]++;
+         for (t = 0, i = 0; i < 256; i++)
+            j = count[i], count[i] = t, t += j;
+         for (k = 1; k <= cnt; k++)
+            dst[1 + count[(src[k] >> shift) & 255]++] = src[k];
+         tmp = src, src = dst, dst = tmp;
+      }
+      if (src != key)
+         memcpy(&key[1], &src[1], cnt * sizeof(int));
+      return;
+}
+
+static int reach(int n, int nnz, const int ind[], const int map1[],
+      const int map2[], const int g_ptr[], const int g_len[],
+      const int sv_ind[], const int key[], int list[], int stack[],
+      char mark[])
+{     /* determine set of nodes reachable from non-zeros of b, where
+       * node u corresponds to vector g = map2[map1[u]] of the graph
+       * (maps may be omitted), and store keys of these nodes in
+       * ascending order in list[1], ..., list[cnt] */
+      int cnt, top, k, u, v, g, ptr, end;
+      cnt = 0;
+      for (k = 1; k <= nnz; k++)
+      {  u = ind[k];
+         if (mark[u])
+            continue;
+         mark[u] = 1, list[++cnt] = u;
+         stack[top = 1] = u;
+         while (top > 0)
+         {  g = stack[top--];
+            if (map1 != NULL)
+               g = map1[g];
+            if (map2 != NULL)
+               g = map2[g];
+            for (end = (ptr = g_ptr[g]) + g_len[g]; ptr < end; ptr++)
+            {  v = sv_ind[ptr];
+               if (!mark[v])
+                  mark[v] = 1, list[++cnt] = v, stack[++top] = v;
+            }
+         }
+      }
+      /* replace nodes by their keys */
+      for (k = 1; k <= cnt; k++)
+      {  mark[list[k]] = 0;
+         list[k] = key[list[k]];
+      }
+      if (16 * cnt < n)
+      {  /* few nodes are reachable; sort their keys */
+         sort_keys(n, cnt, list, stack);
+      }
+      else
+      {  /* many nodes are reachable; collect keys by scanning all of
+          * them (keys are distinct integers in [1,n]) */
+         for (k = 1; k <= cnt; k++)
+            mark[list[k]] = 1;
+         cnt = 0;
+         for (k = 1; k <= n; k++)
+         {  list[cnt+1] = k;
+            cnt += mark[k];
+            mark[k] = 0;
+         }
+      }
+      return cnt;
+}
+
+int luf_f_solve_s(LUF *luf, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], int iw[/*1+2*n*/], char mark[/*1+n*/])
+{     int n = luf->n;
+      SVA *sva = luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      int fc_ref = luf->fc_ref;
+      int *fc_ptr = &sva->ptr[fc_ref-1];
+      int *fc_len = &sva->len[fc_ref-1];
+      int *pp_ind = luf->pp_ind;
+      int *pp_inv = luf->pp_inv;
+      int *list = iw, *stack = iw + n;
+      int j, t, cnt, ptr, end;
+      double x_j;
+      cnt = reach(n, nnz, ind, NULL, NULL, fc_ptr, fc_len, sv_ind, pp_ind,
+         list, stack, mark);
+      nnz = 0;
+      for (t = 1; t <= cnt; t++)
+      {  /* list[t]-th column of L = j-th column of F */
+         j = pp_inv[list[t]];
+         if ((x_j = x[j]) != 0.0)
+         {  ind[++nnz] = j;
+            for (end = (ptr = fc_ptr[j]) + fc_len[j]; ptr < end; ptr++)
+               x[sv_ind[ptr]] -= sv_val[ptr] * x_j;
+         }
+      }
+      return nnz;
+}
+
+int luf_ft_solve_s(LUF *luf, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], int iw[/*1+2*n*/], char mark[/*1+n*/])
+{     int n = luf->n;
+      SVA *sva = luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      int fr_ref = luf->fr_ref;
+      int *fr_ptr = &sva->ptr[fr_ref-1];
+      int *fr_len = &sva->len[fr_ref-1];
+      int *pp_ind = luf->pp_ind;
+      int *pp_inv = luf->pp_inv;
+      int *list = iw, *stack = iw + n;
+      int i, t, cnt, ptr, end;
+      double x_i;
+      cnt = reach(n, nnz, ind, NULL, NULL, fr_ptr, fr_len, sv_ind, pp_ind,
+         list, stack, mark);
+      nnz = 0;
+      for (t = cnt; t >= 1; t--)
+      {  /* list[t]-th column of L' = i-th row of F */
+         i = pp_inv[list[t]];
+         if ((x_i = x[i]) != 0.0)
+         {  ind[++nnz] = i;
+            for (end = (ptr = fr_ptr[i]) + fr_len[i]; ptr < end; ptr++)
+               x[sv_ind[ptr]] -= sv_val[ptr] * x_i;
+         }
+      }
+      return nnz;
+}
+
+int luf_v_solve_s(LUF *luf, double b[/*1+n*/], int nnz,
+      int ind[/*1+n*/], double x[/*1+n*/], int iw[/*1+2*n*/],
+      char mark[/*1+n*/])
+{     int n = luf->n;
+      SVA *sva = luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      double *vr_piv = luf->vr_piv;
+      int vc_ref = luf->vc_ref;
+      int *vc_ptr = &sva->ptr[vc_ref-1];
+      int *vc_len = &sva->len[vc_ref-1];
+      int *pp_ind = luf->pp_ind;
+      int *pp_inv = luf->pp_inv;
+      int *qq_ind = luf->qq_ind;
+      int *list = iw, *stack = iw + n;
+      int i, j, k, t, cnt, ptr, end;
+      double x_j;
+      /* node i corresponds to j-th column of V, j = qq_ind[pp_ind[i]] */
+      cnt = reach(n, nnz, ind, pp_ind, qq_ind, vc_ptr, vc_len, sv_ind,
+         pp_ind, list, stack, mark);
+      nnz = 0;
+      for (t = cnt; t >= 1; t--)
+      {  /* k-th row of U = i-th row of V */
+         /* k-th column of U = j-th column of V */
+         k = list[t];
+         i = pp_inv[k];
+         j = qq_ind[k];
+         x_j = x[j] = b[i] / vr_piv[i];
+         b[i] = 0.0;
+         if (x_j != 0.0)
+         {  ind[++nnz] = j;
+            for (end = (ptr = vc_ptr[j]) + vc_len[j]; ptr < end; ptr++)
+               b[sv_ind[ptr]] -= sv_val[ptr] * x_j;
+         }
+      }
+      return nnz;
+}
+
+int luf_vt_solve_s(LUF *luf, double b[/*1+n*/], int nnz,
+      int ind[/*1+n*/], double x[/*1+n*/], int iw[/*1+2*n*/],
+      char mark[/*1+n*/])
+{     int n = luf->n;
+      SVA *sva = luf->sva;
+      int *sv_ind = sva->ind;
+      double *sv_val = sva->val;
+      double *vr_piv = luf->vr_piv;
+      int vr_ref = luf->vr_ref;
+      int *vr_ptr = &sva->ptr[vr_ref-1];
+      int *vr_len = &sva->len[vr_ref-1];
+      int *pp_inv = luf->pp_inv;
+      int *qq_ind = luf->qq_ind;
+      int *qq_inv = luf->qq_inv;
+      int *list = iw, *stack = iw + n;
+      int i, j, k, t, cnt, ptr, end;
+      double x_i;
+      /* node j corresponds to i-th row of V, i = pp_inv[qq_inv[j]] */
+      cnt = reach(n, nnz, ind, qq_inv, pp_inv, vr_ptr, vr_len, sv_ind,
+         qq_inv, list, stack, mark);
+      nnz = 0;
+      for (t = 1; t <= cnt; t++)
+      {  /* k-th row of U' = j-th column of V */
+         /* k-th column of U' = i-th row of V */
+         k = list[t];
+         i = pp_inv[k];
+         j = qq_ind[k];
+         x_i = x[i] = b[j] / vr_piv[i];
+         b[j] = 0.0;
+         if (x_i != 0.0)
+         {  ind[++nnz] = i;
+            for (end = (ptr = vr_ptr[i]) + vr_len[i]; ptr < end; ptr++)
+               b[sv_ind[ptr]] -= sv_val[ptr] * x_i;
+         }
+      }
+      return nnz;
+}
+
 /***********************************************************************
 *  luf_estimate_norm - estimate 1-norm of inv(A)
 *
@@ -217,6 +217,28 @@ void luf_vt_solve(LUF *luf, double b[/*1+n*/], double x[/*1+n*/]);
 void luf_vt_solve1(LUF *luf, double e[/*1+n*/], double y[/*1+n*/]);
 /* solve system V' * y = e' to cause growth in y */
 
+#define luf_f_solve_s _glp_luf_f_solve_s
+int luf_f_solve_s(LUF *luf, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], int iw[/*1+2*n*/], char mark[/*1+n*/]);
+/* solve system F * x = b with sparse right-hand side */
+
+#define luf_ft_solve_s _glp_luf_ft_solve_s
+int luf_ft_solve_s(LUF *luf, double x[/*1+n*/], int nnz,
+      int ind[/*1+n*/], int iw[/*1+2*n*/], char mark[/*1+n*/]);
+/* solve system F' * x = b with sparse right-hand side */
+
+#define luf_v_solve_s _glp_luf_v_solve_s
+int luf_v_solve_s(LUF *luf, double b[/*1+n*/], int nnz,
+      int ind[/*1+n*/], double x[/*1+n*/], int iw[/*1+2*n*/],
+      char mark[/*1+n*/]);
+/* solve system V * x = b with sparse right-hand side */
+
+#define luf_vt_solve_s _glp_luf_vt_solve_s
+int luf_vt_solve_s(LUF *luf, double b[/*1+n*/], int nnz,
+      int ind[/*1+n*/], double x[/*1+n*/], int iw[/*1+2*n*/],
+      char mark[/*1+n*/]);
+/* solve system V' * x = b with sparse right-hand side */
+
 #define luf_estimate_norm _glp_luf_estimate_norm
 double luf_estimate_norm(LUF *luf, double w1[/*1+n*/], double
       w2[/*1+n*/]);
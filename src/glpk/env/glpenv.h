@@ -34,6 +34,17 @@ typedef struct MBD MBD;
 #define SIZE_T_MAX (~(size_t)0)
 /* largest value of size_t type */
 
+#ifndef TLS
+#if defined(_MSC_VER)
+#define TLS __declspec(thread)
+#else
+#define TLS __thread
+#endif
+#endif
+/* storage class specifier for variables which must be placed in the
+ * Thread Local Storage, so every thread running GLPK routines gets
+ * its own copy */
+
 
 #ifdef HAVE_ENV
 #define TBUF_SIZE 4096
@@ -21,8 +21,14 @@
 *  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
 ***********************************************************************/
 
+#include "glpk.h"
 #include "glpenv.h"
 #include "zlib.h"
+#if defined(HAVE_PTHREAD)
+#include <pthread.h>
+#elif defined(__WOE__)
+#include <windows.h>
+#endif
 
 struct glp_file
 {     /* sequential stream descriptor */
@@ -42,10 +48,477 @@ struct glp_file
 #define IOWRT  0x08 /* output stream */
 #define IOEOF  0x10 /* end of file */
 #define IOERR  0x20 /* input/output error */
+#define IOBUF  0x40 /* in-memory buffer */
       void *file;
       /* pointer to underlying control object */
 };
 
+#define BUF_MAGIC 0x42554646
+
+struct glp_buffer
+{     /* in-memory file */
+      unsigned magic;
+      /* magic value used for debugging */
+      char *data;
+      /* pointer to content */
+      size_t size;
+      /* size of content, in bytes */
+      size_t cap;
+      /* allocated size of data; 0 means data is provided by the
+         application and can only be read */
+      size_t pos;
+      /* current read position */
+      int gzip;
+      /* compress content written to the buffer */
+      int (*func)(void *info, void *buf, int size);
+      void *info;
+      /* producer of the content; NULL means all content is in data */
+      int used, done;
+      /* the producer was already read / reached the end of content */
+      int zopen;
+      /* zs is in use (compressed stream is open) */
+      z_stream zs;
+      /* compression state */
+      unsigned id;
+      /* handle of the buffer in the table of live buffers */
+      char name[40];
+      /* name to be passed to glp_open */
+};
+
+/* table of live buffers; glp_open finds a buffer by the handle given
+   in its name, so names of deleted or never created buffers are just
+   rejected, and buffers may be created, opened and deleted by
+   different threads */
+
+#if defined(HAVE_PTHREAD)
+static pthread_mutex_t buf_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define buf_lock() pthread_mutex_lock(&buf_mutex)
+#define buf_unlock() pthread_mutex_unlock(&buf_mutex)
+#elif defined(__WOE__)
+static SRWLOCK buf_mutex = SRWLOCK_INIT;
+#define buf_lock() AcquireSRWLockExclusive(&buf_mutex)
+#define buf_unlock() ReleaseSRWLockExclusive(&buf_mutex)
+#else
+#define buf_lock() ((void)0)
+#define buf_unlock() ((void)0)
+#endif
+
+static glp_buffer **buf_tab = NULL;
+/* buf_tab[0], ..., buf_tab[buf_len-1] are live buffers */
+static int buf_len = 0, buf_max = 0;
+/* number of live buffers and size of the table */
+static unsigned buf_last = 0;
+/* last handle assigned; handles are not reused */
+
+static int buf_register(glp_buffer *buf)
+{     /* add buffer to the table and assign a handle to it; returns
+         non-zero if the table cannot be enlarged */
+      int ret = 0;
+      buf_lock();
+      if (buf_len == buf_max)
+      {  int max = (buf_max == 0 ? 16 : buf_max + buf_max);
+         glp_buffer **tab;
+         tab = realloc(buf_tab, max * sizeof(glp_buffer *));
+         if (tab == NULL)
+            ret = 1;
+         else
+            buf_tab = tab, buf_max = max;
+      }
+      if (ret == 0)
+      {  buf_tab[buf_len++] = buf;
+         buf->id = ++buf_last;
+      }
+      buf_unlock();
+      return ret;
+}
+
+static void buf_unregister(glp_buffer *buf)
+{     /* remove buffer from the table */
+      int k;
+      buf_lock();
+      for (k = 0; k < buf_len; k++)
+      {  if (buf_tab[k] == buf)
+         {  buf_tab[k] = buf_tab[--buf_len];
+            break;
+         }
+      }
+      buf_unlock();
+      return;
+}
+
+static glp_buffer *buf_find(const char *name)
+{     /* find live buffer by its name; returns NULL if there is no such
+         buffer */
+      glp_buffer *buf = NULL;
+      unsigned id;
+      char c;
+      int k;
+      if (!('0' <= name[12] && name[12] <= '9') ||
+          sscanf(name + 12, "%u%c", &id, &c) != 1)
+         return NULL;
+      buf_lock();
+      for (k = 0; k < buf_len; k++)
+      {  if (buf_tab[k]->id == id)
+         {  buf = buf_tab[k];
+            break;
+         }
+      }
+      buf_unlock();
+      return buf;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_create_buffer - create in-memory file
+*
+*  SYNOPSIS
+*
+*  glp_buffer *glp_create_buffer(const void *data, size_t size,
+*     int gzip);
+*
+*  DESCRIPTION
+*
+*  The routine glp_create_buffer creates an in-memory file, which can
+*  be used by any routine reading or writing a file through the name
+*  returned by glp_buffer_name. The name contains a handle of the
+*  buffer, which is valid until the buffer is deleted.
+*
+*  If data is not NULL, the buffer refers to size bytes of content at
+*  data, which are not copied and must stay valid until the buffer is
+*  deleted; such a buffer can only be read. Gzipped content is detected
+*  and decompressed on the fly.
+*
+*  If data is NULL, the buffer is initially empty and can be written;
+*  if gzip is GLP_ON, the content written is gzip compressed.
+*
+*  RETURNS
+*
+*  The routine returns a pointer to the buffer created. */
+
+glp_buffer *glp_create_buffer(const void *data, size_t size, int gzip)
+{     glp_buffer *buf;
+      if (!(gzip == GLP_ON || gzip == GLP_OFF))
+         xerror("glp_create_buffer: gzip = %d; invalid parameter\n",
+            gzip);
+      if (data == NULL && size != 0)
+         xerror("glp_create_buffer: size = %lu; invalid parameter\n",
+            (unsigned long)size);
+      buf = talloc(1, glp_buffer);
+      memset(buf, 0, sizeof(glp_buffer));
+      buf->magic = BUF_MAGIC;
+      buf->data = (char *)data;
+      buf->size = size;
+      buf->gzip = gzip;
+      if (buf_register(buf) != 0)
+         xerror("glp_create_buffer: out of memory\n");
+      sprintf(buf->name, "/dev/buffer/%u", buf->id);
+      return buf;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_create_stream - create producer-fed in-memory file
+*
+*  SYNOPSIS
+*
+*  glp_buffer *glp_create_stream(int (*func)(void *info, void *buf,
+*     int size), void *info);
+*
+*  DESCRIPTION
+*
+*  The routine glp_create_stream creates an in-memory file whose
+*  content is obtained while it is being read. Every time more data are
+*  needed the routine func is called with the transit pointer info; it
+*  should store up to size bytes to buf, waiting for them if necessary,
+*  and return the number of bytes stored, 0 at the end of content, or a
+*  negative value on error. Gzipped content is detected and decompressed
+*  on the fly. Such a file can be read only once.
+*
+*  RETURNS
+*
+*  The routine returns a pointer to the buffer created. */
+
+glp_buffer *glp_create_stream(int (*func)(void *info, void *buf,
+      int size), void *info)
+{     glp_buffer *buf;
+      if (func == NULL)
+         xerror("glp_create_stream: func = %p; invalid parameter\n",
+            func);
+      buf = glp_create_buffer(NULL, 0, GLP_OFF);
+      buf->func = func;
+      buf->info = info;
+      return buf;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_buffer_name - file name of in-memory file
+*
+*  SYNOPSIS
+*
+*  const char *glp_buffer_name(glp_buffer *buf);
+*
+*  RETURNS
+*
+*  The routine returns the name, which refers to the buffer when passed
+*  to routines reading or writing files. */
+
+const char *glp_buffer_name(glp_buffer *buf)
+{     xassert(buf->magic == BUF_MAGIC);
+      return buf->name;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_buffer_data - content of in-memory file
+*
+*  SYNOPSIS
+*
+*  const void *glp_buffer_data(glp_buffer *buf, size_t *size);
+*
+*  RETURNS
+*
+*  The routine stores the size of content to the location size and
+*  returns a pointer to the content, which stays valid until the buffer
+*  is written again or deleted. */
+
+const void *glp_buffer_data(glp_buffer *buf, size_t *size)
+{     xassert(buf->magic == BUF_MAGIC);
+      *size = buf->size;
+      return buf->data;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_delete_buffer - delete in-memory file
+*
+*  SYNOPSIS
+*
+*  void glp_delete_buffer(glp_buffer *buf);
+*
+*  DESCRIPTION
+*
+*  The routine glp_delete_buffer frees all memory used by the buffer,
+*  which must not be open by any stream. */
+
+void glp_delete_buffer(glp_buffer *buf)
+{     xassert(buf->magic == BUF_MAGIC);
+      xassert(!buf->zopen);
+      buf_unregister(buf);
+      if (buf->cap > 0)
+         free(buf->data);
+      buf->magic = 0;
+      tfree(buf);
+      return;
+}
+
+#define BUF_CHUNK 65536
+
+static int buf_fill(glp_buffer *buf, size_t keep)
+{     /* fetch next content from the producer keeping first keep bytes
+         of current content; returns number of bytes fetched, 0 at the
+         end of content or EOF on error */
+      int cnt;
+      if (buf->func == NULL || buf->done)
+         return 0;
+      if (buf->cap == 0)
+      {  buf->data = malloc(BUF_CHUNK);
+         if (buf->data == NULL)
+         {  put_err_msg("out of memory");
+            return EOF;
+         }
+         buf->cap = BUF_CHUNK;
+      }
+      cnt = buf->func(buf->info, buf->data + keep,
+         (int)(buf->cap - keep));
+      if (cnt < 0)
+      {  put_err_msg("input stream error");
+         return EOF;
+      }
+      if (cnt == 0)
+         buf->done = 1;
+      buf->size = keep + cnt;
+      return cnt;
+}
+
+static glp_buffer *buf_open(const char *name, int flag)
+{     /* attach buffer to stream */
+      glp_buffer *buf;
+      buf = buf_find(name);
+      if (buf == NULL)
+      {  put_err_msg("invalid buffer name");
+         return NULL;
+      }
+      xassert(buf->magic == BUF_MAGIC);
+      if (buf->zopen)
+      {  put_err_msg("buffer already in use");
+         return NULL;
+      }
+      if (flag & IOWRT)
+      {  if (buf->func != NULL || (buf->data != NULL && buf->cap == 0))
+         {  put_err_msg("buffer is read-only");
+            return NULL;
+         }
+         buf->size = 0;
+         if (buf->gzip)
+         {  memset(&buf->zs, 0, sizeof(z_stream));
+            if (deflateInit2(&buf->zs, Z_DEFAULT_COMPRESSION,
+               Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {  put_err_msg("deflateInit2 failed");
+               return NULL;
+            }
+            buf->zopen = 1;
+         }
+      }
+      else
+      {  if (buf->func != NULL)
+         {  /* fetch enough content to detect compression */
+            if (buf->used)
+            {  put_err_msg("stream can be read only once");
+               return NULL;
+            }
+            buf->used = 1;
+            buf->size = 0;
+            while (buf->size < 2 && !buf->done)
+            {  if (buf_fill(buf, buf->size) < 0)
+                  return NULL;
+            }
+         }
+         buf->pos = 0;
+         if (buf->size >= 2 && (unsigned char)buf->data[0] == 0x1F &&
+             (unsigned char)buf->data[1] == 0x8B)
+         {  memset(&buf->zs, 0, sizeof(z_stream));
+            if (inflateInit2(&buf->zs, 15 + 16) != Z_OK)
+            {  put_err_msg("inflateInit2 failed");
+               return NULL;
+            }
+            buf->zopen = 1;
+         }
+      }
+      return buf;
+}
+
+static int buf_read(glp_buffer *buf, char *ptr, int size)
+{     /* read up to size bytes; returns number of bytes read, 0 at the
+         end of content or EOF on error */
+      int cnt, ret;
+      if (!buf->zopen)
+      {  if (buf->pos == buf->size)
+         {  cnt = buf_fill(buf, 0);
+            buf->pos = 0;
+            if (cnt <= 0)
+               return cnt;
+         }
+         cnt = (buf->size - buf->pos < (size_t)size ?
+            (int)(buf->size - buf->pos) : size);
+         memcpy(ptr, buf->data + buf->pos, cnt);
+         buf->pos += cnt;
+         return cnt;
+      }
+      buf->zs.next_out = (Bytef *)ptr;
+      buf->zs.avail_out = size;
+      while (buf->zs.avail_out == (uInt)size)
+      {  size_t avail;
+         if (buf->pos == buf->size && buf->func != NULL)
+         {  if (buf_fill(buf, 0) < 0)
+               return EOF;
+            buf->pos = 0;
+         }
+         avail = buf->size - buf->pos;
+         buf->zs.next_in = (Bytef *)(buf->data + buf->pos);
+         buf->zs.avail_in = (avail > UINT_MAX ? UINT_MAX : (uInt)avail);
+         ret = inflate(&buf->zs, Z_NO_FLUSH);
+         buf->pos = (char *)buf->zs.next_in - buf->data;
+         if (ret == Z_STREAM_END)
+            break;
+         if (ret == Z_BUF_ERROR)
+         {  put_err_msg("unexpected end of compressed data");
+            return EOF;
+         }
+         if (ret != Z_OK)
+         {  put_err_msg(buf->zs.msg != NULL ? buf->zs.msg :
+               "invalid compressed data");
+            return EOF;
+         }
+      }
+      return size - (int)buf->zs.avail_out;
+}
+
+static int buf_grow(glp_buffer *buf, size_t need)
+{     /* make room for need more bytes */
+      size_t cap;
+      char *data;
+      if (buf->cap - buf->size >= need)
+         return 0;
+      cap = (buf->cap > 0 ? buf->cap : BUFSIZ);
+      while (cap - buf->size < need)
+         cap += cap;
+      data = realloc(buf->data, cap);
+      if (data == NULL)
+      {  put_err_msg("out of memory");
+         return EOF;
+      }
+      buf->data = data;
+      buf->cap = cap;
+      return 0;
+}
+
+static int buf_write(glp_buffer *buf, const char *ptr, int cnt,
+      int flush)
+{     /* append cnt bytes; flush is Z_FINISH on closing the stream */
+      int ret;
+      if (!buf->zopen)
+      {  if (buf_grow(buf, cnt) != 0)
+            return EOF;
+         memcpy(buf->data + buf->size, ptr, cnt);
+         buf->size += cnt;
+         return 0;
+      }
+      buf->zs.next_in = (Bytef *)ptr;
+      buf->zs.avail_in = cnt;
+      for (;;)
+      {  if (buf_grow(buf, BUFSIZ) != 0)
+            return EOF;
+         buf->zs.next_out = (Bytef *)(buf->data + buf->size);
+         buf->zs.avail_out = (uInt)(buf->cap - buf->size > UINT_MAX ?
+            UINT_MAX : buf->cap - buf->size);
+         ret = deflate(&buf->zs, flush);
+         buf->size = (char *)buf->zs.next_out - buf->data;
+         if (ret == Z_STREAM_END)
+            break;
+         if (!(ret == Z_OK || ret == Z_BUF_ERROR))
+         {  put_err_msg(buf->zs.msg != NULL ? buf->zs.msg :
+               "compression failed");
+            return EOF;
+         }
+         if (flush != Z_FINISH && buf->zs.avail_in == 0 &&
+             buf->zs.avail_out > 0)
+            break;
+      }
+      return 0;
+}
+
+static int buf_close(glp_buffer *buf, int flag)
+{     /* detach buffer from stream */
+      int ret = 0;
+      if (buf->zopen)
+      {  if (flag & IOWRT)
+         {  if (!(flag & IOERR) && buf_write(buf, "", 0, Z_FINISH) != 0)
+               ret = EOF;
+            deflateEnd(&buf->zs);
+         }
+         else
+            inflateEnd(&buf->zs);
+         buf->zopen = 0;
+      }
+      return ret;
+}
+
 /***********************************************************************
 *  NAME
 *
@@ -66,7 +539,8 @@ struct glp_file
 *  "/dev/null"    empty (null) file;
 *  "/dev/stdin"   standard input stream;
 *  "/dev/stdout"  standard output stream;
-*  "/dev/stderr"  standard error stream.
+*  "/dev/stderr"  standard error stream;
+*  "/dev/buffer/..." in-memory file (see glp_create_buffer).
 *
 *  If the specified filename is ended with ".gz", it is assumed that
 *  the file is in gzipped format. In this case the file is compressed
@@ -117,6 +591,12 @@ glp_file *glp_open(const char *name, const char *mode)
       {  flag |= IOSTD;
          file = stderr;
       }
+      else if (strncmp(name, "/dev/buffer/", 12) == 0)
+      {  flag |= IOBUF;
+         file = buf_open(name, flag);
+         if (file == NULL)
+            return NULL;
+      }
       else
       {  char *ext = strrchr(name, '.');
          if (ext == NULL || strcmp(ext, ".gz") != 0)
@@ -234,6 +714,14 @@ int glp_read(glp_file *f, void *buf, int nnn)
          {  /* buffer is empty; fill it */
             if (f->flag & IONULL)
                cnt = 0;
+            else if (f->flag & IOBUF)
+            {  cnt = buf_read((glp_buffer *)(f->file), f->base,
+                  f->size);
+               if (cnt < 0)
+               {  f->flag |= IOERR;
+                  return EOF;
+               }
+            }
             else if (!(f->flag & IOGZIP))
             {  cnt = fread(f->base, 1, f->size, (FILE *)(f->file));
                if (ferror((FILE *)(f->file)))
@@ -318,6 +806,13 @@ static int do_flush(glp_file *f)
       if (f->cnt > 0)
       {  if (f->flag & IONULL)
             ;
+         else if (f->flag & IOBUF)
+         {  if (buf_write((glp_buffer *)(f->file), f->base, f->cnt,
+               Z_NO_FLUSH) != 0)
+            {  f->flag |= IOERR;
+               return EOF;
+            }
+         }
          else if (!(f->flag & IOGZIP))
          {  if ((int)fwrite(f->base, 1, f->cnt, (FILE *)(f->file))
                != f->cnt)
@@ -460,6 +955,11 @@ int glp_close(glp_file *f)
       }
       if (f->flag & (IONULL | IOSTD))
          ;
+      else if (f->flag & IOBUF)
+      {  if (buf_close((glp_buffer *)(f->file), f->flag) != 0 &&
+             ret == 0)
+            ret = EOF;
+      }
       else if (!(f->flag & IOGZIP))
       {  if (fclose((FILE *)(f->file)) != 0)
          {  if (ret == 0)
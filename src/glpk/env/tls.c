@@ -23,9 +23,10 @@
 
 #include "glpenv.h"
 
-static void *tls = NULL;
-/* NOTE: in a re-entrant version of the package this variable should be
- * placed in the Thread Local Storage (TLS) */
+static TLS void *tls = NULL;
+/* the variable is placed in the Thread Local Storage (TLS), so every
+ * thread gets its own environment block and problems may be solved
+ * concurrently on different threads */
 
 /***********************************************************************
 *  NAME
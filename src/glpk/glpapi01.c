@@ -82,7 +82,13 @@ static void create_prob(glp_prob *lp)
       lp->nnz = 0;
       lp->row = xcalloc(1+lp->m_max, sizeof(GLPROW *));
       lp->col = xcalloc(1+lp->n_max, sizeof(GLPCOL *));
-      lp->r_tree = lp->c_tree = NULL;
+      lp->r_index = lp->c_index = NULL;
+      lp->keep_index = 0;
+      lp->compact = 0;
+      lp->csc = lp->csr = NULL;
+      lp->csc_req = lp->csr_req = 0;
+      lp->nolist = 0;
+      lp->wlp = NULL;
       /* basis factorization */
       lp->valid = 0;
       lp->head = xcalloc(1+lp->m_max, sizeof(int));
@@ -248,6 +254,7 @@ int glp_add_rows(glp_prob *lp, int nrs)
 {     glp_tree *tree = lp->tree;
       GLPROW *row;
       int m_new, i;
+      prob_lists(lp);
       /* determine new number of rows */
       if (nrs < 1)
          xerror("glp_add_rows: nrs = %d; invalid number of rows\n",
@@ -275,7 +282,6 @@ int glp_add_rows(glp_prob *lp, int nrs)
          lp->row[i] = row = dmp_get_atom(lp->pool, sizeof(GLPROW));
          row->i = i;
          row->name = NULL;
-         row->node = NULL;
 #if 1 /* 20/IX-2008 */
          row->level = 0;
          row->origin = 0;
@@ -320,6 +326,8 @@ int glp_add_rows(glp_prob *lp, int nrs)
 #if 1
       if (tree != NULL && tree->reason != 0) tree->reopt = 1;
 #endif
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       /* return the ordinal number of the first row added */
       return m_new - nrs + 1;
 }
@@ -354,6 +362,7 @@ int glp_add_cols(glp_prob *lp, int ncs)
       int n_new, j;
       if (tree != NULL && tree->reason != 0)
          xerror("glp_add_cols: operation not allowed\n");
+      prob_lists(lp);
       /* determine new number of columns */
       if (ncs < 1)
          xerror("glp_add_cols: ncs = %d; invalid number of columns\n",
@@ -378,7 +387,6 @@ int glp_add_cols(glp_prob *lp, int ncs)
          lp->col[j] = col = dmp_get_atom(lp->pool, sizeof(GLPCOL));
          col->j = j;
          col->name = NULL;
-         col->node = NULL;
          col->kind = GLP_CV;
          col->type = GLP_FX;
          col->lb = col->ub = 0.0;
@@ -397,6 +405,8 @@ int glp_add_cols(glp_prob *lp, int ncs)
       }
       /* set new number of columns */
       lp->n = n_new;
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       /* return the ordinal number of the first column added */
       return n_new - ncs + 1;
 }
@@ -431,11 +441,8 @@ void glp_set_row_name(glp_prob *lp, int i, const char *name)
          xassert(row->level == tree->curr->level);
       }
       if (row->name != NULL)
-      {  if (row->node != NULL)
-         {  xassert(lp->r_tree != NULL);
-            avl_delete_node(lp->r_tree, row->node);
-            row->node = NULL;
-         }
+      {  if (lp->r_index != NULL)
+            strhash_delete(lp->r_index, row->name, row);
          dmp_free_atom(lp->pool, row->name, strlen(row->name)+1);
          row->name = NULL;
       }
@@ -451,11 +458,8 @@ void glp_set_row_name(glp_prob *lp, int i, const char *name)
          }
          row->name = dmp_get_atom(lp->pool, strlen(name)+1);
          strcpy(row->name, name);
-         if (lp->r_tree != NULL)
-         {  xassert(row->node == NULL);
-            row->node = avl_insert_node(lp->r_tree, row->name);
-            avl_set_node_link(row->node, row);
-         }
+         if (lp->r_index != NULL)
+            strhash_insert(lp->r_index, row->name, row);
       }
       return;
 }
@@ -488,11 +492,8 @@ void glp_set_col_name(glp_prob *lp, int j, const char *name)
             , j);
       col = lp->col[j];
       if (col->name != NULL)
-      {  if (col->node != NULL)
-         {  xassert(lp->c_tree != NULL);
-            avl_delete_node(lp->c_tree, col->node);
-            col->node = NULL;
-         }
+      {  if (lp->c_index != NULL)
+            strhash_delete(lp->c_index, col->name, col);
          dmp_free_atom(lp->pool, col->name, strlen(col->name)+1);
          col->name = NULL;
       }
@@ -508,11 +509,8 @@ void glp_set_col_name(glp_prob *lp, int j, const char *name)
          }
          col->name = dmp_get_atom(lp->pool, strlen(name)+1);
          strcpy(col->name, name);
-         if (lp->c_tree != NULL && col->name != NULL)
-         {  xassert(col->node == NULL);
-            col->node = avl_insert_node(lp->c_tree, col->name);
-            avl_set_node_link(col->node, col);
-         }
+         if (lp->c_index != NULL)
+            strhash_insert(lp->c_index, col->name, col);
       }
       return;
 }
@@ -723,6 +721,7 @@ void glp_set_mat_row(glp_prob *lp, int i, int len, const int ind[],
       GLPCOL *col;
       GLPAIJ *aij, *next;
       int j, k;
+      prob_lists(lp);
       /* obtain pointer to i-th row */
       if (!(1 <= i && i <= lp->m))
          xerror("glp_set_mat_row: i = %d; row number out of range\n",
@@ -814,6 +813,8 @@ void glp_set_mat_row(glp_prob *lp, int i, int len, const int ind[],
             dmp_free_atom(lp->pool, aij, sizeof(GLPAIJ)), lp->nnz--;
          }
       }
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       return;
 }
 
@@ -856,6 +857,7 @@ void glp_set_mat_col(glp_prob *lp, int j, int len, const int ind[],
          xerror("glp_set_mat_col: j = %d; column number out of range\n",
             j);
       col = lp->col[j];
+      prob_lists(lp);
       /* remove all existing elements from j-th column */
       while (col->ptr != NULL)
       {  /* take next element in the column */
@@ -934,6 +936,8 @@ void glp_set_mat_col(glp_prob *lp, int j, int len, const int ind[],
       }
       /* if j-th column is basic, invalidate the basis factorization */
       if (col->stat == GLP_BS) lp->valid = 0;
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       return;
 }
 
@@ -974,6 +978,7 @@ void glp_load_matrix(glp_prob *lp, int ne, const int ia[],
       int i, j, k;
       if (tree != NULL && tree->reason != 0)
          xerror("glp_load_matrix: operation not allowed\n");
+      prob_lists(lp);
       /* clear the constraint matrix */
       for (i = 1; i <= lp->m; i++)
       {  row = lp->row[i];
@@ -1070,6 +1075,8 @@ void glp_load_matrix(glp_prob *lp, int ne, const int ia[],
       }
       /* invalidate the basis factorization */
       lp->valid = 0;
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       return;
 }
 
@@ -1206,6 +1213,7 @@ void glp_sort_matrix(glp_prob *P)
       if (P == NULL || P->magic != GLP_PROB_MAGIC)
          xerror("glp_sort_matrix: P = %p; invalid problem object\n",
             P);
+      prob_lists(P);
       /* rebuild row linked lists */
       for (i = P->m; i >= 1; i--)
          P->row[i]->ptr = NULL;
@@ -1230,6 +1238,8 @@ void glp_sort_matrix(glp_prob *P)
             P->col[j]->ptr = aij;
          }
       }
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(P);
       return;
 }
 
@@ -1257,6 +1267,7 @@ void glp_del_rows(glp_prob *lp, int nrs, const int num[])
 {     glp_tree *tree = lp->tree;
       GLPROW *row;
       int i, k, m_new;
+      prob_lists(lp);
       /* mark rows to be deleted */
       if (!(1 <= nrs && nrs <= lp->m))
          xerror("glp_del_rows: nrs = %d; invalid number of rows\n",
@@ -1288,7 +1299,7 @@ void glp_del_rows(glp_prob *lp, int nrs, const int num[])
                "ot allowed\n", k, i);
          /* erase symbolic name assigned to the row */
          glp_set_row_name(lp, i, NULL);
-         xassert(row->node == NULL);
+         xassert(row->name == NULL);
          /* erase corresponding row of the constraint matrix */
          glp_set_mat_row(lp, i, 0, NULL, NULL);
          xassert(row->ptr == NULL);
@@ -1315,6 +1326,8 @@ void glp_del_rows(glp_prob *lp, int nrs, const int num[])
       lp->m = m_new;
       /* invalidate the basis factorization */
       lp->valid = 0;
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       return;
 }
 
@@ -1344,6 +1357,7 @@ void glp_del_cols(glp_prob *lp, int ncs, const int num[])
       int j, k, n_new;
       if (tree != NULL && tree->reason != 0)
          xerror("glp_del_cols: operation not allowed\n");
+      prob_lists(lp);
       /* mark columns to be deleted */
       if (!(1 <= ncs && ncs <= lp->n))
          xerror("glp_del_cols: ncs = %d; invalid number of columns\n",
@@ -1362,7 +1376,7 @@ void glp_del_cols(glp_prob *lp, int ncs, const int num[])
                "s not allowed\n", k, j);
          /* erase symbolic name assigned to the column */
          glp_set_col_name(lp, j, NULL);
-         xassert(col->node == NULL);
+         xassert(col->name == NULL);
          /* erase corresponding column of the constraint matrix */
          glp_set_mat_col(lp, j, 0, NULL, NULL);
          xassert(col->ptr == NULL);
@@ -1401,6 +1415,8 @@ void glp_del_cols(glp_prob *lp, int ncs, const int num[])
             }
          }
       }
+      /* compact copies of the matrix are out of date */
+      prob_mat_changed(lp);
       return;
 }
 
@@ -1420,13 +1436,20 @@ void glp_del_cols(glp_prob *lp, int ncs, const int num[])
 *
 *  The parameter names is a flag. If it is non-zero, the routine also
 *  copies all symbolic names; otherwise, if it is zero, symbolic names
-*  are not copied. */
+*  are not copied.
+*
+*  The constraint matrix is shared rather than copied: both objects use
+*  the same compact copies of it (see glp_compact_matrix), which are
+*  built for the object prob, if necessary, and the object dest builds
+*  its own linked lists of coefficients only when some routine needs
+*  them, e.g. when its matrix is changed. Thus, copies of a problem
+*  which are only re-solved with different bounds or objective
+*  coefficients do not duplicate its constraint matrix. */
 
 void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
 {     glp_tree *tree = dest->tree;
       glp_bfcp bfcp;
-      int i, j, len, *ind;
-      double *val;
+      int i, j;
       if (tree != NULL && tree->reason != 0)
          xerror("glp_copy_prob: operation not allowed\n");
       if (dest == prob)
@@ -1472,8 +1495,6 @@ void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
          to->dval = from->dval;
          to->mipx = from->mipx;
       }
-      ind = xcalloc(1+prob->m, sizeof(int));
-      val = xcalloc(1+prob->m, sizeof(double));
       for (j = 1; j <= prob->n; j++)
       {  GLPCOL *to = dest->col[j];
          GLPCOL *from = prob->col[j];
@@ -1484,8 +1505,6 @@ void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
          to->lb = from->lb;
          to->ub = from->ub;
          to->coef = from->coef;
-         len = glp_get_mat_col(prob, j, ind, val);
-         glp_set_mat_col(dest, j, len, ind, val);
          to->sjj = from->sjj;
          to->stat = from->stat;
          to->prim = from->prim;
@@ -1494,8 +1513,9 @@ void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
          to->dval = from->dval;
          to->mipx = from->mipx;
       }
-      xfree(ind);
-      xfree(val);
+      /* the constraint matrix is not copied; both objects use the same
+         compact copies until either of them changes its matrix */
+      prob_share_mat(dest, prob);
       return;
 }
 
@@ -1514,16 +1534,24 @@ void glp_copy_prob(glp_prob *dest, glp_prob *prob, int names)
 *  problem object. The effect of this operation is the same as if the
 *  problem object would be deleted with the routine glp_delete_prob and
 *  then created anew with the routine glp_create_prob, with exception
-*  that the handle (pointer) to the problem object remains valid. */
+*  that the handle (pointer) to the problem object remains valid, the
+*  name index made permanent with the routine glp_keep_index is kept
+*  (being empty) and the compact matrix storage mode set with the
+*  routine glp_compact_matrix is kept. */
 
 static void delete_prob(glp_prob *lp);
 
 void glp_erase_prob(glp_prob *lp)
 {     glp_tree *tree = lp->tree;
+      int keep = lp->keep_index, compact = lp->compact;
       if (tree != NULL && tree->reason != 0)
          xerror("glp_erase_prob: operation not allowed\n");
       delete_prob(lp);
       create_prob(lp);
+      lp->compact = compact;
+      /* the permanent name index is recreated empty */
+      if (keep)
+         glp_keep_index(lp, GLP_ON);
       return;
 }
 
@@ -1557,8 +1585,11 @@ static void delete_prob(glp_prob *lp)
 #endif
       xfree(lp->row);
       xfree(lp->col);
-      if (lp->r_tree != NULL) avl_delete_tree(lp->r_tree);
-      if (lp->c_tree != NULL) avl_delete_tree(lp->c_tree);
+      if (lp->r_index != NULL) strhash_delete_table(lp->r_index);
+      if (lp->c_index != NULL) strhash_delete_table(lp->c_index);
+      /* the elements were freed with the memory pool */
+      lp->nolist = 0;
+      prob_mat_changed(lp);
       xfree(lp->head);
 #if 0 /* 08/III-2014 */
       if (lp->bfcp != NULL) xfree(lp->bfcp);
@@ -433,11 +433,23 @@ int glp_get_num_nz(glp_prob *lp)
 *  of (non-zero) elements in i-th row. */
 
 int glp_get_mat_row(glp_prob *lp, int i, int ind[], double val[])
-{     GLPAIJ *aij;
-      int len;
+{     GLPCSM *csr;
+      GLPAIJ *aij;
+      int len, ptr;
       if (!(1 <= i && i <= lp->m))
          xerror("glp_get_mat_row: i = %d; row number out of range\n",
             i);
+      csr = prob_csr(lp, 0);
+      if (csr != NULL)
+      {  /* copy the row from the compact storage */
+         ptr = csr->ptr[i];
+         len = csr->ptr[i+1] - ptr;
+         if (ind != NULL)
+            memcpy(&ind[1], &csr->ind[ptr], len * sizeof(int));
+         if (val != NULL)
+            memcpy(&val[1], &csr->val[ptr], len * sizeof(double));
+         return len;
+      }
       len = 0;
       for (aij = lp->row[i]->ptr; aij != NULL; aij = aij->r_next)
       {  len++;
@@ -474,11 +486,23 @@ int glp_get_mat_row(glp_prob *lp, int i, int ind[], double val[])
 *  of (non-zero) elements in j-th column. */
 
 int glp_get_mat_col(glp_prob *lp, int j, int ind[], double val[])
-{     GLPAIJ *aij;
-      int len;
+{     GLPCSM *csc;
+      GLPAIJ *aij;
+      int len, ptr;
       if (!(1 <= j && j <= lp->n))
          xerror("glp_get_mat_col: j = %d; column number out of range\n",
             j);
+      csc = prob_csc(lp, 0);
+      if (csc != NULL)
+      {  /* copy the column from the compact storage */
+         ptr = csc->ptr[j];
+         len = csc->ptr[j+1] - ptr;
+         if (ind != NULL)
+            memcpy(&ind[1], &csc->ind[ptr], len * sizeof(int));
+         if (val != NULL)
+            memcpy(&val[1], &csc->val[ptr], len * sizeof(double));
+         return len;
+      }
       len = 0;
       for (aij = lp->col[j]->ptr; aij != NULL; aij = aij->c_next)
       {  len++;
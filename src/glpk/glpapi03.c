@@ -38,8 +38,8 @@
 *
 *  The routine glp_create_index creates the name index for the
 *  specified problem object. The name index is an auxiliary data
-*  structure, which is intended to quickly (i.e. for logarithmic time)
-*  find rows and columns by their names.
+*  structure (a hash table), which is intended to quickly (i.e. for
+*  constant time on average) find rows and columns by their names.
 *
 *  This routine can be called at any time. If the name index already
 *  exists, the routine does nothing. */
@@ -49,27 +49,21 @@ void glp_create_index(glp_prob *lp)
       GLPCOL *col;
       int i, j;
       /* create row name index */
-      if (lp->r_tree == NULL)
-      {  lp->r_tree = avl_create_tree(avl_strcmp, NULL);
+      if (lp->r_index == NULL)
+      {  lp->r_index = strhash_create_table(lp->m);
          for (i = 1; i <= lp->m; i++)
          {  row = lp->row[i];
-            xassert(row->node == NULL);
             if (row->name != NULL)
-            {  row->node = avl_insert_node(lp->r_tree, row->name);
-               avl_set_node_link(row->node, row);
-            }
+               strhash_insert(lp->r_index, row->name, row);
          }
       }
       /* create column name index */
-      if (lp->c_tree == NULL)
-      {  lp->c_tree = avl_create_tree(avl_strcmp, NULL);
+      if (lp->c_index == NULL)
+      {  lp->c_index = strhash_create_table(lp->n);
          for (j = 1; j <= lp->n; j++)
          {  col = lp->col[j];
-            xassert(col->node == NULL);
             if (col->name != NULL)
-            {  col->node = avl_insert_node(lp->c_tree, col->name);
-               avl_set_node_link(col->node, col);
-            }
+               strhash_insert(lp->c_index, col->name, col);
          }
       }
       return;
@@ -91,14 +85,14 @@ void glp_create_index(glp_prob *lp)
 *  symbolic name. If no such row exists, the routine returns 0. */
 
 int glp_find_row(glp_prob *lp, const char *name)
-{     AVLNODE *node;
+{     GLPROW *row;
       int i = 0;
-      if (lp->r_tree == NULL)
+      if (lp->r_index == NULL)
          xerror("glp_find_row: row name index does not exist\n");
       if (!(name == NULL || name[0] == '\0' || strlen(name) > 255))
-      {  node = avl_find_node(lp->r_tree, name);
-         if (node != NULL)
-            i = ((GLPROW *)avl_get_node_link(node))->i;
+      {  row = strhash_find(lp->r_index, name);
+         if (row != NULL)
+            i = row->i;
       }
       return i;
 }
@@ -119,14 +113,14 @@ int glp_find_row(glp_prob *lp, const char *name)
 *  symbolic name. If no such column exists, the routine returns 0. */
 
 int glp_find_col(glp_prob *lp, const char *name)
-{     AVLNODE *node;
+{     GLPCOL *col;
       int j = 0;
-      if (lp->c_tree == NULL)
+      if (lp->c_index == NULL)
          xerror("glp_find_col: column name index does not exist\n");
       if (!(name == NULL || name[0] == '\0' || strlen(name) > 255))
-      {  node = avl_find_node(lp->c_tree, name);
-         if (node != NULL)
-            j = ((GLPCOL *)avl_get_node_link(node))->j;
+      {  col = strhash_find(lp->c_index, name);
+         if (col != NULL)
+            j = col->j;
       }
       return j;
 }
@@ -147,20 +141,50 @@ int glp_find_col(glp_prob *lp, const char *name)
 *  allocated to this auxiliary data structure.
 *
 *  This routine can be called at any time. If the name index does not
-*  exist, the routine does nothing. */
+*  exist, the routine does nothing. The index is deleted even if it was
+*  made permanent with the routine glp_keep_index. */
 
 void glp_delete_index(glp_prob *lp)
-{     int i, j;
+{     lp->keep_index = 0;
       /* delete row name index */
-      if (lp->r_tree != NULL)
-      {  for (i = 1; i <= lp->m; i++) lp->row[i]->node = NULL;
-         avl_delete_tree(lp->r_tree), lp->r_tree = NULL;
-      }
+      if (lp->r_index != NULL)
+         strhash_delete_table(lp->r_index), lp->r_index = NULL;
       /* delete column name index */
-      if (lp->c_tree != NULL)
-      {  for (j = 1; j <= lp->n; j++) lp->col[j]->node = NULL;
-         avl_delete_tree(lp->c_tree), lp->c_tree = NULL;
-      }
+      if (lp->c_index != NULL)
+         strhash_delete_table(lp->c_index), lp->c_index = NULL;
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_keep_index - make the name index permanent
+*
+*  SYNOPSIS
+*
+*  void glp_keep_index(glp_prob *lp, int keep);
+*
+*  DESCRIPTION
+*
+*  If the parameter keep is GLP_ON, the routine glp_keep_index creates
+*  the name index (if it does not exist yet) and makes it permanent.
+*  The permanent index survives the routine glp_erase_prob, so the
+*  problem readers, which erase the problem object and use the name
+*  index while reading, leave it in place instead of deleting it, and
+*  rows and columns may be found by their names right after reading
+*  without building the index again.
+*
+*  If the parameter keep is GLP_OFF, the routine only clears the flag;
+*  the index exists until the routine glp_delete_index is called or
+*  the problem object is erased. */
+
+void glp_keep_index(glp_prob *lp, int keep)
+{     if (!(keep == GLP_ON || keep == GLP_OFF))
+         xerror("glp_keep_index: keep = %d; invalid parameter\n",
+            keep);
+      if (keep)
+         glp_create_index(lp);
+      lp->keep_index = keep;
       return;
 }
 
@@ -47,6 +47,7 @@ void glp_set_rii(glp_prob *lp, int i, double rii)
             i, rii);
       if (lp->valid && lp->row[i]->rii != rii)
       {  GLPAIJ *aij;
+         prob_lists(lp);
          for (aij = lp->row[i]->ptr; aij != NULL; aij = aij->r_next)
          {  if (aij->col->stat == GLP_BS)
             {  /* invalidate the basis factorization */
@@ -55,6 +56,10 @@ void glp_set_rii(glp_prob *lp, int i, double rii)
             }
          }
       }
+      if (lp->row[i]->rii != rii)
+      {  /* the kept working matrix is out of date */
+         prob_drop_wlp(lp);
+      }
       lp->row[i]->rii = rii;
       return;
 }
@@ -84,6 +89,10 @@ void glp_set_sjj(glp_prob *lp, int j, double sjj)
       {  /* invalidate the basis factorization */
          lp->valid = 0;
       }
+      if (lp->col[j]->sjj != sjj)
+      {  /* the kept working matrix is out of date */
+         prob_drop_wlp(lp);
+      }
       lp->col[j]->sjj = sjj;
       return;
 }
@@ -102,6 +102,10 @@
 *     The search was prematurely terminated, because the time limit has
 *     been exceeded.
 *
+*  GLP_ESTOP
+*     The search was prematurely terminated by the application, because
+*     the flag pointed to by the control parameter stop was set.
+*
 *  GLP_ENOPFS
 *     The LP problem instance has no primal feasible solution (only if
 *     the LP presolver is used).
@@ -394,11 +398,14 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
          xerror("glp_simplex: meth = %d; invalid parameter\n",
             parm->meth);
       if (!(parm->pricing == GLP_PT_STD ||
-            parm->pricing == GLP_PT_PSE))
+            parm->pricing == GLP_PT_PSE ||
+            parm->pricing == GLP_PT_PART ||
+            parm->pricing == GLP_PT_MULT))
          xerror("glp_simplex: pricing = %d; invalid parameter\n",
             parm->pricing);
       if (!(parm->r_test == GLP_RT_STD ||
-            parm->r_test == GLP_RT_HAR))
+            parm->r_test == GLP_RT_HAR ||
+            parm->r_test == GLP_RT_FLIP))
          xerror("glp_simplex: r_test = %d; invalid parameter\n",
             parm->r_test);
       if (!(0.0 < parm->tol_bnd && parm->tol_bnd < 1.0))
@@ -425,6 +432,12 @@ int glp_simplex(glp_prob *P, const glp_smcp *parm)
       if (!(parm->presolve == GLP_ON || parm->presolve == GLP_OFF))
          xerror("glp_simplex: presolve = %d; invalid parameter\n",
             parm->presolve);
+      if (parm->prog_frq < 0)
+         xerror("glp_simplex: prog_frq = %d; invalid parameter\n",
+            parm->prog_frq);
+      if (!(1 <= parm->nthreads && parm->nthreads <= 256))
+         xerror("glp_simplex: nthreads = %d; invalid parameter\n",
+            parm->nthreads);
       /* basic solution is currently undefined */
       P->pbs_stat = P->dbs_stat = GLP_UNDEF;
       P->obj_val = 0.0;
@@ -503,6 +516,11 @@ void glp_init_smcp(glp_smcp *parm)
       parm->out_frq = 500;
       parm->out_dly = 0;
       parm->presolve = GLP_OFF;
+      parm->stop = NULL;
+      parm->prog_func = NULL;
+      parm->prog_info = NULL;
+      parm->prog_frq = 1000;
+      parm->nthreads = 1;
       return;
 }
 
@@ -77,7 +77,11 @@
 *
 *  GLP_ETMLIM
 *     The search was prematurely terminated, because the time limit has
-*     been exceeded. */
+*     been exceeded.
+*
+*  GLP_ESTOP
+*     The search was prematurely terminated by the application, because
+*     the flag pointed to by the control parameter stop was set. */
 
 static void set_d_eps(mpq_t x, double val)
 {     /* convert double val to rational x obtaining a more adequate
@@ -331,6 +335,7 @@ int glp_exact(glp_prob *lp, const glp_smcp *parm)
       ssx->it_cnt = lp->it_cnt;
       ssx->tm_lim = (double)parm->tm_lim / 1000.0;
 #endif
+      ssx->stop = parm->stop;
       ssx->out_frq = 5.0;
       ssx->tm_beg = xtime();
 #if 0 /* 10/VI-2013 */
@@ -390,6 +395,16 @@ int glp_exact(glp_prob *lp, const glp_smcp *parm)
             ret = GLP_ETMLIM;
             pst = GLP_FEAS, dst = GLP_INFEAS;
             break;
+         case 8:
+            /* search terminated by application (phase I) */
+            ret = GLP_ESTOP;
+            pst = dst = GLP_INFEAS;
+            break;
+         case 9:
+            /* search terminated by application (phase II) */
+            ret = GLP_ESTOP;
+            pst = GLP_FEAS, dst = GLP_INFEAS;
+            break;
          case 7:
             /* initial basis matrix is singular */
             ret = GLP_ESING;
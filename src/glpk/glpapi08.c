@@ -67,7 +67,10 @@
 *     Iteration limit exceeded.
 *
 *  GLP_EINSTAB
-*     Numerical instability on solving Newtonian system. */
+*     Numerical instability on solving Newtonian system.
+*
+*  GLP_ESTOP
+*     The search was terminated by application. */
 
 static void transform(NPP *npp)
 {     /* transform LP to the standard formulation */
@@ -139,6 +142,9 @@ int glp_interior(glp_prob *P, const glp_iptcp *parm)
             parm->ord_alg == GLP_ORD_SYMAMD))
          xerror("glp_interior: ord_alg = %d; invalid parameter\n",
             parm->ord_alg);
+      if (parm->prog_frq < 0)
+         xerror("glp_interior: prog_frq = %d; invalid parameter\n",
+            parm->prog_frq);
       /* interior-point solution is currently undefined */
       P->ipt_stat = GLP_UNDEF;
       P->ipt_obj = 0.0;
@@ -240,6 +246,10 @@ done: /* free working program objects */
 void glp_init_iptcp(glp_iptcp *parm)
 {     parm->msg_lev = GLP_MSG_ALL;
       parm->ord_alg = GLP_ORD_AMD;
+      parm->stop = NULL;
+      parm->prog_func = NULL;
+      parm->prog_info = NULL;
+      parm->prog_frq = 1000;
       return;
 }
 
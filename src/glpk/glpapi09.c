@@ -425,9 +425,14 @@ static void preprocess_and_solve_mip_start(glp_prob *P, glp_mip_ctx *ctx)
          xprintf("Solving LP relaxation...\n");
       glp_init_smcp(&smcp);
       smcp.msg_lev = parm->msg_lev;
+      smcp.stop = parm->stop;
       mip->it_cnt = P->it_cnt;
       ctx->ret = glp_simplex(mip, &smcp);
       P->it_cnt = mip->it_cnt;
+      if (ctx->ret == GLP_ESTOP)
+      {  ctx->presolve.state = PRE_DONE;
+         goto done;
+      }
       if (ctx->ret != 0)
       {  if (parm->msg_lev >= GLP_MSG_ERR)
             xprintf("glp_intopt: cannot solve LP relaxation\n");
@@ -509,6 +514,7 @@ void glp_intopt_start(glp_prob *P, glp_mip_ctx *ctx)
          xerror("glp_intopt: P = %p; invalid problem object\n", P);
       if (P->tree != NULL)
          xerror("glp_intopt: operation not allowed\n");
+      prob_lists(P);
       if (!(parm->msg_lev == GLP_MSG_OFF ||
             parm->msg_lev == GLP_MSG_ERR ||
             parm->msg_lev == GLP_MSG_ON  ||
@@ -771,6 +777,7 @@ void glp_init_iocp(glp_iocp *parm)
       parm->save_sol = NULL;
       parm->alien = GLP_OFF;
 #endif
+      parm->stop = NULL;
       return;
 }
 
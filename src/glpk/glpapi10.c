@@ -43,6 +43,7 @@ void glp_check_kkt(glp_prob *P, int sol, int cond, double *_ae_max,
             cond == GLP_KKT_CS))
          xerror("glp_check_kkt: cond = %d; invalid condition indicator "
             "\n", cond);
+      prob_lists(P);
       ae_max = re_max = 0.0;
       ae_ind = re_ind = 0;
       if (cond == GLP_KKT_PE)
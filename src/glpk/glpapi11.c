@@ -24,6 +24,7 @@
 
 #include "glpenv.h"
 #include "glpsdf.h"
+#include "misc.h"
 #include "prob.h"
 
 #define xfprintf glp_format
@@ -35,6 +36,7 @@ int glp_print_sol(glp_prob *P, const char *fname)
       GLPCOL *col;
       int i, j, t, ae_ind, re_ind, ret;
       double ae_max, re_max;
+      char numb[NUM2STR_LEN];
       xprintf("Writing basic solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -78,22 +80,22 @@ int glp_print_sol(glp_prob *P, const char *fname)
             row->stat == GLP_NU ? "NU" :
             row->stat == GLP_NF ? "NF" :
             row->stat == GLP_NS ? "NS" : "??");
-         xfprintf(fp, "%13.6g ",
-            fabs(row->prim) <= 1e-9 ? 0.0 : row->prim);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(row->prim) <= 1e-9 ? 0.0 : row->prim));
          if (row->type == GLP_LO || row->type == GLP_DB ||
              row->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", row->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (row->type == GLP_UP || row->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", row->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->ub));
          else
             xfprintf(fp, "%13s ", row->type == GLP_FX ? "=" : "");
          if (row->stat != GLP_BS)
          {  if (fabs(row->dual) <= 1e-9)
                xfprintf(fp, "%13s", "< eps");
             else
-               xfprintf(fp, "%13.6g ", row->dual);
+               xfprintf(fp, "%13s ", num2str(numb, 6, row->dual));
          }
          xfprintf(fp, "\n");
       }
@@ -115,22 +117,22 @@ int glp_print_sol(glp_prob *P, const char *fname)
             col->stat == GLP_NU ? "NU" :
             col->stat == GLP_NF ? "NF" :
             col->stat == GLP_NS ? "NS" : "??");
-         xfprintf(fp, "%13.6g ",
-            fabs(col->prim) <= 1e-9 ? 0.0 : col->prim);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(col->prim) <= 1e-9 ? 0.0 : col->prim));
          if (col->type == GLP_LO || col->type == GLP_DB ||
              col->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", col->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (col->type == GLP_UP || col->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", col->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->ub));
          else
             xfprintf(fp, "%13s ", col->type == GLP_FX ? "=" : "");
          if (col->stat != GLP_BS)
          {  if (fabs(col->dual) <= 1e-9)
                xfprintf(fp, "%13s", "< eps");
             else
-               xfprintf(fp, "%13.6g ", col->dual);
+               xfprintf(fp, "%13s ", num2str(numb, 6, col->dual));
          }
          xfprintf(fp, "\n");
       }
@@ -338,6 +340,7 @@ done: if (ret) lp->pbs_stat = lp->dbs_stat = GLP_UNDEF;
 int glp_write_sol(glp_prob *lp, const char *fname)
 {     glp_file *fp;
       int i, j, ret = 0;
+      char numb[NUM2STR_LEN], numb2[NUM2STR_LEN];
       xprintf("Writing basic solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -348,21 +351,23 @@ int glp_write_sol(glp_prob *lp, const char *fname)
       /* number of rows, number of columns */
       xfprintf(fp, "%d %d\n", lp->m, lp->n);
       /* primal status, dual status, objective value */
-      xfprintf(fp, "%d %d %.*g\n", lp->pbs_stat, lp->dbs_stat, DBL_DIG,
-         lp->obj_val);
+      xfprintf(fp, "%d %d %s\n", lp->pbs_stat, lp->dbs_stat,
+         num2str(numb, DBL_DIG, lp->obj_val));
       /* rows (auxiliary variables) */
       for (i = 1; i <= lp->m; i++)
       {  GLPROW *row = lp->row[i];
          /* status, primal value, dual value */
-         xfprintf(fp, "%d %.*g %.*g\n", row->stat, DBL_DIG, row->prim,
-            DBL_DIG, row->dual);
+         xfprintf(fp, "%d %s %s\n", row->stat,
+            num2str(numb, DBL_DIG, row->prim),
+            num2str(numb2, DBL_DIG, row->dual));
       }
       /* columns (structural variables) */
       for (j = 1; j <= lp->n; j++)
       {  GLPCOL *col = lp->col[j];
          /* status, primal value, dual value */
-         xfprintf(fp, "%d %.*g %.*g\n", col->stat, DBL_DIG, col->prim,
-            DBL_DIG, col->dual);
+         xfprintf(fp, "%d %s %s\n", col->stat,
+            num2str(numb, DBL_DIG, col->prim),
+            num2str(numb2, DBL_DIG, col->dual));
       }
 #if 0 /* FIXME */
       xfflush(fp);
@@ -659,6 +664,7 @@ int glp_print_ipt(glp_prob *P, const char *fname)
       GLPCOL *col;
       int i, j, t, ae_ind, re_ind, ret;
       double ae_max, re_max;
+      char numb[NUM2STR_LEN];
       xprintf("Writing interior-point solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -695,21 +701,21 @@ int glp_print_ipt(glp_prob *P, const char *fname)
          else
             xfprintf(fp, "%s\n%20s", row->name, "");
          xfprintf(fp, "%3s", "");
-         xfprintf(fp, "%13.6g ",
-            fabs(row->pval) <= 1e-9 ? 0.0 : row->pval);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(row->pval) <= 1e-9 ? 0.0 : row->pval));
          if (row->type == GLP_LO || row->type == GLP_DB ||
              row->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", row->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (row->type == GLP_UP || row->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", row->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->ub));
          else
             xfprintf(fp, "%13s ", row->type == GLP_FX ? "=" : "");
          if (fabs(row->dval) <= 1e-9)
             xfprintf(fp, "%13s", "< eps");
          else
-            xfprintf(fp, "%13.6g ", row->dval);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->dval));
          xfprintf(fp, "\n");
       }
       xfprintf(fp, "\n");
@@ -725,21 +731,21 @@ int glp_print_ipt(glp_prob *P, const char *fname)
          else
             xfprintf(fp, "%s\n%20s", col->name, "");
          xfprintf(fp, "%3s", "");
-         xfprintf(fp, "%13.6g ",
-            fabs(col->pval) <= 1e-9 ? 0.0 : col->pval);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(col->pval) <= 1e-9 ? 0.0 : col->pval));
          if (col->type == GLP_LO || col->type == GLP_DB ||
              col->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", col->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (col->type == GLP_UP || col->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", col->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->ub));
          else
             xfprintf(fp, "%13s ", col->type == GLP_FX ? "=" : "");
          if (fabs(col->dval) <= 1e-9)
             xfprintf(fp, "%13s", "< eps");
          else
-            xfprintf(fp, "%13.6g ", col->dval);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->dval));
          xfprintf(fp, "\n");
       }
       xfprintf(fp, "\n");
@@ -924,6 +930,7 @@ done: if (ret) lp->ipt_stat = GLP_UNDEF;
 int glp_write_ipt(glp_prob *lp, const char *fname)
 {     glp_file *fp;
       int i, j, ret = 0;
+      char numb[NUM2STR_LEN], numb2[NUM2STR_LEN];
       xprintf("Writing interior-point solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -934,20 +941,21 @@ int glp_write_ipt(glp_prob *lp, const char *fname)
       /* number of rows, number of columns */
       xfprintf(fp, "%d %d\n", lp->m, lp->n);
       /* solution status, objective value */
-      xfprintf(fp, "%d %.*g\n", lp->ipt_stat, DBL_DIG, lp->ipt_obj);
+      xfprintf(fp, "%d %s\n", lp->ipt_stat,
+         num2str(numb, DBL_DIG, lp->ipt_obj));
       /* rows (auxiliary variables) */
       for (i = 1; i <= lp->m; i++)
       {  GLPROW *row = lp->row[i];
          /* primal value, dual value */
-         xfprintf(fp, "%.*g %.*g\n", DBL_DIG, row->pval, DBL_DIG,
-            row->dval);
+         xfprintf(fp, "%s %s\n", num2str(numb, DBL_DIG, row->pval),
+            num2str(numb2, DBL_DIG, row->dval));
       }
       /* columns (structural variables) */
       for (j = 1; j <= lp->n; j++)
       {  GLPCOL *col = lp->col[j];
          /* primal value, dual value */
-         xfprintf(fp, "%.*g %.*g\n", DBL_DIG, col->pval, DBL_DIG,
-            col->dval);
+         xfprintf(fp, "%s %s\n", num2str(numb, DBL_DIG, col->pval),
+            num2str(numb2, DBL_DIG, col->dval));
       }
 #if 0 /* FIXME */
       xfflush(fp);
@@ -971,6 +979,7 @@ int glp_print_mip(glp_prob *P, const char *fname)
       GLPCOL *col;
       int i, j, t, ae_ind, re_ind, ret;
       double ae_max, re_max;
+      char numb[NUM2STR_LEN];
       xprintf("Writing MIP solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -1008,15 +1017,15 @@ int glp_print_mip(glp_prob *P, const char *fname)
          else
             xfprintf(fp, "%s\n%20s", row->name, "");
          xfprintf(fp, "%3s", "");
-         xfprintf(fp, "%13.6g ",
-            fabs(row->mipx) <= 1e-9 ? 0.0 : row->mipx);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(row->mipx) <= 1e-9 ? 0.0 : row->mipx));
          if (row->type == GLP_LO || row->type == GLP_DB ||
              row->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", row->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (row->type == GLP_UP || row->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", row->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, row->ub));
          else
             xfprintf(fp, "%13s ", row->type == GLP_FX ? "=" : "");
          xfprintf(fp, "\n");
@@ -1036,15 +1045,15 @@ int glp_print_mip(glp_prob *P, const char *fname)
          xfprintf(fp, "%s  ",
             col->kind == GLP_CV ? " " :
             col->kind == GLP_IV ? "*" : "?");
-         xfprintf(fp, "%13.6g ",
-            fabs(col->mipx) <= 1e-9 ? 0.0 : col->mipx);
+         xfprintf(fp, "%13s ", num2str(numb, 6,
+            fabs(col->mipx) <= 1e-9 ? 0.0 : col->mipx));
          if (col->type == GLP_LO || col->type == GLP_DB ||
              col->type == GLP_FX)
-            xfprintf(fp, "%13.6g ", col->lb);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->lb));
          else
             xfprintf(fp, "%13s ", "");
          if (col->type == GLP_UP || col->type == GLP_DB)
-            xfprintf(fp, "%13.6g ", col->ub);
+            xfprintf(fp, "%13s ", num2str(numb, 6, col->ub));
          else
             xfprintf(fp, "%13s ", col->type == GLP_FX ? "=" : "");
          xfprintf(fp, "\n");
@@ -1202,6 +1211,7 @@ done: if (ret) mip->mip_stat = GLP_UNDEF;
 int glp_write_mip(glp_prob *mip, const char *fname)
 {     glp_file *fp;
       int i, j, ret = 0;
+      char numb[NUM2STR_LEN];
       xprintf("Writing MIP solution to '%s'...\n", fname);
       fp = glp_open(fname, "w");
       if (fp == NULL)
@@ -1212,13 +1222,16 @@ int glp_write_mip(glp_prob *mip, const char *fname)
       /* number of rows, number of columns */
       xfprintf(fp, "%d %d\n", mip->m, mip->n);
       /* solution status, objective value */
-      xfprintf(fp, "%d %.*g\n", mip->mip_stat, DBL_DIG, mip->mip_obj);
+      xfprintf(fp, "%d %s\n", mip->mip_stat,
+         num2str(numb, DBL_DIG, mip->mip_obj));
       /* rows (auxiliary variables) */
       for (i = 1; i <= mip->m; i++)
-         xfprintf(fp, "%.*g\n", DBL_DIG, mip->row[i]->mipx);
+         xfprintf(fp, "%s\n",
+            num2str(numb, DBL_DIG, mip->row[i]->mipx));
       /* columns (structural variables) */
       for (j = 1; j <= mip->n; j++)
-         xfprintf(fp, "%.*g\n", DBL_DIG, mip->col[j]->mipx);
+         xfprintf(fp, "%s\n",
+            num2str(numb, DBL_DIG, mip->col[j]->mipx));
 #if 0 /* FIXME */
       xfflush(fp);
 #endif
@@ -94,6 +94,19 @@ static int b_col(void *info, int j, int ind[], double val[])
          ind[1] = k;
          val[1] = 1.0;
       }
+      else if (lp->csc != NULL)
+      {  /* x[k] is structural variable; its column is taken from the
+            column-wise copy of the matrix, which may be shared */
+         GLPCSM *csc = lp->csc;
+         double sjj = lp->col[k-m]->sjj;
+         int t;
+         len = 0;
+         for (t = csc->ptr[k-m]; t < csc->ptr[k-m+1]; t++)
+         {  len++;
+            ind[len] = csc->ind[t];
+            val[len] = - lp->row[ind[len]]->rii * csc->val[t] * sjj;
+         }
+      }
       else
       {  /* x[k] is structural variable */
          len = 0;
@@ -539,6 +552,7 @@ int glp_warm_up(glp_prob *P)
       GLPAIJ *aij;
       int i, j, type, stat, ret;
       double eps, temp, *work;
+      prob_lists(P);
       /* invalidate basic solution */
       P->pbs_stat = P->dbs_stat = GLP_UNDEF;
       P->obj_val = 0.0;
@@ -38,6 +38,7 @@ int glp_minisat1(glp_prob *P)
             P);
       if (P->tree != NULL)
          xerror("glp_minisat1: operation not allowed\n");
+      prob_lists(P);
       /* integer solution is currently undefined */
       P->mip_stat = GLP_UNDEF;
       P->mip_obj = 0.0;
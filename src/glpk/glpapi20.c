@@ -39,6 +39,7 @@ int glp_intfeas1(glp_prob *P, int use_bound, int obj_bound)
             P);
       if (P->tree != NULL)
          xerror("glp_intfeas1: operation not allowed\n");
+      prob_lists(P);
       /* integer solution is currently undefined */
       P->mip_stat = GLP_UNDEF;
       P->mip_obj = 0.0;
@@ -0,0 +1,585 @@
+/* glpbin.c (reading/writing data in binary format) */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "glpenv.h"
+#include "misc.h"
+#include "prob.h"
+
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/***********************************************************************
+*  The binary format is a memory image of the problem data, so it can
+*  be loaded without any tokenizing or number conversion. All values
+*  are stored in the byte order of the machine which wrote the file,
+*  every section starts on an 8-byte boundary:
+*
+*  header   struct bin_head;
+*  rows     struct bin_row[m];
+*  columns  struct bin_col[n];
+*  matrix   int ptr[1+n], int ind[nnz], double val[nnz] (column-wise,
+*           elements of column j are ind/val[ptr[j-1]], ..., [ptr[j]-1]);
+*  names    int len[2+m+n], char str[name_len] (optional; lengths of
+*           problem, objective, row and column names, 0 means no name).
+*
+*  Basis statuses and scale factors are always present in the row and
+*  column records, flags of the header tell whether they are valid. */
+
+#define M_MAX 100000000 /* = 100*10^6 */
+/* maximal number of rows in the problem object */
+
+#define N_MAX 100000000 /* = 100*10^6 */
+/* maximal number of columns in the problem object */
+
+#define NNZ_MAX 500000000 /* = 500*10^6 */
+/* maximal number of constraint coefficients in the problem object */
+
+#define BIN_MAGIC "GLPKBIN"
+#define BIN_VERSION 1
+#define BIN_ORDER 0x01020304
+
+struct bin_head
+{     char magic[8];
+      int version, order, flags;
+      int m, n, nnz;
+      int dir, name_len;
+      double c0;
+      int foo_bar[4];
+};
+
+struct bin_row
+{     int type, stat;
+      double lb, ub, rii;
+};
+
+struct bin_col
+{     int type, kind, stat, foo;
+      double lb, ub, coef, sjj;
+};
+
+#define ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+struct csa
+{     /* common storage area */
+      const char *fname;
+      /* name of input file */
+      glp_file *fp;
+      /* stream assigned to input file; NULL if the file is mapped */
+      char *map;
+      /* start of the mapped file */
+      size_t size, pos;
+      /* size of the mapped file and current position */
+      void *buf[8];
+      int nbuf;
+      /* buffers holding sections read from the stream */
+};
+
+static int open_file(struct csa *csa)
+{     /* prefer mapping the file, compressed files and platforms
+         without mmap are read through a stream */
+#ifdef HAVE_MMAP
+      const char *ext = strrchr(csa->fname, '.');
+#endif
+      csa->fp = NULL;
+      csa->map = NULL;
+      csa->size = csa->pos = 0;
+      csa->nbuf = 0;
+#ifdef HAVE_MMAP
+      if ((ext == NULL || strcmp(ext, ".gz") != 0) &&
+          strncmp(csa->fname, "/dev/", 5) != 0)
+      {  struct stat st;
+         int fd = open(csa->fname, O_RDONLY);
+         if (fd < 0)
+         {  xprintf("Unable to open '%s' - %s\n", csa->fname,
+               strerror(errno));
+            return 1;
+         }
+         if (fstat(fd, &st) == 0 && st.st_size > 0)
+         {  void *map = mmap(NULL, (size_t)st.st_size, PROT_READ,
+               MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED)
+            {  csa->map = map;
+               csa->size = (size_t)st.st_size;
+#ifdef MADV_SEQUENTIAL
+               madvise(map, csa->size, MADV_SEQUENTIAL);
+#endif
+            }
+         }
+         close(fd);
+         if (csa->map != NULL)
+            return 0;
+      }
+#endif
+      csa->fp = glp_open(csa->fname, "rb");
+      if (csa->fp == NULL)
+      {  xprintf("Unable to open '%s' - %s\n", csa->fname,
+            get_err_msg());
+         return 1;
+      }
+      return 0;
+}
+
+static const void *fetch(struct csa *csa, size_t size)
+{     /* return pointer to next size bytes of the file; NULL means the
+         file is truncated or a read error occurred */
+      size_t len = ALIGN(size), nrd;
+      char *ptr;
+      if (csa->fp == NULL)
+      {  if (len > csa->size - csa->pos)
+         {  /* the last section may be unpadded */
+            if (size > csa->size - csa->pos)
+               return NULL;
+            len = size;
+         }
+         ptr = csa->map + csa->pos;
+         csa->pos += len;
+         return ptr;
+      }
+      xassert(csa->nbuf < (int)(sizeof(csa->buf) / sizeof(void *)));
+      ptr = csa->buf[csa->nbuf++] = xalloc(1, len > 0 ? len : 1);
+      for (nrd = 0; nrd < len; )
+      {  int cnt = (len - nrd > 0x40000000 ? 0x40000000 :
+            (int)(len - nrd));
+         cnt = glp_read(csa->fp, ptr + nrd, cnt);
+         if (cnt <= 0)
+         {  if (nrd >= size)
+               break;
+            if (cnt < 0)
+               xprintf("Read error on '%s' - %s\n", csa->fname,
+                  get_err_msg());
+            return NULL;
+         }
+         nrd += cnt;
+      }
+      return ptr;
+}
+
+static void close_file(struct csa *csa)
+{     int k;
+#ifdef HAVE_MMAP
+      if (csa->map != NULL)
+         munmap(csa->map, csa->size);
+#endif
+      if (csa->fp != NULL)
+         glp_close(csa->fp);
+      for (k = 0; k < csa->nbuf; k++)
+         xfree(csa->buf[k]);
+      return;
+}
+
+static int set_name(glp_prob *P, int k, const char *str, int len)
+{     /* assign symbolic name; k = -1 means problem name, k = 0 means
+         objective name, k = 1, ..., m+n means row/column name */
+      char name[255+1];
+      if (len == 0)
+         return 0;
+      if (!(1 <= len && len <= 255))
+         return 1;
+      memcpy(name, str, len);
+      name[len] = '\0';
+      if (strlen(name) != (size_t)len)
+         return 1;
+      if (k < 0)
+         glp_set_prob_name(P, name);
+      else if (k == 0)
+         glp_set_obj_name(P, name);
+      else if (k <= P->m)
+         glp_set_row_name(P, k, name);
+      else
+         glp_set_col_name(P, k - P->m, name);
+      return 0;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_read_bin - read problem data in binary format
+*
+*  SYNOPSIS
+*
+*  int glp_read_bin(glp_prob *P, int flags, const char *fname);
+*
+*  DESCRIPTION
+*
+*  The routine glp_read_bin reads problem data written by the routine
+*  glp_write_bin. Where possible the file is mapped into memory and the
+*  problem object is built directly from the mapped data. Basis
+*  statuses, scale factors and symbolic names are restored if they are
+*  present in the file. The parameter flags is reserved and must be 0.
+*
+*  RETURNS
+*
+*  If the operation was successful, the routine returns zero. Otherwise
+*  it prints an error message and returns non-zero. */
+
+int glp_read_bin(glp_prob *P, int flags, const char *fname)
+{     struct csa _csa, *csa = &_csa;
+      const struct bin_head *head;
+      const struct bin_row *rows;
+      const struct bin_col *cols;
+      const int *ptr, *ind, *len;
+      const double *val;
+      const char *str;
+      GLPAIJ *aij, *tail;
+      int m, n, i, j, k, ret = 1;
+      size_t pos;
+      if (P == NULL || P->magic != GLP_PROB_MAGIC)
+         xerror("glp_read_bin: P = %p; invalid problem object\n", P);
+      if (flags != 0)
+         xerror("glp_read_bin: flags = %d; invalid parameter\n",
+            flags);
+      if (fname == NULL)
+         xerror("glp_read_bin: fname = %d; invalid parameter\n",
+            fname);
+      glp_erase_prob(P);
+      xprintf("Reading problem data from '%s'...\n", fname);
+      csa->fname = fname;
+      if (open_file(csa) != 0)
+         return 1;
+      /* read and check the header */
+      head = fetch(csa, sizeof(struct bin_head));
+      if (head == NULL || memcmp(head->magic, BIN_MAGIC, 8) != 0)
+      {  xprintf("%s: not a binary problem file\n", fname);
+         goto done;
+      }
+      if (head->order != BIN_ORDER)
+      {  xprintf("%s: byte order not supported\n", fname);
+         goto done;
+      }
+      if (head->version != BIN_VERSION)
+      {  xprintf("%s: version %d not supported\n", fname,
+            head->version);
+         goto done;
+      }
+      m = head->m, n = head->n;
+      if (!(0 <= m && m <= M_MAX && 0 <= n && n <= N_MAX &&
+            0 <= head->nnz && head->nnz <= NNZ_MAX &&
+            (head->dir == GLP_MIN || head->dir == GLP_MAX) &&
+            head->name_len >= 0))
+      {  xprintf("%s: invalid header\n", fname);
+         goto done;
+      }
+      flags = head->flags;
+      glp_set_obj_dir(P, head->dir);
+      glp_set_obj_coef(P, 0, head->c0);
+      if (m > 0)
+         glp_add_rows(P, m);
+      if (n > 0)
+         glp_add_cols(P, n);
+      /* rows */
+      rows = fetch(csa, (size_t)m * sizeof(struct bin_row));
+      if (rows == NULL)
+         goto trunc;
+      for (i = 1; i <= m; i++)
+      {  const struct bin_row *row = &rows[i-1];
+         if (!(GLP_FR <= row->type && row->type <= GLP_FX))
+         {  xprintf("%s: row %d: invalid type\n", fname, i);
+            goto done;
+         }
+         if (((flags & GLP_BIN_BASIS) &&
+             !(GLP_BS <= row->stat && row->stat <= GLP_NS)) ||
+             ((flags & GLP_BIN_SCALE) && !(row->rii > 0.0)))
+         {  xprintf("%s: row %d: invalid status or scale factor\n",
+               fname, i);
+            goto done;
+         }
+         glp_set_row_bnds(P, i, row->type, row->lb, row->ub);
+         if (flags & GLP_BIN_BASIS)
+            glp_set_row_stat(P, i, row->stat);
+         if (flags & GLP_BIN_SCALE)
+            glp_set_rii(P, i, row->rii);
+      }
+      /* columns */
+      cols = fetch(csa, (size_t)n * sizeof(struct bin_col));
+      if (cols == NULL)
+         goto trunc;
+      for (j = 1; j <= n; j++)
+      {  const struct bin_col *col = &cols[j-1];
+         if (!(GLP_FR <= col->type && col->type <= GLP_FX) ||
+             !(col->kind == GLP_CV || col->kind == GLP_IV))
+         {  xprintf("%s: column %d: invalid type or kind\n", fname, j);
+            goto done;
+         }
+         if (((flags & GLP_BIN_BASIS) &&
+             !(GLP_BS <= col->stat && col->stat <= GLP_NS)) ||
+             ((flags & GLP_BIN_SCALE) && !(col->sjj > 0.0)))
+         {  xprintf("%s: column %d: invalid status or scale factor\n",
+               fname, j);
+            goto done;
+         }
+         glp_set_col_bnds(P, j, col->type, col->lb, col->ub);
+         glp_set_obj_coef(P, j, col->coef);
+         P->col[j]->kind = col->kind;
+         if (flags & GLP_BIN_BASIS)
+            glp_set_col_stat(P, j, col->stat);
+         if (flags & GLP_BIN_SCALE)
+            glp_set_sjj(P, j, col->sjj);
+      }
+      /* constraint matrix; elements are linked directly, the checks
+         are the same as in glp_set_mat_col */
+      ptr = fetch(csa, (size_t)(1+n) * sizeof(int));
+      ind = fetch(csa, (size_t)head->nnz * sizeof(int));
+      val = fetch(csa, (size_t)head->nnz * sizeof(double));
+      if (ptr == NULL || ind == NULL || val == NULL)
+         goto trunc;
+      if (!(ptr[0] == 0 && ptr[n] == head->nnz))
+      {  xprintf("%s: invalid column pointers\n", fname);
+         goto done;
+      }
+      for (j = 1; j <= n; j++)
+      {  GLPCOL *col = P->col[j];
+         if (ptr[j] < ptr[j-1])
+         {  xprintf("%s: invalid column pointers\n", fname);
+            goto done;
+         }
+         tail = NULL;
+         for (k = ptr[j-1]; k < ptr[j]; k++)
+         {  GLPROW *row;
+            i = ind[k];
+            if (!(1 <= i && i <= m))
+            {  xprintf("%s: column %d: row index %d out of range\n",
+                  fname, j, i);
+               goto done;
+            }
+            row = P->row[i];
+            if (row->ptr != NULL && row->ptr->col == col)
+            {  xprintf("%s: column %d: duplicate row index %d\n",
+                  fname, j, i);
+               goto done;
+            }
+            if (val[k] == 0.0)
+            {  xprintf("%s: column %d: zero element in row %d\n",
+                  fname, j, i);
+               goto done;
+            }
+            aij = dmp_get_atom(P->pool, sizeof(GLPAIJ)), P->nnz++;
+            aij->row = row;
+            aij->col = col;
+            aij->val = val[k];
+            aij->r_prev = NULL;
+            aij->r_next = row->ptr;
+            aij->c_prev = tail;
+            aij->c_next = NULL;
+            if (aij->r_next != NULL) aij->r_next->r_prev = aij;
+            if (tail == NULL)
+               col->ptr = aij;
+            else
+               tail->c_next = aij;
+            row->ptr = tail = aij;
+         }
+      }
+      prob_mat_changed(P);
+      /* symbolic names */
+      if (flags & GLP_BIN_NAMES)
+      {  len = fetch(csa, (size_t)(2+m+n) * sizeof(int));
+         str = fetch(csa, (size_t)head->name_len);
+         if (len == NULL || str == NULL)
+            goto trunc;
+         pos = 0;
+         for (k = -1; k <= m+n; k++)
+         {  if (!(0 <= len[k+1] &&
+                  (size_t)len[k+1] <= (size_t)head->name_len - pos) ||
+                set_name(P, k, str + pos, len[k+1]) != 0)
+            {  xprintf("%s: invalid symbolic name\n", fname);
+               goto done;
+            }
+            pos += len[k+1];
+         }
+      }
+      xprintf("%d row%s, %d column%s, %d non-zero%s\n",
+         m, m == 1 ? "" : "s", n, n == 1 ? "" : "s",
+         P->nnz, P->nnz == 1 ? "" : "s");
+      ret = 0;
+      goto done;
+trunc:xprintf("%s: unexpected end of file\n", fname);
+done: close_file(csa);
+      if (ret != 0) glp_erase_prob(P);
+      return ret;
+}
+
+static int write_data(glp_file *fp, const void *buf, size_t size)
+{     /* write data padded to an 8-byte boundary */
+      static const char pad[8];
+      size_t nwr;
+      for (nwr = 0; nwr < size; )
+      {  int cnt = (size - nwr > 0x40000000 ? 0x40000000 :
+            (int)(size - nwr));
+         if (glp_write(fp, (const char *)buf + nwr, cnt) != cnt)
+            return 1;
+         nwr += cnt;
+      }
+      if (ALIGN(size) != size &&
+          glp_write(fp, pad, (int)(ALIGN(size) - size)) < 0)
+         return 1;
+      return 0;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  glp_write_bin - write problem data in binary format
+*
+*  SYNOPSIS
+*
+*  int glp_write_bin(glp_prob *P, int flags, const char *fname);
+*
+*  DESCRIPTION
+*
+*  The routine glp_write_bin writes problem data in binary format to a
+*  file, which can be read back with the routine glp_read_bin. The
+*  parameter flags is a combination of the following options:
+*
+*  GLP_BIN_NAMES  write symbolic names;
+*  GLP_BIN_BASIS  write the current basis (row and column statuses);
+*  GLP_BIN_SCALE  write row and column scale factors.
+*
+*  RETURNS
+*
+*  If the operation was successful, the routine returns zero. Otherwise
+*  the routine prints an error message and returns non-zero. */
+
+int glp_write_bin(glp_prob *P, int flags, const char *fname)
+{     glp_file *fp;
+      struct bin_head head;
+      struct bin_row *rows = NULL;
+      struct bin_col *cols = NULL;
+      int *ptr = NULL, *ind = NULL, *len = NULL;
+      double *val = NULL;
+      char *str = NULL;
+      GLPAIJ *aij;
+      const char *name;
+      int m, n, i, j, k, ret = 1;
+      size_t pos;
+      if (P == NULL || P->magic != GLP_PROB_MAGIC)
+         xerror("glp_write_bin: P = %p; invalid problem object\n", P);
+      if (flags & ~(GLP_BIN_NAMES | GLP_BIN_BASIS | GLP_BIN_SCALE))
+         xerror("glp_write_bin: flags = %d; invalid parameter\n",
+            flags);
+      if (fname == NULL)
+         xerror("glp_write_bin: fname = %d; invalid parameter\n",
+            fname);
+      prob_lists(P);
+      xprintf("Writing problem data to '%s'...\n", fname);
+      fp = glp_open(fname, "wb");
+      if (fp == NULL)
+      {  xprintf("Unable to create '%s' - %s\n", fname, get_err_msg());
+         return 1;
+      }
+      m = P->m, n = P->n;
+      memset(&head, 0, sizeof(head));
+      memcpy(head.magic, BIN_MAGIC, 8);
+      head.version = BIN_VERSION;
+      head.order = BIN_ORDER;
+      head.flags = flags;
+      head.m = m, head.n = n, head.nnz = P->nnz;
+      head.dir = P->dir;
+      head.c0 = P->c0;
+      rows = xcalloc(1+m, sizeof(struct bin_row));
+      memset(rows, 0, (1+m) * sizeof(struct bin_row));
+      for (i = 1; i <= m; i++)
+      {  GLPROW *row = P->row[i];
+         rows[i-1].type = row->type;
+         rows[i-1].stat = row->stat;
+         rows[i-1].lb = row->lb;
+         rows[i-1].ub = row->ub;
+         rows[i-1].rii = row->rii;
+      }
+      cols = xcalloc(1+n, sizeof(struct bin_col));
+      memset(cols, 0, (1+n) * sizeof(struct bin_col));
+      ptr = xcalloc(1+n, sizeof(int));
+      ind = xcalloc(1+P->nnz, sizeof(int));
+      val = xcalloc(1+P->nnz, sizeof(double));
+      ptr[0] = k = 0;
+      for (j = 1; j <= n; j++)
+      {  GLPCOL *col = P->col[j];
+         cols[j-1].type = col->type;
+         cols[j-1].kind = col->kind;
+         cols[j-1].stat = col->stat;
+         cols[j-1].lb = col->lb;
+         cols[j-1].ub = col->ub;
+         cols[j-1].coef = col->coef;
+         cols[j-1].sjj = col->sjj;
+         for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+         {  ind[k] = aij->row->i;
+            val[k] = aij->val;
+            k++;
+         }
+         ptr[j] = k;
+      }
+      xassert(k == P->nnz);
+      if (flags & GLP_BIN_NAMES)
+      {  len = xcalloc(2+m+n, sizeof(int));
+         pos = 0;
+         for (k = -1; k <= m+n; k++)
+         {  name = (k < 0 ? P->name : k == 0 ? P->obj :
+               k <= m ? P->row[k]->name : P->col[k-m]->name);
+            len[k+1] = (name == NULL ? 0 : (int)strlen(name));
+            pos += len[k+1];
+         }
+         if (pos > INT_MAX)
+         {  xprintf("%s: symbolic names too long\n", fname);
+            goto done;
+         }
+         head.name_len = (int)pos;
+         str = xalloc(1, pos > 0 ? pos : 1);
+         pos = 0;
+         for (k = -1; k <= m+n; k++)
+         {  name = (k < 0 ? P->name : k == 0 ? P->obj :
+               k <= m ? P->row[k]->name : P->col[k-m]->name);
+            if (len[k+1] == 0)
+               continue;
+            memcpy(str + pos, name, len[k+1]);
+            pos += len[k+1];
+         }
+      }
+      if (write_data(fp, &head, sizeof(head)) ||
+          write_data(fp, rows, (size_t)m * sizeof(struct bin_row)) ||
+          write_data(fp, cols, (size_t)n * sizeof(struct bin_col)) ||
+          write_data(fp, ptr, (size_t)(1+n) * sizeof(int)) ||
+          write_data(fp, ind, (size_t)P->nnz * sizeof(int)) ||
+          write_data(fp, val, (size_t)P->nnz * sizeof(double)) ||
+          ((flags & GLP_BIN_NAMES) &&
+          (write_data(fp, len, (size_t)(2+m+n) * sizeof(int)) ||
+           write_data(fp, str, (size_t)head.name_len))))
+      {  xprintf("Write error on '%s' - %s\n", fname, get_err_msg());
+         goto done;
+      }
+      xprintf("%d row%s, %d column%s, %d non-zero%s\n",
+         m, m == 1 ? "" : "s", n, n == 1 ? "" : "s",
+         P->nnz, P->nnz == 1 ? "" : "s");
+      ret = 0;
+done: if (glp_close(fp) != 0 && ret == 0)
+      {  xprintf("Write error on '%s' - %s\n", fname, get_err_msg());
+         ret = 1;
+      }
+      xfree(rows);
+      xfree(cols);
+      xfree(ptr);
+      xfree(ind);
+      xfree(val);
+      if (len != NULL) xfree(len);
+      if (str != NULL) xfree(str);
+      return ret;
+}
+
+/* eof */
@@ -962,7 +962,8 @@ int glp_read_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
       }
       xprintf("%d lines were read\n", csa->count);
       /* problem data has been successfully read */
-      glp_delete_index(P);
+      if (!P->keep_index)
+         glp_delete_index(P);
       glp_sort_matrix(P);
       ret = 0;
 done: if (csa->fp != NULL) glp_close(csa->fp);
@@ -1080,12 +1081,14 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
       GLPCOL *col;
       GLPAIJ *aij;
       int i, j, len, flag, count, ret;
-      char line[1000+1], term[500+1], name[255+1];
+      char line[1000+1], term[500+1], name[255+1], numb[NUM2STR_LEN],
+         numb2[NUM2STR_LEN];
       xprintf("Writing problem data to '%s'...\n", fname);
       if (parm == NULL)
          glp_init_cpxcp(&_parm), parm = &_parm;
       /* check control parameters */
       check_parm("glp_write_lp", parm);
+      prob_lists(P);
       /* initialize common storage area */
       csa->P = P;
       csa->parm = parm;
@@ -1130,9 +1133,11 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
             else if (col->coef == -1.0)
                sprintf(term, " - %s", name);
             else if (col->coef > 0.0)
-               sprintf(term, " + %.*g %s", DBL_DIG, +col->coef, name);
+               sprintf(term, " + %s %s",
+                  num2str(numb, DBL_DIG, +col->coef), name);
             else
-               sprintf(term, " - %.*g %s", DBL_DIG, -col->coef, name);
+               sprintf(term, " - %s %s",
+                  num2str(numb, DBL_DIG, -col->coef), name);
             if (strlen(line) + strlen(term) > 72)
                xfprintf(fp, "%s\n", line), line[0] = '\0', count++;
             strcat(line, term);
@@ -1145,8 +1150,8 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
       }
       xfprintf(fp, "%s\n", line), count++;
       if (P->c0 != 0.0)
-         xfprintf(fp, "\\* constant term = %.*g *\\\n", DBL_DIG, P->c0),
-            count++;
+         xfprintf(fp, "\\* constant term = %s *\\\n",
+            num2str(numb, DBL_DIG, P->c0)), count++;
       xfprintf(fp, "\n"), count++;
       /* write the constraints section */
       xfprintf(fp, "Subject To\n"), count++;
@@ -1163,9 +1168,11 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
             else if (aij->val == -1.0)
                sprintf(term, " - %s", name);
             else if (aij->val > 0.0)
-               sprintf(term, " + %.*g %s", DBL_DIG, +aij->val, name);
+               sprintf(term, " + %s %s",
+                  num2str(numb, DBL_DIG, +aij->val), name);
             else
-               sprintf(term, " - %.*g %s", DBL_DIG, -aij->val, name);
+               sprintf(term, " - %s %s",
+                  num2str(numb, DBL_DIG, -aij->val), name);
             if (strlen(line) + strlen(term) > 72)
                xfprintf(fp, "%s\n", line), line[0] = '\0', count++;
             strcat(line, term);
@@ -1184,11 +1191,11 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
          }
          /* right hand-side */
          if (row->type == GLP_LO)
-            sprintf(term, " >= %.*g", DBL_DIG, row->lb);
+            sprintf(term, " >= %s", num2str(numb, DBL_DIG, row->lb));
          else if (row->type == GLP_UP)
-            sprintf(term, " <= %.*g", DBL_DIG, row->ub);
+            sprintf(term, " <= %s", num2str(numb, DBL_DIG, row->ub));
          else if (row->type == GLP_DB || row->type == GLP_FX)
-            sprintf(term, " = %.*g", DBL_DIG, row->lb);
+            sprintf(term, " = %s", num2str(numb, DBL_DIG, row->lb));
          else
             xassert(row != row);
          if (strlen(line) + strlen(term) > 72)
@@ -1204,8 +1211,8 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
          if (row->type != GLP_DB) continue;
          if (!flag)
             xfprintf(fp, "Bounds\n"), flag = 1, count++;
-         xfprintf(fp, " 0 <= ~r_%d <= %.*g\n",
-            i, DBL_DIG, row->ub - row->lb), count++;
+         xfprintf(fp, " 0 <= ~r_%d <= %s\n",
+            i, num2str(numb, DBL_DIG, row->ub - row->lb)), count++;
       }
       for (j = 1; j <= P->n; j++)
       {  col = P->col[j];
@@ -1216,17 +1223,18 @@ int glp_write_lp(glp_prob *P, const glp_cpxcp *parm, const char *fname)
          if (col->type == GLP_FR)
             xfprintf(fp, " %s free\n", name), count++;
          else if (col->type == GLP_LO)
-            xfprintf(fp, " %s >= %.*g\n",
-               name, DBL_DIG, col->lb), count++;
+            xfprintf(fp, " %s >= %s\n",
+               name, num2str(numb, DBL_DIG, col->lb)), count++;
          else if (col->type == GLP_UP)
-            xfprintf(fp, " -Inf <= %s <= %.*g\n",
-               name, DBL_DIG, col->ub), count++;
+            xfprintf(fp, " -Inf <= %s <= %s\n",
+               name, num2str(numb, DBL_DIG, col->ub)), count++;
          else if (col->type == GLP_DB)
-            xfprintf(fp, " %.*g <= %s <= %.*g\n",
-               DBL_DIG, col->lb, name, DBL_DIG, col->ub), count++;
+            xfprintf(fp, " %s <= %s <= %s\n",
+               num2str(numb, DBL_DIG, col->lb), name,
+               num2str(numb2, DBL_DIG, col->ub)), count++;
          else if (col->type == GLP_FX)
-            xfprintf(fp, " %s = %.*g\n",
-               name, DBL_DIG, col->lb), count++;
+            xfprintf(fp, " %s = %s\n",
+               name, num2str(numb, DBL_DIG, col->lb)), count++;
          else
             xassert(col != col);
       }
@@ -1366,6 +1366,7 @@ int glp_write_prob(glp_prob *P, int flags, const char *fname)
       GLPCOL *col;
       GLPAIJ *aij;
       int mip, i, j, count, ret;
+      char numb[NUM2STR_LEN], numb2[NUM2STR_LEN];
       if (P == NULL || P->magic != GLP_PROB_MAGIC)
          xerror("glp_write_prob: P = %p; invalid problem object\n",
             P);
@@ -1375,6 +1376,7 @@ int glp_write_prob(glp_prob *P, int flags, const char *fname)
       if (fname == NULL)
          xerror("glp_write_prob: fname = %d; invalid parameter\n",
             fname);
+      prob_lists(P);
       xprintf("Writing problem data to '%s'...\n", fname);
       fp = glp_open(fname, "w"), count = 0;
       if (fp == NULL)
@@ -1400,14 +1402,14 @@ int glp_write_prob(glp_prob *P, int flags, const char *fname)
          if (row->type == GLP_FR)
             xfprintf(fp, "f\n");
          else if (row->type == GLP_LO)
-            xfprintf(fp, "l %.*g\n", DBL_DIG, row->lb);
+            xfprintf(fp, "l %s\n", num2str(numb, DBL_DIG, row->lb));
          else if (row->type == GLP_UP)
-            xfprintf(fp, "u %.*g\n", DBL_DIG, row->ub);
+            xfprintf(fp, "u %s\n", num2str(numb, DBL_DIG, row->ub));
          else if (row->type == GLP_DB)
-            xfprintf(fp, "d %.*g %.*g\n", DBL_DIG, row->lb, DBL_DIG,
-                  row->ub);
+            xfprintf(fp, "d %s %s\n", num2str(numb, DBL_DIG, row->lb),
+                  num2str(numb2, DBL_DIG, row->ub));
          else if (row->type == GLP_FX)
-            xfprintf(fp, "s %.*g\n", DBL_DIG, row->lb);
+            xfprintf(fp, "s %s\n", num2str(numb, DBL_DIG, row->lb));
          else
             xassert(row != row);
 skip1:   if (row->name != NULL)
@@ -1433,14 +1435,14 @@ skip1:   if (row->name != NULL)
          if (col->type == GLP_FR)
             xfprintf(fp, "f\n");
          else if (col->type == GLP_LO)
-            xfprintf(fp, "l %.*g\n", DBL_DIG, col->lb);
+            xfprintf(fp, "l %s\n", num2str(numb, DBL_DIG, col->lb));
          else if (col->type == GLP_UP)
-            xfprintf(fp, "u %.*g\n", DBL_DIG, col->ub);
+            xfprintf(fp, "u %s\n", num2str(numb, DBL_DIG, col->ub));
          else if (col->type == GLP_DB)
-            xfprintf(fp, "d %.*g %.*g\n", DBL_DIG, col->lb, DBL_DIG,
-                  col->ub);
+            xfprintf(fp, "d %s %s\n", num2str(numb, DBL_DIG, col->lb),
+                  num2str(numb2, DBL_DIG, col->ub));
          else if (col->type == GLP_FX)
-            xfprintf(fp, "s %.*g\n", DBL_DIG, col->lb);
+            xfprintf(fp, "s %s\n", num2str(numb, DBL_DIG, col->lb));
          else
             xassert(col != col);
 skip2:   if (col->name != NULL)
@@ -1448,19 +1450,20 @@ skip2:   if (col->name != NULL)
       }
       /* write objective coefficient descriptors */
       if (P->c0 != 0.0)
-         xfprintf(fp, "a 0 0 %.*g\n", DBL_DIG, P->c0), count++;
+         xfprintf(fp, "a 0 0 %s\n", num2str(numb, DBL_DIG, P->c0)),
+            count++;
       for (j = 1; j <= P->n; j++)
       {  col = P->col[j];
          if (col->coef != 0.0)
-            xfprintf(fp, "a 0 %d %.*g\n", j, DBL_DIG, col->coef),
-               count++;
+            xfprintf(fp, "a 0 %d %s\n", j,
+               num2str(numb, DBL_DIG, col->coef)), count++;
       }
       /* write constraint coefficient descriptors */
       for (i = 1; i <= P->m; i++)
       {  row = P->row[i];
          for (aij = row->ptr; aij != NULL; aij = aij->r_next)
-            xfprintf(fp, "a %d %d %.*g\n", i, aij->col->j, DBL_DIG,
-               aij->val), count++;
+            xfprintf(fp, "a %d %d %s\n", i, aij->col->j,
+               num2str(numb, DBL_DIG, aij->val)), count++;
       }
       /* write end line */
       xfprintf(fp, "e o f\n"), count++;
@@ -1590,6 +1593,7 @@ int glp_check_cnfsat(glp_prob *P)
       if (P == NULL || P->magic != GLP_PROB_MAGIC)
          xerror("glp_check_cnfsat: P = %p; invalid problem object\n",
             P);
+      prob_lists(P);
       /* check columns */
       for (j = 1; j <= n; j++)
       {  col = P->col[j];
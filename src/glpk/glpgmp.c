@@ -39,9 +39,11 @@ void gmp_free_mem(void) { return; }
 
 #else                         /* use GLPK bignum module */
 
-static DMP *gmp_pool = NULL;
-static int gmp_size = 0;
-static unsigned short *gmp_work = NULL;
+static TLS DMP *gmp_pool = NULL;
+static TLS int gmp_size = 0;
+static TLS unsigned short *gmp_work = NULL;
+/* the atom pool and working array are kept per thread, so glp_exact
+ * may run concurrently on different threads */
 
 void *gmp_get_atom(int size)
 {     if (gmp_pool == NULL)
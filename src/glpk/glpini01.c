@@ -102,6 +102,7 @@ void glp_adv_basis(glp_prob *P, int flags)
          glp_std_basis(P);
          goto done;
       }
+      prob_lists(P);
       xprintf("Constructing initial basis...\n");
       /* allocate working arrays */
       min_mn = (m < n ? m : n);
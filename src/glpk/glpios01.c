@@ -1336,6 +1336,7 @@ int ios_solve_node(glp_tree *tree)
             xassert(tree != tree);
       }
       parm.meth = GLP_DUALP;
+      parm.stop = tree->parm->stop;
       if (tree->parm->msg_lev < GLP_MSG_DBG)
          parm.out_dly = tree->parm->out_dly;
       else
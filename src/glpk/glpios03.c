@@ -1017,6 +1017,13 @@ more: /* minor loop starts here */
          ctx->ret = GLP_ETMLIM;
          goto done;
       }
+      /* check if the search has been terminated by application */
+      if (T->parm->stop != NULL && *T->parm->stop)
+      {  if (T->parm->msg_lev >= GLP_MSG_DBG)
+            xprintf("Search terminated by application\n");
+         ctx->ret = GLP_ESTOP;
+         goto done;
+      }
       /* let the application program preprocess the subproblem */
       if (T->parm->cb_func != NULL  && GLP_FPREPRO & T->parm->cb_reasons)
       {  xassert(T->reason == 0);
@@ -1054,6 +1061,8 @@ prepro:
       if (T->parm->msg_lev >= GLP_MSG_DBG)
          xprintf("Solving LP relaxation...\n");
       ctx->ret = ios_solve_node(T);
+      if (ctx->ret == GLP_ESTOP)
+         goto done;
       if (!(ctx->ret == 0 || ctx->ret == GLP_EOBJLL || ctx->ret == GLP_EOBJUL))
       {  if (T->parm->msg_lev >= GLP_MSG_ERR)
             xprintf("ios_driver: unable to solve current LP relaxation;"
@@ -829,6 +829,26 @@ static void terminate(struct csa *csa)
       return;
 }
 
+/***********************************************************************
+*  progress - report search progress to the application
+*
+*  This routine passes a snapshot of the current point to the progress
+*  callback specified by the control parameter prog_func. */
+
+static void progress(struct csa *csa)
+{     glp_prog prog;
+      prog.phase = 0;
+      prog.it_cnt = csa->iter;
+      prog.obj = csa->obj;
+      prog.pinf = csa->rpi;
+      prog.dinf = csa->rdi;
+      prog.gap = csa->gap;
+      /* the normal equation system is factorized once per iteration */
+      prog.inv_cnt = csa->iter;
+      csa->parm->prog_func(&prog, csa->parm->prog_info);
+      return;
+}
+
 /***********************************************************************
 *  ipm_main - main interior-point method routine
 *
@@ -840,7 +860,8 @@ static void terminate(struct csa *csa)
 *  1 - problem has no feasible (primal or dual) solution;
 *  2 - no convergence;
 *  3 - iteration limit exceeded;
-*  4 - numeric instability on solving Newtonian system.
+*  4 - numeric instability on solving Newtonian system;
+*  5 - search terminated by application.
 *
 *  In case of non-zero return code the routine returns the best point,
 *  which has been reached during optimization. */
@@ -848,8 +869,8 @@ static void terminate(struct csa *csa)
 static int ipm_main(struct csa *csa)
 {     int m = csa->m;
       int n = csa->n;
-      int i, j, status;
-      double temp;
+      int i, j, status, it_prog = -1;
+      double temp, tm_prog = 0.0;
       /* choose initial point using Mehrotra's heuristic */
       if (csa->parm->msg_lev >= GLP_MSG_ALL)
          xprintf("Guessing initial point...\n");
@@ -879,6 +900,14 @@ static int ipm_main(struct csa *csa)
             xprintf("%3d: obj = %17.9e; rpi = %8.1e; rdi = %8.1e; gap ="
                " %8.1e\n", csa->iter, csa->obj, csa->rpi, csa->rdi,
                csa->gap);
+         /* report search progress to the application */
+         if (csa->parm->prog_func != NULL && (it_prog < 0 ||
+             1000.0 * xdifftime(xtime(), tm_prog) >=
+             csa->parm->prog_frq))
+         {  progress(csa);
+            it_prog = csa->iter;
+            tm_prog = xtime();
+         }
          /* check if the current point is optimal */
          if (csa->rpi < 1e-8 && csa->rdi < 1e-8 && csa->gap < 1e-8)
          {  if (csa->parm->msg_lev >= GLP_MSG_ALL)
@@ -913,6 +942,13 @@ static int ipm_main(struct csa *csa)
             status = 3;
             break;
          }
+         /* check if the search has been terminated by application */
+         if (csa->parm->stop != NULL && *csa->parm->stop)
+         {  if (csa->parm->msg_lev >= GLP_MSG_ALL)
+               xprintf("SEARCH TERMINATED BY APPLICATION\n");
+            status = 5;
+            break;
+         }
          /* start the next iteration */
          csa->iter++;
          /* factorize normal equation system */
@@ -927,6 +963,9 @@ static int ipm_main(struct csa *csa)
             break;
          }
       }
+      /* report the final point to the application */
+      if (csa->parm->prog_func != NULL && it_prog != csa->iter)
+         progress(csa);
       /* restore the best point */
       if (status != 0)
       {  for (j = 1; j <= n; j++) csa->x[j] = csa->best_x[j];
@@ -1018,6 +1057,9 @@ static int ipm_main(struct csa *csa)
 *  GLP_EINSTAB
 *     Numeric instability on solving Newtonian system.
 *
+*  GLP_ESTOP
+*     The search was terminated by application.
+*
 *  In case of non-zero return code the routine returns the best point,
 *  which has been reached during optimization. */
 
@@ -1113,6 +1155,11 @@ int ipm_solve(glp_prob *P, const glp_iptcp *parm)
          P->ipt_stat = GLP_INFEAS;
          ret = GLP_EINSTAB;
       }
+      else if (ret == 5)
+      {  /* search terminated by application */
+         P->ipt_stat = GLP_INFEAS;
+         ret = GLP_ESTOP;
+      }
       else
          xassert(ret != ret);
       /* store row solution components */
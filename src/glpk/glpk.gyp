@@ -8,10 +8,10 @@
       ],
       "conditions": [
 		['OS=="linux"', {
-			"defines": ["HAVE_SYS_TIME_H"]
+			"defines": ["HAVE_SYS_TIME_H", "HAVE_MMAP", "HAVE_PTHREAD"]
 		}],
 		['OS=="mac"', {
-			"defines": ["HAVE_SYS_TIME_H"]
+			"defines": ["HAVE_SYS_TIME_H", "HAVE_MMAP", "HAVE_PTHREAD"]
 		}]
 	  ],
 	  "include_dirs": [
@@ -52,6 +52,7 @@
 		"glpapi19.c",
 		"glpapi20.c",
 		"glpapi21.c",
+		"glpbin.c",
 		"glpcpx.c",
 		"glpdmx.c",
 		"glpgmp.c",
@@ -96,6 +97,8 @@
 		"glpssx01.c",
 		"glpssx02.c",
 		"lux.c",
+		"probmat.c",
+		"strhash.c",
 		"amd/amd_1.c",
 		"amd/amd_2.c",
 		"amd/amd_aat.c",
@@ -134,12 +137,14 @@
 		"misc/bignum.c",
 		"misc/dmp.c",
 		"misc/ffalg.c",
+		"misc/fvs.c",
 		"misc/fp2rat.c",
 		"misc/gcd.c",
 		"misc/jd.c",
 		"misc/keller.c",
 		"misc/mc13d.c",
 		"misc/mc21a.c",
+		"misc/num2str.c",
 		"misc/okalg.c",
 		"misc/qmd.c",
 		"misc/relax4.c",
@@ -160,8 +165,10 @@
 		"simplex/spxchuzr.c",
 		"simplex/spxlp.c",
 		"simplex/spxnt.c",
+		"simplex/spxpar.c",
 		"simplex/spxprim.c",
 		"simplex/spxprob.c",
+		"simplex/spxvec.c",
 
 		"simplex/spychuzc.c",
 		"simplex/spychuzr.c",
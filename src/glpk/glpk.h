@@ -106,6 +106,18 @@ typedef struct
       double foo_bar[38];     /* (reserved) */
 } glp_bfcp;
 
+typedef struct
+{     /* solver progress information */
+      int phase;              /* search phase (simplex only) */
+      int it_cnt;             /* iteration count */
+      double obj;             /* objective value */
+      double pinf;            /* sum of primal infeasibilities */
+      double dinf;            /* sum of dual infeasibilities */
+      double gap;             /* primal-dual gap (interior only) */
+      int inv_cnt;            /* basis factorizations performed */
+      double foo_bar[8];      /* (reserved) */
+} glp_prog;
+
 typedef struct
 {     /* simplex method control parameters */
       int msg_lev;            /* message level: */
@@ -121,9 +133,12 @@ typedef struct
       int pricing;            /* pricing technique: */
 #define GLP_PT_STD      0x11  /* standard (Dantzig's rule) */
 #define GLP_PT_PSE      0x22  /* projected steepest edge */
+#define GLP_PT_PART     0x33  /* partial pricing (primal only) */
+#define GLP_PT_MULT     0x44  /* multiple pricing (primal only) */
       int r_test;             /* ratio test technique: */
 #define GLP_RT_STD      0x11  /* standard (textbook) */
 #define GLP_RT_HAR      0x22  /* Harris' two-pass ratio test */
+#define GLP_RT_FLIP     0x33  /* long-step (flip) ratio test */
       double tol_bnd;         /* spx.tol_bnd */
       double tol_dj;          /* spx.tol_dj */
       double tol_piv;         /* spx.tol_piv */
@@ -134,7 +149,14 @@ typedef struct
       int out_frq;            /* spx.out_frq */
       int out_dly;            /* spx.out_dly (milliseconds) */
       int presolve;           /* enable/disable using LP presolver */
-      double foo_bar[36];     /* (reserved) */
+      const volatile int *stop;
+                              /* if *stop is non-zero, terminate */
+      void (*prog_func)(const glp_prog *prog, void *info);
+                              /* progress callback */
+      void *prog_info;        /* transit pointer passed to prog_func */
+      int prog_frq;           /* progress frequency (milliseconds) */
+      int nthreads;           /* number of threads for PSE pricing */
+      double foo_bar[31];     /* (reserved) */
 } glp_smcp;
 
 typedef struct
@@ -145,7 +167,13 @@ typedef struct
 #define GLP_ORD_QMD        1  /* quotient minimum degree (QMD) */
 #define GLP_ORD_AMD        2  /* approx. minimum degree (AMD) */
 #define GLP_ORD_SYMAMD     3  /* approx. minimum degree (SYMAMD) */
-      double foo_bar[48];     /* (reserved) */
+      const volatile int *stop;
+                              /* if *stop is non-zero, terminate */
+      void (*prog_func)(const glp_prog *prog, void *info);
+                              /* progress callback (see glp_smcp) */
+      void *prog_info;        /* transit pointer passed to prog_func */
+      int prog_frq;           /* progress frequency (milliseconds) */
+      double foo_bar[44];     /* (reserved) */
 } glp_iptcp;
 
 typedef struct glp_tree glp_tree;
@@ -202,7 +230,9 @@ typedef struct
       const char *save_sol;   /* filename to save every new solution */
       int alien;              /* use alien solver */
 #endif
-      double foo_bar[24];     /* (reserved) */
+      const volatile int *stop;
+                              /* if *stop is non-zero, terminate */
+      double foo_bar[23];     /* (reserved) */
 } glp_iocp;
 
 typedef struct
@@ -274,6 +304,11 @@ typedef struct
 #define GLP_MPS_DECK       1  /* fixed (ancient) */
 #define GLP_MPS_FILE       2  /* free (modern) */
 
+/* binary format options: */
+#define GLP_BIN_NAMES   0x01  /* write symbolic names */
+#define GLP_BIN_BASIS   0x02  /* write basis statuses */
+#define GLP_BIN_SCALE   0x04  /* write scale factors */
+
 typedef struct
 {     /* MPS format control parameters */
       int blank;
@@ -282,7 +317,9 @@ typedef struct
       /* objective row name */
       double tol_mps;
       /* zero tolerance for MPS data */
-      double foo_bar[17];
+      int nthreads;
+      /* number of threads parsing COLUMNS section (free MPS format) */
+      double foo_bar[16];
       /* (reserved for use in the future) */
 } glp_mpscp;
 
@@ -379,6 +416,9 @@ int glp_check_dup(int m, int n, int ne, const int ia[], const int ja[]);
 void glp_sort_matrix(glp_prob *P);
 /* sort elements of the constraint matrix */
 
+void glp_compact_matrix(glp_prob *P, int flag);
+/* enable/disable compact storage of the constraint matrix */
+
 void glp_del_rows(glp_prob *P, int nrs, const int num[]);
 /* delete specified rows from problem object */
 
@@ -457,6 +497,9 @@ int glp_find_col(glp_prob *P, const char *name);
 void glp_delete_index(glp_prob *P);
 /* delete the name index */
 
+void glp_keep_index(glp_prob *P, int keep);
+/* make the name index permanent */
+
 void glp_set_rii(glp_prob *P, int i, double rii);
 /* set (change) row scale factor */
 
@@ -793,6 +836,12 @@ int glp_read_prob(glp_prob *P, int flags, const char *fname);
 int glp_write_prob(glp_prob *P, int flags, const char *fname);
 /* write problem data in GLPK format */
 
+int glp_read_bin(glp_prob *P, int flags, const char *fname);
+/* read problem data in binary format */
+
+int glp_write_bin(glp_prob *P, int flags, const char *fname);
+/* write problem data in binary format */
+
 glp_tran *glp_mpl_alloc_wksp(void);
 /* allocate the MathProg translator workspace */
 
@@ -918,6 +967,26 @@ void glp_mem_limit(int limit);
 void glp_mem_usage(int *count, int *cpeak, size_t *total,
       size_t *tpeak);
 /* get memory usage information */
+
+typedef struct glp_buffer glp_buffer;
+/* in-memory file */
+
+glp_buffer *glp_create_buffer(const void *data, size_t size,
+      int gzip);
+/* create in-memory file */
+
+glp_buffer *glp_create_stream(int (*func)(void *info, void *buf,
+      int size), void *info);
+/* create producer-fed in-memory file */
+
+const char *glp_buffer_name(glp_buffer *buf);
+/* file name of in-memory file */
+
+const void *glp_buffer_data(glp_buffer *buf, size_t *size);
+/* content of in-memory file */
+
+void glp_delete_buffer(glp_buffer *buf);
+/* delete in-memory file */
     
 typedef struct glp_graph glp_graph;
 typedef struct glp_vertex glp_vertex;
@@ -25,6 +25,9 @@
 #include "glpenv.h"
 #include "misc.h"
 #include "prob.h"
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
 
 #define xfprintf glp_format
 
@@ -50,6 +53,7 @@ void glp_init_mpscp(glp_mpscp *parm)
 {     parm->blank = '\0';
       parm->obj_name = NULL;
       parm->tol_mps = 1e-12;
+      parm->nthreads = 1;
       return;
 }
 
@@ -65,6 +69,9 @@ static void check_parm(const char *func, const glp_mpscp *parm)
       if (!(0.0 <= parm->tol_mps && parm->tol_mps < 1.0))
          xerror("%s: tol_mps = %g; invalid parameter\n",
             func, parm->tol_mps);
+      if (!(1 <= parm->nthreads && parm->nthreads <= 256))
+         xerror("%s: nthreads = %d; invalid parameter\n",
+            func, parm->nthreads);
       return;
 }
 
@@ -98,11 +105,20 @@ static void check_parm(const char *func, const glp_mpscp *parm)
 *  Note that before reading data the current content of the problem
 *  object is completely erased with the routine glp_erase_prob.
 *
+*  If the control parameter nthreads is greater than one and the file
+*  is in free MPS format, the data records of the COLUMNS section are
+*  loaded into memory in large windows, each window is split at record
+*  boundaries into chunks parsed by separate threads, and the parsed
+*  records are then merged in their original order. The result as well
+*  as error and warning messages are the same as on sequential reading.
+*
 *  RETURNS
 *
 *  If the operation was successful, the routine glp_read_mps returns
 *  zero. Otherwise, it prints an error message and returns non-zero. */
 
+struct task;
+
 struct csa
 {     /* common storage area */
       glp_prob *P;
@@ -135,11 +151,73 @@ struct csa
       /* objective row number */
       void *work1, *work2, *work3;
       /* working arrays */
+      const char *ptr, *end;
+      /* input data already loaded into memory; characters are taken
+         from ptr until it reaches end, then from the stream */
+      char *text;
+      /* window holding text of COLUMNS section */
+      int ntasks;
+      struct task *tasks;
+      /* parallel tasks parsing chunks of the window */
+      struct task *task;
+      /* task this storage area belongs to, or NULL */
+};
+
+struct event
+{     /* column or marker record parsed by parallel task */
+      int type;
+      /* event type: */
+#define EV_COL    1  /* column name in field 2 differs from previous */
+#define EV_KIND   2  /* marker record */
+#define EV_WARN   3  /* warning */
+      int pos;
+      /* number of coefficients parsed before the event */
+      int recno;
+      /* record number relative to the chunk */
+      int data;
+      /* EV_COL: offset of column name in names;
+         EV_KIND: kind of subsequent columns */
+};
+
+struct task
+{     /* parallel task parsing a chunk of COLUMNS section */
+      struct csa csa;
+      /* private copy of common storage area */
+      int nnz, nnz_max;
+      /* number of coefficients parsed and size of the arrays */
+      int *ind, *rec;
+      double *val;
+      /* row numbers, record numbers and values of coefficients */
+      int nev, nev_max;
+      struct event *ev;
+      /* column, marker and warning events */
+      int len, size;
+      char *names;
+      /* column names referred to by EV_COL events */
+      int lines;
+      /* number of records in the chunk */
+      int err;
+      /* number of record where error was detected, 0 if none */
+      char msg[511+1];
+      /* error message */
+      char wmsg[255+1];
+      /* warning message */
+#ifdef HAVE_PTHREAD
+      pthread_t tid;
+#endif
 };
 
 static void error(struct csa *csa, const char *fmt, ...)
 {     /* print error message and terminate processing */
       va_list arg;
+      if (csa->task != NULL)
+      {  /* parallel task; the message is printed on merging */
+         csa->task->err = csa->recno;
+         va_start(arg, fmt);
+         vsprintf(csa->task->msg, fmt, arg);
+         va_end(arg);
+         longjmp(csa->jump, 1);
+      }
       xprintf("%s:%d: ", csa->fname, csa->recno);
       va_start(arg, fmt);
       xvprintf(fmt, arg);
@@ -148,9 +226,21 @@ static void error(struct csa *csa, const char *fmt, ...)
       /* no return */
 }
 
+static void add_event(struct csa *csa, int type, int data);
+
 static void warning(struct csa *csa, const char *fmt, ...)
 {     /* print warning message and continue processing */
       va_list arg;
+      if (csa->task != NULL)
+      {  /* parallel task; in free MPS format the only warning possible
+            in data records of COLUMNS section is the one about extra
+            fields, which is issued once */
+         va_start(arg, fmt);
+         vsprintf(csa->task->wmsg, fmt, arg);
+         va_end(arg);
+         add_event(csa, EV_WARN, 0);
+         return;
+      }
       xprintf("%s:%d: warning: ", csa->fname, csa->recno);
       va_start(arg, fmt);
       xvprintf(fmt, arg);
@@ -164,7 +254,15 @@ static void read_char(struct csa *csa)
       if (csa->c == '\n')
          csa->recno++, csa->recpos = 0;
       csa->recpos++;
-read: c = glp_getc(csa->fp);
+read: if (csa->ptr != csa->end)
+         c = (unsigned char)*csa->ptr++;
+      else if (csa->task != NULL)
+      {  /* chunks consist of complete records */
+         xassert(csa->c == '\n');
+         longjmp(csa->jump, 2);
+      }
+      else
+         c = glp_getc(csa->fp);
       if (c < 0)
       {  if (glp_ioerr(csa->fp))
             error(csa, "read error - %s\n", get_err_msg());
@@ -445,18 +543,394 @@ loop: if (indicator(csa, 0)) goto done;
 done: return;
 }
 
+struct col
+{     /* column being read from COLUMNS section */
+      int j;
+      /* ordinal number of the column, 0 if none */
+      int len;
+      /* number of its coefficients stored in ind and val */
+      int kind;
+      /* kind of subsequent columns */
+      int *ind; /* int ind[1+m]; */
+      double *val; /* double val[1+m]; */
+      char *flag; /* char flag[1+m]; */
+      /* flag[i] means that row i has a coefficient in the column */
+};
+
+static void set_column(struct csa *csa, struct col *col,
+      const char *name)
+{     /* process column name specified in field 2 */
+      if (name[0] == '\0')
+      {  /* the same column as in previous data record */
+         if (col->j == 0)
+            error(csa, "missing column name in field 2\n");
+      }
+      else if (col->j != 0 && strcmp(name, csa->P->col[col->j]->name)
+         == 0)
+      {  /* the same column as in previous data record */
+         xassert(col->j != 0);
+      }
+      else
+      {  /* store the current column */
+         if (col->j != 0)
+         {  glp_set_mat_col(csa->P, col->j, col->len, col->ind,
+               col->val);
+            while (col->len > 0) col->flag[col->ind[col->len--]] = 0;
+         }
+         /* create new column */
+         if (glp_find_col(csa->P, name) != 0)
+            error(csa, "column '%s' multiply specified\n", name);
+         col->j = glp_add_cols(csa->P, 1);
+         glp_set_col_name(csa->P, col->j, name);
+         glp_set_col_kind(csa->P, col->j, col->kind);
+         if (col->kind == GLP_CV)
+            glp_set_col_bnds(csa->P, col->j, GLP_LO, 0.0, 0.0);
+         else if (col->kind == GLP_IV)
+            glp_set_col_bnds(csa->P, col->j, GLP_DB, 0.0, 1.0);
+         else
+            xassert(col != col);
+      }
+      return;
+}
+
+static void check_dup(struct csa *csa, struct col *col, int i)
+{     /* check that row i has no coefficient in the column yet */
+      if (col->flag[i])
+         error(csa, "duplicate coefficient in row '%s'\n",
+            csa->P->row[i]->name);
+      return;
+}
+
+static void *grow(struct csa *csa, void *ptr, int nmax, int size)
+{     /* reallocate working array of parallel task */
+      /* the environment belongs to the thread that called glp_read_mps,
+         so parallel tasks use malloc instead of glp_alloc */
+      ptr = realloc(ptr, (size_t)nmax * size);
+      if (ptr == NULL)
+         error(csa, "out of memory\n");
+      return ptr;
+}
+
+static void add_event(struct csa *csa, int type, int data)
+{     /* record event in parallel task */
+      struct task *task = csa->task;
+      struct event *ev;
+      if (task->nev == task->nev_max)
+      {  int nmax = task->nev_max;
+         nmax = (nmax == 0 ? 256 : nmax + nmax);
+         task->ev = grow(csa, task->ev, nmax, sizeof(struct event));
+         task->nev_max = nmax;
+      }
+      ev = &task->ev[task->nev++];
+      ev->type = type;
+      ev->pos = task->nnz;
+      ev->recno = csa->recno;
+      ev->data = data;
+      return;
+}
+
+static int add_name(struct csa *csa, const char *name)
+{     /* store column name in parallel task */
+      struct task *task = csa->task;
+      int len = strlen(name) + 1, pos = task->len;
+      if (task->len + len > task->size)
+      {  int nmax = (task->size == 0 ? 4096 : task->size + task->size);
+         task->names = grow(csa, task->names, nmax, 1);
+         task->size = nmax;
+      }
+      memcpy(task->names + pos, name, len);
+      task->len += len;
+      return pos;
+}
+
+static int add_coef(struct csa *csa, int i)
+{     /* record coefficient in parallel task; the caller stores its
+         value when it has been read */
+      struct task *task = csa->task;
+      int k = task->nnz;
+      if (k == task->nnz_max)
+      {  int nmax = (k == 0 ? 4096 : k + k);
+         task->ind = grow(csa, task->ind, nmax, sizeof(int));
+         task->rec = grow(csa, task->rec, nmax, sizeof(int));
+         task->val = grow(csa, task->val, nmax, sizeof(double));
+         task->nnz_max = nmax;
+      }
+      task->ind[k] = i;
+      task->rec[k] = csa->recno;
+      task->val[k] = 0.0;
+      task->nnz++;
+      return k;
+}
+
+static void scan_columns(struct csa *csa)
+{     /* parse data records of COLUMNS section (parallel task) */
+      struct task *task = csa->task;
+      int i, f, k, kind;
+      double aij;
+      char name[255+1], prev[255+1];
+      prev[0] = '\0';
+loop: if (indicator(csa, 0))
+         xassert(csa != csa);
+      /* field 1 must be blank */
+      csa->fldno++;
+      /* field 2: column or kind name */
+      read_field(csa), patch_name(csa, csa->field);
+      strcpy(name, csa->field);
+      /* field 3: row name or keyword 'MARKER' */
+      read_field(csa), patch_name(csa, csa->field);
+      if (strcmp(csa->field, "'MARKER'") == 0)
+      {  /* process kind data record */
+         /* field 4 must be blank */
+         csa->fldno++;
+         /* field 5: keyword 'INTORG' or 'INTEND' */
+         read_field(csa), patch_name(csa, csa->field);
+         if (strcmp(csa->field, "'INTORG'") == 0)
+            kind = GLP_IV;
+         else if (strcmp(csa->field, "'INTEND'") == 0)
+            kind = GLP_CV;
+         else if (csa->field[0] == '\0')
+            error(csa, "missing keyword in field 5\n");
+         else
+            error(csa, "invalid keyword in field 5\n");
+         add_event(csa, EV_KIND, kind);
+         /* field 6 must be blank */
+         skip_field(csa);
+         goto loop;
+      }
+      /* column name is resolved on merging, because the current column
+         may come from the preceding chunk */
+      if (name[0] == '\0' ? prev[0] == '\0' : strcmp(name, prev) != 0)
+      {  add_event(csa, EV_COL, add_name(csa, name));
+         strcpy(prev, name);
+      }
+      /* process fields 3-4 and 5-6 */
+      for (f = 3; f <= 5; f += 2)
+      {  /* field 3 or 5: row name */
+         if (f == 3)
+         {  if (csa->field[0] == '\0')
+               error(csa, "missing row name in field 3\n");
+         }
+         else
+         {  read_field(csa), patch_name(csa, csa->field);
+            if (csa->field[0] == '\0')
+            {  /* if field 5 is blank, field 6 also must be blank */
+               skip_field(csa);
+               continue;
+            }
+         }
+         i = glp_find_row(csa->P, csa->field);
+         if (i == 0)
+            error(csa, "row '%s' not found\n", csa->field);
+         /* the coefficient is recorded before its value is read, so
+            a duplicate is reported before an error in field 4 or 6 as
+            on sequential reading */
+         k = add_coef(csa, i);
+         /* field 4 or 6: coefficient value */
+         aij = read_number(csa);
+         if (fabs(aij) < csa->parm->tol_mps) aij = 0.0;
+         task->val[k] = aij;
+      }
+      goto loop;
+}
+
+static void *run_task(void *arg)
+{     /* parse chunk of COLUMNS section */
+      struct task *task = arg;
+      struct csa *csa = &task->csa;
+      switch (setjmp(csa->jump))
+      {  case 0:
+            scan_columns(csa);
+            /* no return */
+         case 1:
+            /* error message has been saved */
+            break;
+         case 2:
+            /* end of chunk has been reached */
+            task->lines = csa->recno - 1;
+            break;
+         default:
+            xassert(csa != csa);
+      }
+      return NULL;
+}
+
+static void free_tasks(struct csa *csa)
+{     /* free parallel tasks */
+      int t;
+      for (t = 0; t < csa->ntasks; t++)
+      {  struct task *task = &csa->tasks[t];
+         free(task->ind);
+         free(task->rec);
+         free(task->val);
+         free(task->ev);
+         free(task->names);
+      }
+      xfree(csa->tasks);
+      csa->ntasks = 0;
+      csa->tasks = NULL;
+      return;
+}
+
+static void merge_task(struct csa *csa, struct col *col,
+      struct task *task)
+{     /* process records parsed by parallel task in original order */
+      struct event *ev;
+      int i, k, e, base = csa->recno;
+      for (k = 0, e = 0; ; k++)
+      {  for (; e < task->nev && task->ev[e].pos == k; e++)
+         {  ev = &task->ev[e];
+            csa->recno = base + ev->recno;
+            if (ev->type == EV_COL)
+               set_column(csa, col, task->names + ev->data);
+            else if (ev->type == EV_KIND)
+               col->kind = ev->data;
+            else if (ev->type == EV_WARN)
+            {  if (csa->wef < 1)
+               {  warning(csa, "%s", task->wmsg);
+                  csa->wef++;
+               }
+            }
+            else
+               xassert(ev != ev);
+         }
+         if (k == task->nnz) break;
+         i = task->ind[k];
+         csa->recno = base + task->rec[k];
+         check_dup(csa, col, i);
+         col->len++;
+         col->ind[col->len] = i, col->val[col->len] = task->val[k];
+         col->flag[i] = 1;
+      }
+      if (task->err != 0)
+      {  csa->recno = base + task->err;
+         error(csa, "%s", task->msg);
+      }
+      csa->recno = base + task->lines;
+      return;
+}
+
+#define CHUNK_SIZE (4 << 20)
+/* size of window per thread, in bytes */
+
+static void read_par(struct csa *csa, struct col *col)
+{     /* read data records of COLUMNS section in parallel */
+      int ntasks, nt, size, have, scan, cut, eos, eof, beg, t, c;
+      char *text, *ptr;
+      ntasks = csa->parm->nthreads;
+      if (ntasks > 64) ntasks = 64;
+      size = ntasks * CHUNK_SIZE;
+      csa->text = text = xalloc(size, sizeof(char));
+      csa->tasks = xcalloc(ntasks, sizeof(struct task));
+      memset(csa->tasks, 0, ntasks * sizeof(struct task));
+      csa->ntasks = ntasks;
+      have = scan = eof = 0;
+      for (;;)
+      {  /* fill the window */
+         while (!eof && have < size)
+         {  int nrd = glp_read(csa->fp, text + have, size - have);
+            if (nrd > 0)
+               have += nrd;
+            else
+               eof = 1;
+         }
+         /* look for indicator record ending the section; records
+            are scanned from the beginning of a record */
+         eos = -1;
+         while (scan < have)
+         {  c = (unsigned char)text[scan];
+            if (!(c == '*' || isspace(c) || iscntrl(c)))
+            {  eos = scan;
+               break;
+            }
+            ptr = memchr(text + scan, '\n', have - scan);
+            if (ptr == NULL) break;
+            scan = (int)(ptr - text) + 1;
+         }
+         cut = (eos >= 0 ? eos : scan);
+         if (eos < 0 && (eof || cut == 0))
+         {  /* end of file or read error within the section or a record
+               longer than the window; the rest is read sequentially
+               to get the same diagnostics */
+            csa->ptr = text, csa->end = text + have;
+            break;
+         }
+         /* split complete records preceding cut into chunks, no more
+            than one per 64K */
+         nt = cut / 65536 + 1;
+         if (nt > ntasks) nt = ntasks;
+         for (t = 0, beg = 0; t < nt; t++)
+         {  struct task *task = &csa->tasks[t];
+            int end = (int)((double)cut * (double)(t+1) / (double)nt);
+            if (end <= beg)
+               end = beg;
+            else if (end < cut)
+            {  ptr = memchr(text + end - 1, '\n', cut - end + 1);
+               xassert(ptr != NULL);
+               end = (int)(ptr - text) + 1;
+            }
+            task->csa = *csa;
+            task->csa.task = task;
+            task->csa.fp = NULL;
+            task->csa.ptr = text + beg, task->csa.end = text + end;
+            task->csa.recno = 0;
+            task->csa.c = '\n';
+            task->csa.wef = 0;
+            task->nnz = task->nev = task->len = 0;
+            task->lines = task->err = 0;
+            beg = end;
+         }
+         /* run the tasks */
+#ifdef HAVE_PTHREAD
+         for (t = 1; t < nt; t++)
+         {  struct task *task = &csa->tasks[t];
+            if (pthread_create(&task->tid, NULL, run_task, task) != 0)
+               task->tid = pthread_self();
+         }
+         run_task(&csa->tasks[0]);
+         for (t = 1; t < nt; t++)
+         {  struct task *task = &csa->tasks[t];
+            if (pthread_equal(task->tid, pthread_self()))
+               run_task(task);
+            else
+               pthread_join(task->tid, NULL);
+         }
+#else
+         for (t = 0; t < nt; t++)
+            run_task(&csa->tasks[t]);
+#endif
+         /* merge parsed records */
+         for (t = 0; t < nt; t++)
+            merge_task(csa, col, &csa->tasks[t]);
+         if (eos >= 0)
+         {  /* the indicator record and data following it are read
+               from the window */
+            csa->ptr = text + eos, csa->end = text + have;
+            break;
+         }
+         /* keep incomplete record for the next window */
+         memmove(text, text + cut, have - cut);
+         have -= cut, scan -= cut;
+      }
+      free_tasks(csa);
+      return;
+}
+
 static void read_columns(struct csa *csa)
 {     /* read COLUMNS section */
-      int i, j, f, len, kind = GLP_CV, *ind;
-      double aij, *val;
-      char name[255+1], *flag;
+      struct col _col, *col = &_col;
+      int i, f;
+      double aij;
+      char name[255+1];
       /* allocate working arrays */
-      csa->work1 = ind = xcalloc(1+csa->P->m, sizeof(int));
-      csa->work2 = val = xcalloc(1+csa->P->m, sizeof(double));
-      csa->work3 = flag = xcalloc(1+csa->P->m, sizeof(char));
-      memset(&flag[1], 0, csa->P->m);
+      csa->work1 = col->ind = xcalloc(1+csa->P->m, sizeof(int));
+      csa->work2 = col->val = xcalloc(1+csa->P->m, sizeof(double));
+      csa->work3 = col->flag = xcalloc(1+csa->P->m, sizeof(char));
+      memset(&col->flag[1], 0, csa->P->m);
       /* no current column exists */
-      j = 0, len = 0;
+      col->j = 0, col->len = 0, col->kind = GLP_CV;
+      /* parse data records in parallel, if allowed */
+      if (!csa->deck && csa->parm->nthreads > 1)
+         read_par(csa, col);
 loop: if (indicator(csa, 0)) goto done;
       /* field 1 must be blank */
       if (csa->deck)
@@ -484,9 +958,9 @@ loop: if (indicator(csa, 0)) goto done;
          /* field 5: keyword 'INTORG' or 'INTEND' */
          read_field(csa), patch_name(csa, csa->field);
          if (strcmp(csa->field, "'INTORG'") == 0)
-            kind = GLP_IV;
+            col->kind = GLP_IV;
          else if (strcmp(csa->field, "'INTEND'") == 0)
-            kind = GLP_CV;
+            col->kind = GLP_CV;
          else if (csa->field[0] == '\0')
             error(csa, "missing keyword in field 5\n");
          else
@@ -496,34 +970,7 @@ loop: if (indicator(csa, 0)) goto done;
          goto loop;
       }
       /* process column name specified in field 2 */
-      if (name[0] == '\0')
-      {  /* the same column as in previous data record */
-         if (j == 0)
-            error(csa, "missing column name in field 2\n");
-      }
-      else if (j != 0 && strcmp(name, csa->P->col[j]->name) == 0)
-      {  /* the same column as in previous data record */
-         xassert(j != 0);
-      }
-      else
-      {  /* store the current column */
-         if (j != 0)
-         {  glp_set_mat_col(csa->P, j, len, ind, val);
-            while (len > 0) flag[ind[len--]] = 0;
-         }
-         /* create new column */
-         if (glp_find_col(csa->P, name) != 0)
-            error(csa, "column '%s' multiply specified\n", name);
-         j = glp_add_cols(csa->P, 1);
-         glp_set_col_name(csa->P, j, name);
-         glp_set_col_kind(csa->P, j, kind);
-         if (kind == GLP_CV)
-            glp_set_col_bnds(csa->P, j, GLP_LO, 0.0, 0.0);
-         else if (kind == GLP_IV)
-            glp_set_col_bnds(csa->P, j, GLP_DB, 0.0, 1.0);
-         else
-            xassert(kind != kind);
-      }
+      set_column(csa, col, name);
       /* process fields 3-4 and 5-6 */
       for (f = 3; f <= 5; f += 2)
       {  /* field 3 or 5: row name */
@@ -542,22 +989,22 @@ loop: if (indicator(csa, 0)) goto done;
          i = glp_find_row(csa->P, csa->field);
          if (i == 0)
             error(csa, "row '%s' not found\n", csa->field);
-         if (flag[i])
-            error(csa, "duplicate coefficient in row '%s'\n",
-               csa->field);
+         check_dup(csa, col, i);
          /* field 4 or 6: coefficient value */
          aij = read_number(csa);
          if (fabs(aij) < csa->parm->tol_mps) aij = 0.0;
-         len++, ind[len] = i, val[len] = aij, flag[i] = 1;
+         col->len++;
+         col->ind[col->len] = i, col->val[col->len] = aij;
+         col->flag[i] = 1;
       }
       goto loop;
 done: /* store the last column */
-      if (j != 0)
-         glp_set_mat_col(csa->P, j, len, ind, val);
+      if (col->j != 0)
+         glp_set_mat_col(csa->P, col->j, col->len, col->ind, col->val);
       /* free working arrays */
-      xfree(ind);
-      xfree(val);
-      xfree(flag);
+      xfree(col->ind);
+      xfree(col->val);
+      xfree(col->flag);
       csa->work1 = csa->work2 = csa->work3 = NULL;
       return;
 }
@@ -911,6 +1358,11 @@ int glp_read_mps(glp_prob *P, int fmt, const glp_mpscp *parm,
       csa->w80 = csa->wef = 0;
       csa->obj_row = 0;
       csa->work1 = csa->work2 = csa->work3 = NULL;
+      csa->ptr = csa->end = NULL;
+      csa->text = NULL;
+      csa->ntasks = 0;
+      csa->tasks = NULL;
+      csa->task = NULL;
       /* erase problem object */
       glp_erase_prob(P);
       glp_create_index(P);
@@ -1030,13 +1482,16 @@ int glp_read_mps(glp_prob *P, int fmt, const glp_mpscp *parm,
       }
 #endif
       /* problem data has been successfully read */
-      glp_delete_index(P);
+      if (!P->keep_index)
+         glp_delete_index(P);
       glp_sort_matrix(P);
       ret = 0;
 done: if (csa->fp != NULL) glp_close(csa->fp);
       if (csa->work1 != NULL) xfree(csa->work1);
       if (csa->work2 != NULL) xfree(csa->work2);
       if (csa->work3 != NULL) xfree(csa->work3);
+      if (csa->text != NULL) xfree(csa->text);
+      if (csa->tasks != NULL) free_tasks(csa);
       if (ret != 0) glp_erase_prob(P);
       return ret;
 }
@@ -1141,7 +1596,11 @@ static char *mps_numb(struct csa *csa, double val)
       {  if (val != 0.0 && fabs(val) < 0.002)
             sprintf(csa->field, "%.*E", dig-1, val);
          else
-            sprintf(csa->field, "%.*G", dig, val);
+         {  /* %G is the same as %g except for the exponent letter */
+            num2str(csa->field, dig, val);
+            exp = strchr(csa->field, 'e');
+            if (exp != NULL) *exp = 'E';
+         }
          exp = strchr(csa->field, 'E');
          if (exp != NULL)
             sprintf(exp+1, "%d", atoi(exp+1));
@@ -1166,6 +1625,7 @@ int glp_write_mps(glp_prob *P, int fmt, const glp_mpscp *parm,
          glp_init_mpscp(&_parm), parm = &_parm;
       /* check control parameters */
       check_parm("glp_write_mps", parm);
+      prob_lists(P);
       /* initialize common storage area */
       csa->P = P;
       csa->deck = (fmt == GLP_MPS_DECK);
@@ -357,8 +357,9 @@ void npp_load_prob(NPP *npp, glp_prob *orig, int names, int sol,
 {     /* load original problem into the preprocessor workspace */
       int m = orig->m;
       int n = orig->n;
+      GLPCSM *csc = prob_csc(orig, 1);
       NPPROW **link;
-      int i, j;
+      int i, j, t;
       double dir;
       xassert(names == GLP_OFF || names == GLP_ON);
       xassert(sol == GLP_SOL || sol == GLP_IPT || sol == GLP_MIP);
@@ -455,8 +456,15 @@ void npp_load_prob(NPP *npp, glp_prob *orig, int names, int sol,
             else
                xassert(ccc != ccc);
             col->coef = dir * ccc->coef;
-            for (aaa = ccc->ptr; aaa != NULL; aaa = aaa->c_next)
-               npp_add_aij(npp, link[aaa->row->i], col, aaa->val);
+            if (csc != NULL)
+            {  for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+                  npp_add_aij(npp, link[csc->ind[t]], col,
+                     csc->val[t]);
+            }
+            else
+            {  for (aaa = ccc->ptr; aaa != NULL; aaa = aaa->c_next)
+                  npp_add_aij(npp, link[aaa->row->i], col, aaa->val);
+            }
          }
          else
          {  double sjj = ccc->sjj;
@@ -473,9 +481,18 @@ void npp_load_prob(NPP *npp, glp_prob *orig, int names, int sol,
             else
                xassert(ccc != ccc);
             col->coef = dir * ccc->coef * sjj;
-            for (aaa = ccc->ptr; aaa != NULL; aaa = aaa->c_next)
-               npp_add_aij(npp, link[aaa->row->i], col,
-                  aaa->row->rii * aaa->val * sjj);
+            if (csc != NULL)
+            {  for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+               {  i = csc->ind[t];
+                  npp_add_aij(npp, link[i], col,
+                     orig->row[i]->rii * csc->val[t] * sjj);
+               }
+            }
+            else
+            {  for (aaa = ccc->ptr; aaa != NULL; aaa = aaa->c_next)
+                  npp_add_aij(npp, link[aaa->row->i], col,
+                     aaa->row->rii * aaa->val * sjj);
+            }
          }
       }
       xfree(link);
@@ -705,6 +722,10 @@ void npp_unload_sol(NPP *npp, glp_prob *orig)
       GLPCOL *col;
       int i, j;
       double dir;
+      /* row activities and reduced costs are computed below from the
+       * linked lists, which a copied problem object may not have built
+       * yet (see glp_copy_prob) */
+      prob_lists(orig);
       xassert(npp->orig_dir == orig->dir);
       if (npp->orig_dir == GLP_MIN)
          dir = +1.0;
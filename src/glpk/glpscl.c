@@ -471,6 +471,7 @@ void glp_scale_prob(glp_prob *lp, int flags)
             "s\n", flags);
       if (flags & GLP_SF_AUTO)
          flags = (GLP_SF_GM | GLP_SF_EQ | GLP_SF_SKIP);
+      prob_lists(lp);
       scale_prob(lp, flags);
       return;
 }
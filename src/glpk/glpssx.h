@@ -319,6 +319,9 @@ struct SSX
          performed by the amount of time spent for the iteration, and
          reaching zero value signals the solver to stop the search;
          negative value means no time limit */
+      const volatile int *stop;
+      /* if this pointer is not NULL and the flag it points to becomes
+         non-zero, the solver stops the search */
       double out_frq;
       /* output frequency, in seconds; this parameter specifies how
          frequently the solver sends information about the progress of
@@ -32,6 +32,13 @@ int str2int(const char *str, int *val);
 int str2num(const char *str, double *val);
 /* convert character string to value of double type */
 
+#define NUM2STR_LEN 32
+/* room enough for any result of num2str */
+
+#define num2str _glp_num2str
+char *num2str(char *str, int prec, double val);
+/* convert value of double type to character string */
+
 #define strspx _glp_strspx
 char *strspx(char *str);
 /* remove all spaces from character string */
@@ -0,0 +1,121 @@
+/* num2str.c (convert double to string) */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "misc.h"
+#include "stdc.h"
+
+/***********************************************************************
+*  NAME
+*
+*  num2str - convert value of double type to character string
+*
+*  SYNOPSIS
+*
+*  #include "misc.h"
+*  char *num2str(char *str, int prec, double val);
+*
+*  DESCRIPTION
+*
+*  The routine num2str converts the value val to a character string
+*  and stores it to the location, which the parameter str points to.
+*  The result is exactly the same as the one of
+*
+*     sprintf(str, "%.*g", prec, val);
+*
+*  where 1 <= prec <= DBL_DIG. The location must have room for at least
+*  NUM2STR_LEN characters.
+*
+*  Most numbers in model data and solutions have a short decimal form.
+*  The routine rounds val to prec significant digits in floating-point
+*  arithmetic. If the decimal fraction obtained converts back to val,
+*  its distance to val is less than half the spacing of prec-digit
+*  decimals, so it is the correctly rounded result and its digits are
+*  written out directly. Otherwise, or if %g would use exponent style,
+*  the routine falls back to sprintf. (Defining the macro NUM_NO_FAST
+*  makes it always use sprintf.)
+*
+*  RETURNS
+*
+*  The routine returns str. */
+
+char *num2str(char *str, int prec, double val)
+{     /* since 1e-4 <= |val| < 10^prec, at most prec+4 fractional
+         digits are needed */
+      static const double p10[1+DBL_DIG+4] =
+      {  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+      };
+      double a = fabs(val), y;
+      int k, len;
+      char buf[DBL_DIG+1], *s;
+#if !(defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || \
+    defined(NUM_NO_FAST)
+      /* extended precision intermediates would round twice */
+      goto slow;
+#endif
+      if (val == 0.0)
+      {  /* %g keeps the sign of negative zero */
+         strcpy(str, 1.0 / val < 0.0 ? "-0" : "0");
+         return str;
+      }
+      /* %g uses exponent style if the decimal exponent is less than -4
+         or not less than prec; infinity and NaN are also left to
+         sprintf */
+      if (!(1 <= prec && prec <= DBL_DIG && 1e-4 <= a && a < p10[prec]))
+         goto slow;
+      /* round a to prec significant digits, i.e. to k fractional
+         digits, where k is the largest number, for which
+         a * 10^k < 10^prec */
+      for (k = 0; k < prec+4 && a * p10[k+1] < p10[prec]; k++)
+         /* nop */;
+      y = floor(a * p10[k] + 0.5);
+      if (!(y < p10[prec] && y / p10[k] == a))
+         goto slow;
+      /* trailing zeros of the fractional part are not written */
+      for (; k > 0 && y == 10.0 * floor(y / 10.0); k--)
+         y /= 10.0;
+      /* digits of y in reverse order */
+      len = 0;
+      do
+      {  double q = floor(y / 10.0);
+         buf[len++] = (char)('0' + (int)(y - 10.0 * q));
+         y = q;
+      } while (y != 0.0);
+      s = str;
+      if (val < 0.0)
+         *s++ = '-';
+      if (len <= k)
+      {  /* no integer part */
+         *s++ = '0', *s++ = '.';
+         for (; k > len; k--)
+            *s++ = '0';
+         k = 0;
+      }
+      while (len > 0)
+      {  if (len == k)
+            *s++ = '.';
+         *s++ = buf[--len];
+      }
+      *s = '\0';
+      return str;
+slow: sprintf(str, "%.*g", prec, val);
+      return str;
+}
+
+/* eof */
@@ -41,6 +41,10 @@
 *  val points to (in the case of error content of this location is not
 *  changed).
 *
+*  Numbers having a short decimal representation are converted without
+*  calling strtod unless the macro NUM_NO_FAST is defined; the result
+*  is the same in either case.
+*
 *  RETURNS
 *
 *  The routine returns one of the following error codes:
@@ -49,6 +53,68 @@
 *  1 - value out of range;
 *  2 - character string is syntactically incorrect. */
 
+static int fast_conv(const char *str, double *val_)
+{     /* convert number having short decimal representation */
+      /* if the decimal significand m is an integer exactly
+         representable as double, m * 10^e and m / 10^e for 0 <= e <= 22
+         are computed with a single correctly rounded operation, so the
+         result is the same as the one of strtod (Clinger's fast path) */
+      static const double p10[1+22] =
+      {  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+         1e22
+      };
+      const double two53 = 9007199254740992.0;
+      double m = 0.0;
+      int k = 0, neg = 0, e = 0, x = 0, xneg = 0;
+#if !(defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || \
+    defined(NUM_NO_FAST)
+      /* extended precision intermediates would round twice */
+      return 0;
+#endif
+      if (str[k] == '+' || str[k] == '-')
+         neg = (str[k++] == '-');
+      /* significand; the string has already been validated */
+      for (; isdigit((unsigned char)str[k]); k++)
+      {  if (m >= 900719925474099.0) return 0;
+         m = 10.0 * m + (double)(str[k] - '0');
+      }
+      if (str[k] == '.')
+      {  for (k++; isdigit((unsigned char)str[k]); k++)
+         {  if (m >= 900719925474099.0) return 0;
+            m = 10.0 * m + (double)(str[k] - '0');
+            e--;
+         }
+      }
+      /* decimal exponent */
+      if (str[k] == 'E' || str[k] == 'e')
+      {  k++;
+         if (str[k] == '+' || str[k] == '-')
+            xneg = (str[k++] == '-');
+         for (; isdigit((unsigned char)str[k]); k++)
+         {  if (x >= 1000) return 0;
+            x = 10 * x + (str[k] - '0');
+         }
+      }
+      e += (xneg ? -x : x);
+      /* perform conversion */
+      if (m == 0.0 || e == 0)
+         ;
+      else if (-22 <= e && e < 0)
+         m /= p10[-e];
+      else if (0 < e && e <= 22)
+         m *= p10[e];
+      else if (22 < e && e <= 22+15 && m * p10[e-22] < two53)
+      {  /* m * 10^(e-22) is still an exact integer */
+         m *= p10[e-22];
+         m *= p10[22];
+      }
+      else
+         return 0;
+      *val_ = (neg ? -m : m);
+      return 1;
+}
+
 int str2num(const char *str, double *val_)
 {     int k;
       double val;
@@ -91,6 +157,7 @@ frac: /* scan optional fraction part */
       if (str[k] != '\0')
          return 2;
       /* perform conversion */
+      if (!fast_conv(str, &val))
       {  char *endptr;
          val = strtod(str, &endptr);
          if (*endptr != '\0')
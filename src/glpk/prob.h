@@ -29,10 +29,13 @@
 #include "bfd.h"
 #include "dmp.h"
 #include "glpk.h"
+#include "strhash.h"
 
 typedef struct GLPROW GLPROW;
 typedef struct GLPCOL GLPCOL;
 typedef struct GLPAIJ GLPAIJ;
+typedef struct GLPCSM GLPCSM;
+typedef struct GLPWLP GLPWLP;
 
 #define GLP_PROB_MAGIC 0xD7D9D6C2
 
@@ -77,12 +80,40 @@ struct glp_prob
       /* row[i], 1 <= i <= m, is a pointer to i-th row */
       GLPCOL **col; /* GLPCOL *col[1+n_max]; */
       /* col[j], 1 <= j <= n, is a pointer to j-th column */
-      AVL *r_tree;
+      STRHASH *r_index;
       /* row index to find rows by their names; NULL means this index
          does not exist */
-      AVL *c_tree;
+      STRHASH *c_index;
       /* column index to find columns by their names; NULL means this
          index does not exist */
+      int keep_index;
+      /* if this flag is set, the name index is permanent, i.e. it is
+         kept on erasing the problem object (so the problem readers
+         maintain it) until glp_delete_index is called */
+      int compact;
+      /* if this flag is set, compact copies of the constraint matrix
+         are built on demand (see glp_compact_matrix); the flag is kept
+         on erasing the problem object */
+      GLPCSM *csc;
+      /* column-wise copy of the constraint matrix; NULL means that the
+         copy does not exist or is out of date */
+      GLPCSM *csr;
+      /* row-wise copy of the constraint matrix; NULL means that the
+         copy does not exist or is out of date */
+      int csc_req, csr_req;
+      /* number of single column (row) requests made since the matrix
+         was changed, while the column-wise (row-wise) copy does not
+         exist */
+      int nolist;
+      /* if this flag is set, the linked lists of constraint
+         coefficients have not been built yet, and the matrix is stored
+         only in the copies csc and csr, which are shared with the
+         problem object it was copied from (see glp_copy_prob); the
+         lists are built by prob_lists on first use */
+      GLPWLP *wlp;
+      /* constraint matrix of the working LP kept by the simplex solvers
+         in the compact mode; NULL means that it does not exist or is
+         out of date */
       /*--------------------------------------------------------------*/
       /* basis factorization (LP) */
       int valid;
@@ -149,10 +180,6 @@ struct GLPROW
       char *name;
       /* row name (1 to 255 chars); NULL means no name is assigned to
          this row */
-      AVLNODE *node;
-      /* pointer to corresponding node in the row index; NULL means
-         that either the row index does not exist or this row has no
-         name assigned */
 #if 1 /* 20/IX-2008 */
       int level;
       unsigned char origin;
@@ -206,10 +233,6 @@ struct GLPCOL
       char *name;
       /* column name (1 to 255 chars); NULL means no name is assigned
          to this column */
-      AVLNODE *node;
-      /* pointer to corresponding node in the column index; NULL means
-         that either the column index does not exist or the column has
-         no name assigned */
       int kind;
       /* kind of the structural variable:
          GLP_CV - continuous variable
@@ -275,6 +298,65 @@ struct GLPAIJ
       /* pointer to next coefficient in the same column */
 };
 
+struct GLPCSM
+{     /* compact (compressed sparse) copy of the constraint matrix; the
+         elements of k-th column (row) are stored in locations ptr[k],
+         ..., ptr[k+1]-1 of the arrays ind and val in the same order as
+         in the linked list of the column (row) */
+      int len;
+      /* number of columns (rows) */
+      int *ptr; /* int ptr[1+len+1]; */
+      /* starting positions of the columns (rows) */
+      int *ind; /* int ind[1+nnz]; */
+      /* row (column) indices of the elements */
+      double *val; /* double val[1+nnz]; */
+      /* numeric values of the elements (non-scaled) */
+      int ref;
+      /* number of problem objects sharing this copy; the copy is freed
+         when the last of them releases it */
+};
+
+struct GLPWLP
+{     /* constraint matrix of the working LP (see simplex/spxprob.c),
+         which the simplex solvers keep in the problem object between
+         their calls, so re-solving the problem after changing bounds
+         or objective coefficients does not build it again */
+      int excl;
+      /* flag excl used to build the working LP */
+      char *incl; /* char incl[1+m+n]; */
+      /* incl[k] is set if k-th original variable (auxiliary or
+         structural) is included in the working LP */
+      GLPCSM *A;
+      /* scaled matrix A of the working LP */
+      GLPCSM *AT;
+      /* the same matrix in row-wise format; NULL means that it has not
+         been built */
+};
+
+#define prob_csc _glp_prob_csc
+GLPCSM *prob_csc(glp_prob *P, int bulk);
+/* get column-wise copy of the constraint matrix */
+
+#define prob_csr _glp_prob_csr
+GLPCSM *prob_csr(glp_prob *P, int bulk);
+/* get row-wise copy of the constraint matrix */
+
+#define prob_share_mat _glp_prob_share_mat
+void prob_share_mat(glp_prob *dest, glp_prob *prob);
+/* share constraint matrix between problem objects */
+
+#define prob_lists _glp_prob_lists
+void prob_lists(glp_prob *P);
+/* build linked lists of shared constraint matrix */
+
+#define prob_mat_changed _glp_prob_mat_changed
+void prob_mat_changed(glp_prob *P);
+/* drop compact copies of the constraint matrix */
+
+#define prob_drop_wlp _glp_prob_drop_wlp
+void prob_drop_wlp(glp_prob *P);
+/* drop kept constraint matrix of the working LP */
+
 #endif
 
 /* eof */
@@ -0,0 +1,427 @@
+/* probmat.c (compact copy of the constraint matrix) */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "glpenv.h"
+#include "prob.h"
+#if defined(HAVE_PTHREAD)
+#include <pthread.h>
+#elif defined(__WOE__)
+#include <windows.h>
+#endif
+
+/***********************************************************************
+*  NAME
+*
+*  glp_compact_matrix - enable/disable compact matrix storage
+*
+*  SYNOPSIS
+*
+*  void glp_compact_matrix(glp_prob *P, int flag);
+*
+*  DESCRIPTION
+*
+*  If the parameter flag is GLP_ON, the routine glp_compact_matrix
+*  enables compact storage of the constraint matrix for the specified
+*  problem object. In this mode the problem object keeps, besides the
+*  linked lists of constraint coefficients, contiguous column-wise and
+*  row-wise copies of the matrix (12 bytes per element each), which
+*  are used by the routines that traverse the whole matrix, e.g. by the
+*  simplex and interior-point solvers to build their working problems,
+*  the MIP presolver and the routines glp_get_mat_row/glp_get_mat_col.
+*  The copies are built on demand and dropped when the matrix changes,
+*  so repeated traversals of an unchanged matrix (for example, solving
+*  a problem many times with different bounds or objectives) do not
+*  chase the lists. Besides, the simplex solvers keep the scaled
+*  constraint matrix of their working problem in the problem object, so
+*  it is not built again, while the matrix, the scale factors and the
+*  set of non-basic fixed variables remain the same.
+*
+*  If the parameter flag is GLP_OFF, the routine disables the compact
+*  storage and frees the memory allocated to it.
+*
+*  The mode is kept on erasing the problem object.
+*
+*  Note that the copies of a problem object copied with glp_copy_prob
+*  are kept regardless of the mode while they are shared. */
+
+void glp_compact_matrix(glp_prob *P, int flag)
+{     if (P == NULL || P->magic != GLP_PROB_MAGIC)
+         xerror("glp_compact_matrix: P = %p; invalid problem object\n",
+            P);
+      if (!(flag == GLP_ON || flag == GLP_OFF))
+         xerror("glp_compact_matrix: flag = %d; invalid parameter\n",
+            flag);
+      P->compact = flag;
+      if (!flag)
+      {  prob_lists(P);
+         prob_mat_changed(P);
+      }
+      return;
+}
+
+static GLPCSM *create_csm(int len, int nnz)
+{     /* create compact copy with len lists of nnz elements */
+      GLPCSM *csm;
+      csm = xmalloc(sizeof(GLPCSM));
+      csm->len = len;
+      csm->ptr = xcalloc(1+len+1, sizeof(int));
+      csm->ind = xcalloc(1+nnz, sizeof(int));
+      csm->val = xcalloc(1+nnz, sizeof(double));
+      csm->ref = 1;
+      return csm;
+}
+
+#if defined(HAVE_PTHREAD)
+static pthread_mutex_t ref_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static int ref_csm(GLPCSM *csm, int delta)
+{     /* change reference count of compact copy and return its new
+         value; problem objects sharing the copy may be used by
+         different threads */
+      int ref;
+#if defined(HAVE_PTHREAD)
+      pthread_mutex_lock(&ref_mutex);
+      ref = (csm->ref += delta);
+      pthread_mutex_unlock(&ref_mutex);
+#elif defined(__WOE__)
+      ref = InterlockedExchangeAdd((volatile LONG *)&csm->ref, delta)
+         + delta;
+#else
+      ref = (csm->ref += delta);
+#endif
+      return ref;
+}
+
+static void delete_csm(GLPCSM *csm)
+{     /* delete compact copy */
+      xfree(csm->ptr);
+      xfree(csm->ind);
+      xfree(csm->val);
+      xfree(csm);
+      return;
+}
+
+static GLPCSM *build_csc(glp_prob *P)
+{     /* build column-wise copy from linked lists */
+      GLPCSM *csc;
+      GLPAIJ *aij;
+      int j, ptr;
+      xassert(!P->nolist);
+      csc = create_csm(P->n, P->nnz);
+      ptr = 1;
+      for (j = 1; j <= P->n; j++)
+      {  csc->ptr[j] = ptr;
+         for (aij = P->col[j]->ptr; aij != NULL; aij = aij->c_next)
+         {  csc->ind[ptr] = aij->row->i;
+            csc->val[ptr] = aij->val;
+            ptr++;
+         }
+      }
+      xassert(ptr == P->nnz+1);
+      csc->ptr[P->n+1] = ptr;
+      return csc;
+}
+
+static GLPCSM *build_csr(glp_prob *P)
+{     /* build row-wise copy from linked lists */
+      GLPCSM *csr;
+      GLPAIJ *aij;
+      int i, ptr;
+      xassert(!P->nolist);
+      csr = create_csm(P->m, P->nnz);
+      ptr = 1;
+      for (i = 1; i <= P->m; i++)
+      {  csr->ptr[i] = ptr;
+         for (aij = P->row[i]->ptr; aij != NULL; aij = aij->r_next)
+         {  csr->ind[ptr] = aij->col->j;
+            csr->val[ptr] = aij->val;
+            ptr++;
+         }
+      }
+      xassert(ptr == P->nnz+1);
+      csr->ptr[P->m+1] = ptr;
+      return csr;
+}
+
+static void release_csm(GLPCSM *csm)
+{     /* release compact copy; it is deleted once no problem object
+         uses it */
+      if (ref_csm(csm, -1) == 0)
+         delete_csm(csm);
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_csc - get column-wise copy of the constraint matrix
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  GLPCSM *prob_csc(glp_prob *P, int bulk);
+*
+*  DESCRIPTION
+*
+*  The flag bulk specifies whether the caller is going to traverse the
+*  whole matrix. If it is not set, the caller needs only one column,
+*  so the copy is built only after a number of such requests (a quarter
+*  of the number of columns) has been made since the matrix was changed
+*  and the routine returns NULL until then; this way alternating
+*  changes and single column requests do not rebuild the copy each
+*  time.
+*
+*  RETURNS
+*
+*  If the compact storage is enabled, the routine prob_csc returns the
+*  column-wise copy of the constraint matrix, building it if necessary;
+*  elements of j-th column are stored in the same order as in its
+*  linked list. The copy shared with another problem object (see
+*  prob_share_mat) is returned in any case. Otherwise the routine
+*  returns NULL. */
+
+GLPCSM *prob_csc(glp_prob *P, int bulk)
+{     if (P->csc == NULL)
+      {  if (!P->compact)
+            return NULL;
+         if (!bulk && ++P->csc_req <= P->n / 4)
+            return NULL;
+         P->csc = build_csc(P);
+      }
+      return P->csc;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_csr - get row-wise copy of the constraint matrix
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  GLPCSM *prob_csr(glp_prob *P, int bulk);
+*
+*  DESCRIPTION
+*
+*  The flag bulk specifies whether the caller is going to traverse the
+*  whole matrix. If it is not set, the caller needs only one row, so
+*  the copy is built only after a number of such requests (a quarter of
+*  the number of rows) has been made since the matrix was changed and
+*  the routine returns NULL until then; this way alternating changes
+*  and single row requests do not rebuild the copy each time.
+*
+*  RETURNS
+*
+*  If the compact storage is enabled, the routine prob_csr returns the
+*  row-wise copy of the constraint matrix, building it if necessary;
+*  elements of i-th row are stored in the same order as in its linked
+*  list. The copy shared with another problem object (see
+*  prob_share_mat) is returned in any case. Otherwise the routine
+*  returns NULL. */
+
+GLPCSM *prob_csr(glp_prob *P, int bulk)
+{     if (P->csr == NULL)
+      {  if (!P->compact)
+            return NULL;
+         if (!bulk && ++P->csr_req <= P->m / 4)
+            return NULL;
+         P->csr = build_csr(P);
+      }
+      return P->csr;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_share_mat - share constraint matrix between problem objects
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  void prob_share_mat(glp_prob *dest, glp_prob *prob);
+*
+*  DESCRIPTION
+*
+*  The routine prob_share_mat makes the problem object dest, which
+*  must have the same rows and columns as the problem object prob and
+*  no constraint coefficients, use the constraint matrix of prob. The
+*  coefficients are not copied: both objects refer to the same compact
+*  copies (they are built for prob, if necessary, and kept until its
+*  matrix changes), and the linked lists of dest are not built until
+*  some routine needs them (see prob_lists). Thus, copies of a problem
+*  object which are only re-solved with different bounds, objective
+*  coefficients or scale factors do not duplicate its matrix. */
+
+void prob_share_mat(glp_prob *dest, glp_prob *prob)
+{     xassert(dest != prob);
+      xassert(dest->m == prob->m && dest->n == prob->n);
+      xassert(dest->nnz == 0 && !dest->nolist);
+      if (prob->csc == NULL)
+         prob->csc = build_csc(prob);
+      if (prob->csr == NULL)
+         prob->csr = build_csr(prob);
+      prob_mat_changed(dest);
+      ref_csm(prob->csc, +1);
+      ref_csm(prob->csr, +1);
+      dest->csc = prob->csc;
+      dest->csr = prob->csr;
+      dest->nnz = prob->nnz;
+      dest->nolist = 1;
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_lists - build linked lists of shared constraint matrix
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  void prob_lists(glp_prob *P);
+*
+*  DESCRIPTION
+*
+*  The routine prob_lists builds the linked lists of constraint
+*  coefficients of the problem object whose matrix is shared with
+*  another object (see prob_share_mat), keeping the order of elements
+*  of the compact copies. It must be called before the lists are used
+*  or changed; if they already exist, the routine does nothing.
+*
+*  The compact copies remain shared until the matrix is changed, so
+*  the routines changing the matrix make the object have its own copy
+*  of the matrix in the linked lists. */
+
+void prob_lists(glp_prob *P)
+{     GLPCSM *csc = P->csc, *csr = P->csr;
+      GLPAIJ *aij, *tail, **map;
+      int i, j, t;
+      if (!P->nolist)
+         return;
+      xassert(csc != NULL && csc->len == P->n);
+      xassert(csr != NULL && csr->len == P->m);
+      /* build column lists in the order of the column-wise copy and
+         collect elements of each row in its (unordered) row list */
+      for (j = 1; j <= P->n; j++)
+      {  GLPCOL *col = P->col[j];
+         xassert(col->ptr == NULL);
+         tail = NULL;
+         for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+         {  GLPROW *row = P->row[csc->ind[t]];
+            aij = dmp_get_atom(P->pool, sizeof(GLPAIJ));
+            aij->row = row;
+            aij->col = col;
+            aij->val = csc->val[t];
+            aij->r_prev = NULL;
+            aij->r_next = row->ptr;
+            aij->c_prev = tail;
+            aij->c_next = NULL;
+            if (tail == NULL)
+               col->ptr = aij;
+            else
+               tail->c_next = aij;
+            row->ptr = tail = aij;
+         }
+      }
+      /* relink row lists in the order of the row-wise copy; map[j]
+         points to the element of the current row in j-th column */
+      map = xcalloc(1+P->n, sizeof(GLPAIJ *));
+      for (i = 1; i <= P->m; i++)
+      {  GLPROW *row = P->row[i];
+         for (aij = row->ptr; aij != NULL; aij = aij->r_next)
+            map[aij->col->j] = aij;
+         tail = NULL;
+         for (t = csr->ptr[i]; t < csr->ptr[i+1]; t++)
+         {  aij = map[csr->ind[t]];
+            xassert(aij != NULL && aij->row == row);
+            aij->r_prev = tail;
+            if (tail == NULL)
+               row->ptr = aij;
+            else
+               tail->r_next = aij;
+            tail = aij;
+         }
+         if (tail != NULL)
+            tail->r_next = NULL;
+      }
+      xfree(map);
+      P->nolist = 0;
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_mat_changed - drop compact copies of the constraint matrix
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  void prob_mat_changed(glp_prob *P);
+*
+*  DESCRIPTION
+*
+*  The routine prob_mat_changed must be called whenever the rows, the
+*  columns or the constraint coefficients of the problem object are
+*  changed (and, if the matrix is shared, prob_lists must be called
+*  before). It releases the compact copies, which are then rebuilt on
+*  request, and frees the kept constraint matrix of the working LP. */
+
+void prob_mat_changed(glp_prob *P)
+{     xassert(!P->nolist);
+      if (P->csc != NULL)
+         release_csm(P->csc), P->csc = NULL;
+      if (P->csr != NULL)
+         release_csm(P->csr), P->csr = NULL;
+      P->csc_req = P->csr_req = 0;
+      prob_drop_wlp(P);
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  prob_drop_wlp - drop kept constraint matrix of the working LP
+*
+*  SYNOPSIS
+*
+*  #include "prob.h"
+*  void prob_drop_wlp(glp_prob *P);
+*
+*  DESCRIPTION
+*
+*  The routine prob_drop_wlp frees the constraint matrix of the working
+*  LP kept by the simplex solvers. Besides prob_mat_changed, it must be
+*  called whenever a scale factor is changed. */
+
+void prob_drop_wlp(glp_prob *P)
+{     GLPWLP *wlp = P->wlp;
+      if (wlp != NULL)
+      {  xfree(wlp->incl);
+         delete_csm(wlp->A);
+         if (wlp->AT != NULL)
+            delete_csm(wlp->AT);
+         xfree(wlp);
+         P->wlp = NULL;
+      }
+      return;
+}
+
+/* eof */
@@ -23,6 +23,7 @@
 
 #include "glpenv.h"
 #include "spxat.h"
+#include "spxvec.h"
 
 /***********************************************************************
 *  spx_alloc_at - allocate constraint matrix in sparse row-wise format
@@ -111,16 +112,12 @@ void spx_at_prod(SPXLP *lp, SPXAT *at, double y[/*1+n*/], double s,
       int *AT_ptr = at->ptr;
       int *AT_ind = at->ind;
       double *AT_val = at->val;
-      int i, ptr, end;
-      double t;
+      int i;
       for (i = 1; i <= m; i++)
       {  if (x[i] != 0.0)
          {  /* y := y + s * (i-th row of A) * x[i] */
-            t = s * x[i];
-            ptr = AT_ptr[i];
-            end = AT_ptr[i+1];
-            for (; ptr < end; ptr++)
-               y[AT_ind[ptr]] += AT_val[ptr] * t;
+            spx_vec_scatter(AT_ptr[i], AT_ptr[i+1], AT_ind, AT_val,
+               s * x[i], y);
          }
       }
       return;
@@ -227,17 +224,12 @@ void spx_eval_trow1(SPXLP *lp, SPXAT *at, const double rho[/*1+m*/],
          int *A_ind = lp->A_ind;
          double *A_val = lp->A_val;
          int *head = lp->head;
-         int k, ptr, end;
-         double tij;
+         int k;
          for (j = 1; j <= n-m; j++)
          {  k = head[m+j]; /* x[k] = xN[j] */
             /* compute t[i,j] = - N'[j] * pi */
-            tij = 0.0;
-            ptr = A_ptr[k];
-            end = A_ptr[k+1];
-            for (; ptr < end; ptr++)
-               tij -= A_val[ptr] * rho[A_ind[ptr]];
-            trow[j] = tij;
+            trow[j] = - spx_vec_gdot(A_ptr[k], A_ptr[k+1], A_ind, A_val,
+               rho);
          }
       }
       else
@@ -247,17 +239,64 @@ void spx_eval_trow1(SPXLP *lp, SPXAT *at, const double rho[/*1+m*/],
       return;
 }
 
+/***********************************************************************
+*  spx_eval_trow1_s - sparse version of spx_eval_trow1
+*
+*  This routine computes i-th row of the simplex table in the same way
+*  as the routine spx_eval_trow1 does, where the vector rho is specified
+*  as a sparse vector, so if the linear combination is used, only rows
+*  of A corresponding to non-zero elements of rho are visited. */
+
+void spx_eval_trow1_s(SPXLP *lp, SPXAT *at, const FVS *rho,
+      double trow[/*1+n-m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      int nnz = lp->nnz;
+      int *AT_ptr = at->ptr;
+      int *AT_ind = at->ind;
+      double *AT_val = at->val;
+      int *head = lp->head;
+      int *rho_ind = rho->ind;
+      double *rho_vec = rho->vec;
+      double *work = at->work;
+      int i, j, k;
+      double cnt1, cnt2;
+      xassert(rho->n == m);
+      /* estimate the number of operations for both ways */
+      cnt1 = (double)(n - m) * ((double)nnz / (double)n);
+      cnt2 = (double)rho->nnz * ((double)nnz / (double)m);
+      if (cnt1 < cnt2)
+      {  /* as inner products */
+         spx_eval_trow1(lp, at, rho_vec, trow);
+         return;
+      }
+      /* as linear combination */
+      for (k = 1; k <= n; k++)
+         work[k] = 0.0;
+      for (k = rho->nnz; k >= 1; k--)
+      {  i = rho_ind[k];
+         /* work := work - (i-th row of A) * rho[i] */
+         spx_vec_scatter(AT_ptr[i], AT_ptr[i+1], AT_ind, AT_val,
+            - rho_vec[i], work);
+      }
+      for (j = 1; j <= n-m; j++)
+         trow[j] = work[head[m+j]];
+      return;
+}
+
 /***********************************************************************
 *  spx_free_at - deallocate constraint matrix in sparse row-wise format
 *
 *  This routine deallocates the memory used for arrays of the program
-*  object at. */
+*  object at (except the matrix arrays, if the constraint matrix is kept
+*  in the original problem object, see spx_keep_lp). */
 
 void spx_free_at(SPXLP *lp, SPXAT *at)
-{     xassert(lp == lp);
-      tfree(at->ptr);
-      tfree(at->ind);
-      tfree(at->val);
+{     if (!lp->kept)
+      {  tfree(at->ptr);
+         tfree(at->ind);
+         tfree(at->val);
+      }
       tfree(at->work);
       return;
 }
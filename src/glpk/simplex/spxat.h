@@ -71,6 +71,11 @@ void spx_eval_trow1(SPXLP *lp, SPXAT *at, const double rho[/*1+m*/],
       double trow[/*1+n-m*/]);
 /* compute i-th row of simplex table */
 
+#define spx_eval_trow1_s _glp_spx_eval_trow1_s
+void spx_eval_trow1_s(SPXLP *lp, SPXAT *at, const FVS *rho,
+      double trow[/*1+n-m*/]);
+/* sparse version of spx_eval_trow1 */
+
 #define spx_free_at _glp_spx_free_at
 void spx_free_at(SPXLP *lp, SPXAT *at);
 /* deallocate constraint matrix in sparse row-wise format */
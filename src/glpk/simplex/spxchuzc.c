@@ -23,6 +23,7 @@
 
 #include "glpenv.h"
 #include "spxchuzc.h"
+#include "spxvec.h"
 
 /***********************************************************************
 *  spx_chuzc_sel - select eligible non-basic variables
@@ -52,52 +53,62 @@
 *  number of such variables 0 <= num <= n-m. (If the parameter list is
 *  specified as NULL, no indices are stored.) */
 
-int spx_chuzc_sel(SPXLP *lp, const double d[/*1+n-m*/], double tol,
-      double tol1, int list[/*1+n-m*/])
-{     int m = lp->m;
-      int n = lp->n;
+static int eligible(SPXLP *lp, const double d[/*1+n-m*/], double tol,
+      double tol1, int j)
+{     /* check if non-basic variable xN[j] is eligible */
+      int m = lp->m;
       double *c = lp->c;
       double *l = lp->l;
       double *u = lp->u;
       int *head = lp->head;
       char *flag = lp->flag;
-      int j, k, num;
+      int k;
       double ck, eps;
+      k = head[m+j]; /* x[k] = xN[j] */
+      if (l[k] == u[k])
+      {  /* xN[j] is fixed variable; skip it */
+         return 0;
+      }
+      /* determine absolute tolerance eps[j] */
+      ck = c[k];
+      eps = tol + tol1 * (ck >= 0.0 ? +ck : -ck);
+      /* check if xN[j] is eligible */
+      if (d[j] <= -eps)
+      {  /* xN[j] should be able to increase */
+         if (flag[j])
+         {  /* but its upper bound is active */
+            return 0;
+         }
+      }
+      else if (d[j] >= +eps)
+      {  /* xN[j] should be able to decrease */
+         if (!flag[j] && l[k] != -DBL_MAX)
+         {  /* but its lower bound is active */
+            return 0;
+         }
+      }
+      else /* -eps < d[j] < +eps */
+      {  /* xN[j] does not affect the objective function within the
+          * specified tolerance */
+         return 0;
+      }
+      /* xN[j] is eligible non-basic variable */
+      return 1;
+}
+
+int spx_chuzc_sel(SPXLP *lp, const double d[/*1+n-m*/], double tol,
+      double tol1, int list[/*1+n-m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      int j, num;
       num = 0;
       /* walk thru list of non-basic variables */
       for (j = 1; j <= n-m; j++)
-      {  k = head[m+j]; /* x[k] = xN[j] */
-         if (l[k] == u[k])
-         {  /* xN[j] is fixed variable; skip it */
-            continue;
-         }
-         /* determine absolute tolerance eps[j] */
-         ck = c[k];
-         eps = tol + tol1 * (ck >= 0.0 ? +ck : -ck);
-         /* check if xN[j] is eligible */
-         if (d[j] <= -eps)
-         {  /* xN[j] should be able to increase */
-            if (flag[j])
-            {  /* but its upper bound is active */
-               continue;
-            }
-         }
-         else if (d[j] >= +eps)
-         {  /* xN[j] should be able to decrease */
-            if (!flag[j] && l[k] != -DBL_MAX)
-            {  /* but its lower bound is active */
-               continue;
-            }
-         }
-         else /* -eps < d[j] < +eps */
-         {  /* xN[j] does not affect the objective function within the
-             * specified tolerance */
-            continue;
+      {  if (eligible(lp, d, tol, tol1, j))
+         {  num++;
+            if (list != NULL)
+               list[num] = j;
          }
-         /* xN[j] is eligible non-basic variable */
-         num++;
-         if (list != NULL)
-            list[num] = j;
       }
       return num;
 }
@@ -156,6 +167,7 @@ void spx_alloc_se(SPXLP *lp, SPXSE *se)
       se->refsp = talloc(1+n, char);
       se->gamma = talloc(1+n-m, double);
       se->work = talloc(1+m, double);
+      se->par = NULL;
       return;
 }
 
@@ -248,19 +260,33 @@ double spx_eval_gamma_j(SPXLP *lp, SPXSE *se, int j)
 *  the total number of such variables.
 *
 *  On exit the routine returns q, the index of the non-basic variable
-*  xN[q] chosen. */
+*  xN[q] chosen.
+*
+*  If the team of threads se->par is specified, long lists are split
+*  into parts scanned in parallel. The best candidates of the parts are
+*  compared in the order of parts, so the routine chooses the same xN[q]
+*  (the first one in the list among equally eligible variables) with
+*  any number of threads. */
 
-int spx_chuzc_pse(SPXLP *lp, SPXSE *se, const double d[/*1+n-m*/],
-      int num, const int list[])
-{     int m = lp->m;
-      int n = lp->n;
+struct chuzc
+{     /* parallel choice of non-basic variable */
+      SPXSE *se;
+      const double *d;
+      int num;
+      const int *list;
+      int q[SPX_PAR_MAX];
+      double best[SPX_PAR_MAX];
+      /* best candidate found in each part */
+};
+
+static int chuzc_pse(SPXSE *se, const double d[], const int list[],
+      int beg, int end, double *best_)
+{     /* choose non-basic variable among list[beg], ..., list[end-1] */
       double *gamma = se->gamma;
       int j, q, t;
       double best, temp;
-      xassert(se->valid);
-      xassert(0 < num && num <= n-m);
       q = 0, best = -1.0;
-      for (t = 1; t <= num; t++)
+      for (t = beg; t < end; t++)
       {  j = list[t];
          /* FIXME */
          if (gamma[j] < DBL_EPSILON)
@@ -270,6 +296,40 @@ int spx_chuzc_pse(SPXLP *lp, SPXSE *se, const double d[/*1+n-m*/],
          if (best < temp)
             q = j, best = temp;
       }
+      *best_ = best;
+      return q;
+}
+
+static void chuzc_part(void *info, int t, int nt)
+{     /* scan t-th part of the list */
+      struct chuzc *w = info;
+      int beg, end;
+      spx_par_range(w->num, t, nt, &beg, &end);
+      w->q[t] = chuzc_pse(w->se, w->d, w->list, beg, end, &w->best[t]);
+      return;
+}
+
+int spx_chuzc_pse(SPXLP *lp, SPXSE *se, const double d[/*1+n-m*/],
+      int num, const int list[])
+{     int m = lp->m;
+      int n = lp->n;
+      int q, t, nt;
+      double best;
+      xassert(se->valid);
+      xassert(0 < num && num <= n-m);
+      nt = spx_par_parts(se->par, num);
+      if (nt == 1)
+         q = chuzc_pse(se, d, list, 1, num+1, &best);
+      else
+      {  struct chuzc w;
+         w.se = se, w.d = d, w.num = num, w.list = list;
+         spx_par_run(se->par, nt, chuzc_part, &w);
+         q = 0, best = -1.0;
+         for (t = 0; t < nt; t++)
+         {  if (best < w.best[t])
+               q = w.q[t], best = w.best[t];
+         }
+      }
       xassert(q != 0);
       return q;
 }
@@ -305,7 +365,62 @@ int spx_chuzc_pse(SPXLP *lp, SPXSE *se, const double d[/*1+n-m*/],
 *  where gamma'[q] is the weight for xN[q] on entry to the routine,
 *  and returns e on exit. (If e happens to be large enough, the calling
 *  program may reset the reference space, since other weights also may
-*  be inaccurate.) */
+*  be inaccurate.)
+*
+*  If the team of threads se->par is specified, the weights gamma[j],
+*  j != q, are updated in parallel. (Every weight is computed exactly
+*  as in the serial case.) */
+
+struct update
+{     /* parallel update of weights */
+      SPXLP *lp;
+      SPXSE *se;
+      int q;
+      const double *trow;
+      double tcol_p, gamma_q, delta_q;
+};
+
+static void update_gamma(struct update *w, int beg, int end)
+{     /* compute new gamma[j] for j = beg, ..., end-1, j != q */
+      SPXLP *lp = w->lp;
+      int m = lp->m;
+      int *head = lp->head;
+      char *refsp = w->se->refsp;
+      double *gamma = w->se->gamma;
+      double *u = w->se->work;
+      const double *trow = w->trow;
+      int j, k;
+      double r, s, t1, t2;
+      for (j = beg; j < end; j++)
+      {  if (j == w->q)
+            continue;
+         if (-1e-9 < trow[j] && trow[j] < +1e-9)
+         {  /* T[p,j] is close to zero; gamma[j] is not changed */
+            continue;
+         }
+         /* compute r[j] = T[p,j] / T[p,q] */
+         r = trow[j] / w->tcol_p;
+         /* compute inner product s[j] = N'[j] * u, where N[j] = A[k]
+          * is constraint matrix column corresponding to xN[j] */
+         k = head[m+j]; /* x[k] = xN[j] */
+         s = spx_vec_gdot(lp->A_ptr[k], lp->A_ptr[k+1], lp->A_ind,
+            lp->A_val, u);
+         /* compute new gamma[j] */
+         t1 = gamma[j] + r * (r * w->gamma_q + s + s);
+         t2 = (refsp[k] ? 1.0 : 0.0) + w->delta_q * r * r;
+         gamma[j] = (t1 >= t2 ? t1 : t2);
+      }
+      return;
+}
+
+static void update_part(void *info, int t, int nt)
+{     /* update t-th part of weights */
+      struct update *w = info;
+      int beg, end;
+      spx_par_range(w->lp->n - w->lp->m, t, nt, &beg, &end);
+      update_gamma(w, beg, end);
+      return;
+}
 
 double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
       const double trow[/*1+n-m*/], const double tcol[/*1+m*/])
@@ -315,8 +430,9 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
       char *refsp = se->refsp;
       double *gamma = se->gamma;
       double *u = se->work;
-      int i, j, k, ptr, end;
-      double gamma_q, delta_q, e, r, s, t1, t2;
+      int i, k, nt;
+      double gamma_q, delta_q, e;
+      struct update w;
       xassert(se->valid);
       xassert(1 <= p && p <= m);
       xassert(1 <= q && q <= n-m);
@@ -339,28 +455,13 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
       /* compute new gamma[q] */
       gamma[q] = gamma_q / (tcol[p] * tcol[p]);
       /* compute new gamma[j] for all j != q */
-      for (j = 1; j <= n-m; j++)
-      {  if (j == q)
-            continue;
-         if (-1e-9 < trow[j] && trow[j] < +1e-9)
-         {  /* T[p,j] is close to zero; gamma[j] is not changed */
-            continue;
-         }
-         /* compute r[j] = T[p,j] / T[p,q] */
-         r = trow[j] / tcol[p];
-         /* compute inner product s[j] = N'[j] * u, where N[j] = A[k]
-          * is constraint matrix column corresponding to xN[j] */
-         s = 0.0;
-         k = head[m+j]; /* x[k] = xN[j] */
-         ptr = lp->A_ptr[k];
-         end = lp->A_ptr[k+1];
-         for (; ptr < end; ptr++)
-            s += lp->A_val[ptr] * u[lp->A_ind[ptr]];
-         /* compute new gamma[j] */
-         t1 = gamma[j] + r * (r * gamma_q + s + s);
-         t2 = (refsp[k] ? 1.0 : 0.0) + delta_q * r * r;
-         gamma[j] = (t1 >= t2 ? t1 : t2);
-      }
+      w.lp = lp, w.se = se, w.q = q, w.trow = trow;
+      w.tcol_p = tcol[p], w.gamma_q = gamma_q, w.delta_q = delta_q;
+      nt = spx_par_parts(se->par, n-m);
+      if (nt == 1)
+         update_gamma(&w, 1, n-m+1);
+      else
+         spx_par_run(se->par, nt, update_part, &w);
       return e;
 }
 
@@ -375,6 +476,131 @@ void spx_free_se(SPXLP *lp, SPXSE *se)
       tfree(se->refsp);
       tfree(se->gamma);
       tfree(se->work);
+      if (se->par != NULL)
+         spx_par_delete(se->par);
+      return;
+}
+
+/***********************************************************************
+*  spx_alloc_pp - allocate partial pricing data block
+*
+*  This routine allocates the memory for arrays used in the partial
+*  pricing data block and initializes its members.
+*
+*  If the flag mult is set, multiple pricing is used, otherwise, simple
+*  partial pricing is used (see the routine spx_chuzc_part below). */
+
+void spx_alloc_pp(SPXLP *lp, SPXPP *pp, int mult)
+{     int m = lp->m;
+      int n = lp->n;
+      pp->mult = mult;
+      /* segment size depends on the number of rows only, so the time
+       * spent to price one segment is comparable to the time spent to
+       * perform FTRAN and BTRAN */
+      pp->seg = 2 * m;
+      if (pp->seg < 200)
+         pp->seg = 200;
+      if (pp->seg > n-m)
+         pp->seg = n-m;
+      pp->next = 1;
+      pp->size = (mult ? 10 : 0);
+      pp->nnn = 0;
+      pp->cand = talloc(1+pp->size, int);
+      return;
+}
+
+/***********************************************************************
+*  spx_chuzc_part - select eligible non-basic variables (partial
+*                   pricing)
+*
+*  This routine is a partial pricing version of the routine
+*  spx_chuzc_sel. Unlike the latter, it does not need the vector of
+*  reduced costs to be valid, but computes reduced costs d[j] of only
+*  those non-basic variables xN[j], which it examines, using simplex
+*  multipliers pi[1], ..., pi[m] (see the routine spx_eval_dj), and
+*  stores them to the array locations d[j].
+*
+*  Non-basic variables are examined by segments of pp->seg consecutive
+*  variables, where the segments rotate, i.e. every call starts from
+*  the segment following the last one examined on the previous call.
+*  The routine stops as soon as some eligible variables are found in a
+*  segment. In case of multiple pricing the routine first re-computes
+*  reduced costs of candidates kept since the previous call and, if
+*  some of them are still eligible, only these are selected; otherwise,
+*  up to pp->size most eligible variables (in the sense of Dantzig's
+*  rule) are chosen from the next segment and kept as new candidates.
+*
+*  The meaning of parameters tol, tol1, and list is the same as for the
+*  routine spx_chuzc_sel. On exit the routine returns the number of
+*  eligible variables selected. Zero is returned only if all non-basic
+*  variables have been examined, in which case all reduced costs d[j]
+*  have been computed and none of them is eligible. */
+
+int spx_chuzc_part(SPXLP *lp, SPXPP *pp, const double pi[/*1+m*/],
+      double d[/*1+n-m*/], double tol, double tol1,
+      int list[/*1+n-m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      int *cand = pp->cand;
+      int j, t, tt, cnt, num;
+      double abs_dj;
+      num = 0;
+      if (pp->mult)
+      {  /* re-price candidates kept since the previous call */
+         for (t = 1; t <= pp->nnn; t++)
+         {  j = cand[t];
+            d[j] = spx_eval_dj(lp, pi, j);
+            if (eligible(lp, d, tol, tol1, j))
+               list[++num] = j;
+         }
+         /* keep only candidates which are still eligible */
+         memcpy(&cand[1], &list[1], num * sizeof(int));
+         pp->nnn = num;
+         if (num > 0)
+            goto done;
+      }
+      /* examine next segments until eligible variables are found */
+      j = pp->next;
+      for (cnt = 0; cnt < n-m; )
+      {  for (t = 1; t <= pp->seg && cnt < n-m; t++, cnt++)
+         {  d[j] = spx_eval_dj(lp, pi, j);
+            if (eligible(lp, d, tol, tol1, j))
+               list[++num] = j;
+            if (++j > n-m)
+               j = 1;
+         }
+         if (num > 0)
+            break;
+      }
+      pp->next = j;
+      if (pp->mult && num > 0)
+      {  /* move up to pp->size most eligible variables to the beginning
+          * of the list and keep them as candidates */
+         if (num > pp->size)
+         {  for (t = 1; t <= pp->size; t++)
+            {  for (tt = t+1; tt <= num; tt++)
+               {  abs_dj = fabs(d[list[tt]]);
+                  if (fabs(d[list[t]]) < abs_dj)
+                     j = list[t], list[t] = list[tt], list[tt] = j;
+               }
+            }
+            num = pp->size;
+         }
+         memcpy(&cand[1], &list[1], num * sizeof(int));
+         pp->nnn = num;
+      }
+done: return num;
+}
+
+/***********************************************************************
+*  spx_free_pp - deallocate partial pricing data block
+*
+*  This routine deallocates the memory used for arrays in the partial
+*  pricing data block. */
+
+void spx_free_pp(SPXLP *lp, SPXPP *pp)
+{     xassert(lp == lp);
+      tfree(pp->cand);
       return;
 }
 
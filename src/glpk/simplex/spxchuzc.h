@@ -25,6 +25,7 @@
 #define SPXCHUZC_H
 
 #include "spxlp.h"
+#include "spxpar.h"
 
 #define spx_chuzc_sel _glp_spx_chuzc_sel
 int spx_chuzc_sel(SPXLP *lp, const double d[/*1+n-m*/], double tol,
@@ -52,6 +53,9 @@ struct SPXSE
        * of non-basic variable xN[j] in the current basis */
       double *work; /* double work[1+m]; */
       /* working array */
+      SPXPAR *par;
+      /* team of threads used to choose xN[q] and to update weights;
+       * NULL means that these loops are run serially */
 };
 
 #define spx_alloc_se _glp_spx_alloc_se
@@ -80,6 +84,40 @@ double spx_update_gamma(SPXLP *lp, SPXSE *se, int p, int q,
 void spx_free_se(SPXLP *lp, SPXSE *se);
 /* deallocate pricing data block */
 
+typedef struct SPXPP SPXPP;
+
+struct SPXPP
+{     /* partial and multiple pricing data block */
+      int mult;
+      /* if this flag is set, multiple pricing is used */
+      int seg;
+      /* number of non-basic variables in one segment */
+      int next;
+      /* index j of non-basic variable xN[j], from which the next
+       * segment starts */
+      int size;
+      /* maximal number of candidates kept (multiple pricing) */
+      int nnn;
+      /* number of candidates currently kept, 0 <= nnn <= size */
+      int *cand; /* int cand[1+size]; */
+      /* cand[1], ..., cand[nnn] are indices j of non-basic variables
+       * xN[j] kept as candidates to enter the basis */
+};
+
+#define spx_alloc_pp _glp_spx_alloc_pp
+void spx_alloc_pp(SPXLP *lp, SPXPP *pp, int mult);
+/* allocate partial pricing data block */
+
+#define spx_chuzc_part _glp_spx_chuzc_part
+int spx_chuzc_part(SPXLP *lp, SPXPP *pp, const double pi[/*1+m*/],
+      double d[/*1+n-m*/], double tol, double tol1,
+      int list[/*1+n-m*/]);
+/* select eligible non-basic variables (partial pricing) */
+
+#define spx_free_pp _glp_spx_free_pp
+void spx_free_pp(SPXLP *lp, SPXPP *pp);
+/* deallocate partial pricing data block */
+
 #endif
 
 /* eof */
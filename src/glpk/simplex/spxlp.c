@@ -23,6 +23,7 @@
 
 #include "glpenv.h"
 #include "spxlp.h"
+#include "spxvec.h"
 
 /***********************************************************************
 *  spx_factorize - compute factorization of current basis matrix
@@ -286,6 +287,43 @@ void spx_eval_tcol(SPXLP *lp, int j, double tcol[/*1+m*/])
       return;
 }
 
+/***********************************************************************
+*  spx_eval_tcol_s - sparse version of spx_eval_tcol
+*
+*  This routine computes j-th column of the simplex table in the same
+*  way as the routine spx_eval_tcol does, however, it stores the column
+*  as a sparse vector and uses sparse FTRAN, so if the column is sparse
+*  the time spent does not depend on m. */
+
+void spx_eval_tcol_s(SPXLP *lp, int j, FVS *tcol)
+{     int m = lp->m;
+      int n = lp->n;
+      int *A_ptr = lp->A_ptr;
+      int *A_ind = lp->A_ind;
+      double *A_val = lp->A_val;
+      int *head = lp->head;
+      int *ind = tcol->ind;
+      double *vec = tcol->vec;
+      int k, ptr, end, nnz;
+      xassert(tcol->n == m);
+      xassert(1 <= j && j <= n-m);
+      k = head[m+j]; /* x[k] = xN[j] */
+      /* compute tcol = - inv(B) * N[j] */
+      fvs_clear_vec(tcol);
+      nnz = 0;
+      ptr = A_ptr[k];
+      end = A_ptr[k+1];
+      for (; ptr < end; ptr++)
+      {  if (A_val[ptr] != 0.0)
+         {  ind[++nnz] = A_ind[ptr];
+            vec[A_ind[ptr]] = -A_val[ptr];
+         }
+      }
+      tcol->nnz = nnz;
+      bfd_ftran_s(lp->bfd, tcol);
+      return;
+}
+
 /***********************************************************************
 *  spx_eval_rho - compute i-th row of basis matrix inverse
 *
@@ -314,6 +352,26 @@ void spx_eval_rho(SPXLP *lp, int i, double rho[/*1+m*/])
       return;
 }
 
+/***********************************************************************
+*  spx_eval_rho_s - sparse version of spx_eval_rho
+*
+*  This routine computes i-th row of the matrix inv(B) in the same way
+*  as the routine spx_eval_rho does, however, it stores the row as a
+*  sparse vector and uses sparse BTRAN. */
+
+void spx_eval_rho_s(SPXLP *lp, int i, FVS *rho)
+{     int m = lp->m;
+      xassert(rho->n == m);
+      xassert(1 <= i && i <= m);
+      /* compute rho = inv(B') * e[i] */
+      fvs_clear_vec(rho);
+      rho->nnz = 1;
+      rho->ind[1] = i;
+      rho->vec[i] = 1.0;
+      bfd_btran_s(lp->bfd, rho);
+      return;
+}
+
 /***********************************************************************
 *  spx_eval_tij - compute element T[i,j] of simplex table
 *
@@ -439,15 +497,17 @@ void spx_eval_trow(SPXLP *lp, const double rho[/*1+m*/], double
 *  On exit the routine stores updated components of the vector beta to
 *  the same locations, where the input vector beta was stored. */
 
-void spx_update_beta(SPXLP *lp, double beta[/*1+m*/], int p,
-      int p_flag, int q, const double tcol[/*1+m*/])
-{     int m = lp->m;
+static double update_beta_p(SPXLP *lp, double beta[/*1+m*/], int p,
+      int p_flag, int q, double t_pq)
+{     /* compute increment delta xN[q] and, if 1 <= p <= m, new value
+       * of beta[p] (t_pq is the pivot element T[p,q]) */
+      int m = lp->m;
       int n = lp->n;
       double *l = lp->l;
       double *u = lp->u;
       int *head = lp->head;
       char *flag = lp->flag;
-      int i, k;
+      int k;
       double delta_p, delta_q;
       if (p < 0)
       {  /* special case: xN[q] goes to its opposite bound */
@@ -486,7 +546,7 @@ void spx_update_beta(SPXLP *lp, double beta[/*1+m*/], int p,
             delta_p = l[k] - beta[p];
          }
          /* determine delta xN[q] */
-         delta_q = delta_p / tcol[p];
+         delta_q = delta_p / t_pq;
          /* compute new beta[p], which is the value of xN[q] in the
           * adjacent basis */
          k = head[m+q]; /* x[k] = xN[q] */
@@ -506,14 +566,117 @@ void spx_update_beta(SPXLP *lp, double beta[/*1+m*/], int p,
             beta[p] = l[k] + delta_q;
          }
       }
+      return delta_q;
+}
+
+void spx_update_beta(SPXLP *lp, double beta[/*1+m*/], int p,
+      int p_flag, int q, const double tcol[/*1+m*/])
+{     int m = lp->m;
+      double beta_p, delta_q;
+      delta_q = update_beta_p(lp, beta, p, p_flag, q,
+         p > 0 ? tcol[p] : 0.0);
       /* compute new beta[i] for all i != p */
-      for (i = 1; i <= m; i++)
-      {  if (i != p)
-            beta[i] += tcol[i] * delta_q;
+      if (p > 0)
+      {  beta_p = beta[p];
+         spx_vec_axpy(m, beta, delta_q, tcol);
+         beta[p] = beta_p;
+      }
+      else
+         spx_vec_axpy(m, beta, delta_q, tcol);
+      return;
+}
+
+/***********************************************************************
+*  spx_update_beta_s - sparse version of spx_update_beta
+*
+*  This routine is a sparse version of the routine spx_update_beta,
+*  where the simplex table column is specified as a sparse vector, so
+*  only the values of basic variables xB[i], for which tcol[i] != 0,
+*  are updated. */
+
+void spx_update_beta_s(SPXLP *lp, double beta[/*1+m*/], int p,
+      int p_flag, int q, const FVS *tcol)
+{     int *ind = tcol->ind;
+      double *vec = tcol->vec;
+      int i, k;
+      double delta_q;
+      xassert(tcol->n == lp->m);
+      delta_q = update_beta_p(lp, beta, p, p_flag, q,
+         p > 0 ? vec[p] : 0.0);
+      /* compute new beta[i] for all i != p */
+      for (k = tcol->nnz; k >= 1; k--)
+      {  i = ind[k];
+         if (i != p)
+            beta[i] += vec[i] * delta_q;
       }
       return;
 }
 
+/***********************************************************************
+*  spx_update_beta_flip - update values of basic variables on flips
+*
+*  This routine updates the vector beta = (beta[i]) of values of basic
+*  variables xB = (xB[i]) when several non-basic variables go to their
+*  opposite bounds at once (as in the dual long-step ratio test), and
+*  changes their active bound flags.
+*
+*  Indices j of non-basic variables xN[j] which go to their opposite
+*  bounds should be specified in locations list[1], ..., list[num].
+*  All these variables should be double-bounded and not fixed.
+*
+*  Let delta xN be the vector of increments of non-basic variables,
+*  which is computed as for the special case p < 0 of the routine
+*  spx_update_beta. Then
+*
+*     new beta = beta - inv(B) * N * delta xN,
+*
+*  where only one FTRAN is needed regardless of the number of flips.
+*
+*  The parameter work is a working sparse vector of dimension m. */
+
+void spx_update_beta_flip(SPXLP *lp, double beta[/*1+m*/], int num,
+      const int list[], FVS *work)
+{     int m = lp->m;
+      int n = lp->n;
+      int *A_ptr = lp->A_ptr;
+      int *A_ind = lp->A_ind;
+      double *A_val = lp->A_val;
+      double *l = lp->l;
+      double *u = lp->u;
+      int *head = lp->head;
+      char *flag = lp->flag;
+      int *ind = work->ind;
+      double *vec = work->vec;
+      int i, j, k, t, ptr, end;
+      double delta;
+      xassert(work->n == m);
+      if (num == 0)
+         goto done;
+      /* compute N * delta xN and flip the variables */
+      fvs_clear_vec(work);
+      for (t = 1; t <= num; t++)
+      {  j = list[t];
+         xassert(1 <= j && j <= n-m);
+         k = head[m+j]; /* x[k] = xN[j] */
+         xassert(l[k] != -DBL_MAX && u[k] != +DBL_MAX && l[k] != u[k]);
+         delta = (flag[j] ? l[k] - u[k] : u[k] - l[k]);
+         flag[j] = 1 - flag[j];
+         ptr = A_ptr[k];
+         end = A_ptr[k+1];
+         for (; ptr < end; ptr++)
+            vec[A_ind[ptr]] += A_val[ptr] * delta;
+      }
+      fvs_gather_vec(work, 0.0);
+      /* compute inv(B) * N * delta xN */
+      bfd_ftran_s(lp->bfd, work);
+      /* update values of basic variables */
+      for (t = work->nnz; t >= 1; t--)
+      {  i = ind[t];
+         beta[i] -= vec[i];
+      }
+done: return;
+}
+
 /***********************************************************************
 *  spx_update_d - update reduced costs of non-basic variables
 *
@@ -572,24 +735,75 @@ double spx_update_d(SPXLP *lp, double d[/*1+n-m*/], int p, int q,
       int n = lp->n;
       double *c = lp->c;
       int *head = lp->head;
-      int i, j, k;
+      int k;
       double dq, e;
       xassert(1 <= p && p <= m);
       xassert(1 <= q && q <= n);
       /* compute d[q] in current basis more accurately */
       k = head[m+q]; /* x[k] = xN[q] */
-      dq = c[k];
-      for (i = 1; i <= m; i++)
-         dq += tcol[i] * c[head[i]];
+      dq = c[k] + spx_vec_gdot(1, 1+m, head, tcol, c);
       /* compute relative error in d[q] */
       e = fabs(dq - d[q]) / (1.0 + fabs(dq));
       /* compute new d[q], which is the reduced cost of xB[p] in the
        * adjacent basis */
-      d[q] = (dq /= tcol[p]);
+      dq /= tcol[p];
       /* compute new d[j] for all j != q */
-      for (j = 1; j <= n-m; j++)
-      {  if (j != q)
-            d[j] -= trow[j] * dq;
+      spx_vec_axpy(n-m, d, - dq, trow);
+      d[q] = dq;
+      return e;
+}
+
+/***********************************************************************
+*  spx_update_pi - update simplex multipliers
+*
+*  This routine updates the vector pi = (pi[i]) of simplex multipliers
+*  for the adjacent basis. It is used instead of the routine
+*  spx_update_d, if reduced costs of non-basic variables are computed
+*  on demand (as in partial pricing), so the p-th row of the simplex
+*  table is not needed.
+*
+*  The parameters p and q have the same meaning as for the routine
+*  spx_update_d. The parameter dq specifies the reduced cost d[q] of
+*  non-basic variable xN[q] in the current basis.
+*
+*  It is assumed that rho is p-th row of inv(B) and tcol is q-th column
+*  of the simplex table, both computed for the current basis.
+*
+*  First, the routine computes more accurate d[q] using the column of
+*  the simplex table and its relative error e (as spx_update_d does).
+*  Then, since the reduced cost of xB[p] in the adjacent basis is
+*  new d[q] = d[q] / T[p,q], the simplex multipliers are updated as
+*  follows:
+*
+*     new pi = pi - rho * new d[q].
+*
+*  On exit the routine returns e. */
+
+double spx_update_pi(SPXLP *lp, double pi[/*1+m*/], int p, int q,
+      double dq, const FVS *rho, const double tcol[/*1+m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      double *c = lp->c;
+      int *head = lp->head;
+      int *ind = rho->ind;
+      double *vec = rho->vec;
+      int i, k, t;
+      double dq1, e;
+      xassert(rho->n == m);
+      xassert(1 <= p && p <= m);
+      xassert(1 <= q && q <= n-m);
+      /* compute d[q] in current basis more accurately */
+      k = head[m+q]; /* x[k] = xN[q] */
+      dq1 = c[k] + spx_vec_gdot(1, 1+m, head, tcol, c);
+      /* compute relative error in d[q] */
+      e = fabs(dq1 - dq) / (1.0 + fabs(dq1));
+      /* compute new d[q], which is the reduced cost of xB[p] in the
+       * adjacent basis */
+      dq1 /= tcol[p];
+      /* compute new pi */
+      for (t = rho->nnz; t >= 1; t--)
+      {  i = ind[t];
+         pi[i] -= vec[i] * dq1;
       }
       return e;
 }
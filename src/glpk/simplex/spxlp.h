@@ -115,6 +115,10 @@ struct SPXLP
       /* row indices */
       double *A_val; /* double A_val[1+nnz]; */
       /* non-zero element values (constraint coefficients) */
+      int kept;
+      /* if this flag is set, the arrays A_ptr, A_ind, and A_val belong
+       * to the matrix kept in the original problem object (see the
+       * routine spx_keep_lp), so they are neither built nor freed */
       /*--------------------------------------------------------------*/
       /* principal vectors of LP formulation */
       double *b; /* double b[1+m]; */
@@ -182,6 +186,14 @@ void spx_eval_tcol(SPXLP *lp, int j, double tcol[/*1+m*/]);
 void spx_eval_rho(SPXLP *lp, int i, double rho[/*1+m*/]);
 /* compute i-th row of basis matrix inverse */
 
+#define spx_eval_tcol_s _glp_spx_eval_tcol_s
+void spx_eval_tcol_s(SPXLP *lp, int j, FVS *tcol);
+/* sparse version of spx_eval_tcol */
+
+#define spx_eval_rho_s _glp_spx_eval_rho_s
+void spx_eval_rho_s(SPXLP *lp, int i, FVS *rho);
+/* sparse version of spx_eval_rho */
+
 #define spx_eval_tij _glp_spx_eval_tij
 double spx_eval_tij(SPXLP *lp, const double rho[/*1+m*/], int j);
 /* compute element T[i,j] of simplex table */
@@ -196,11 +208,26 @@ void spx_update_beta(SPXLP *lp, double beta[/*1+m*/], int p,
       int p_flag, int q, const double tcol[/*1+m*/]);
 /* update values of basic variables */
 
+#define spx_update_beta_s _glp_spx_update_beta_s
+void spx_update_beta_s(SPXLP *lp, double beta[/*1+m*/], int p,
+      int p_flag, int q, const FVS *tcol);
+/* sparse version of spx_update_beta */
+
+#define spx_update_beta_flip _glp_spx_update_beta_flip
+void spx_update_beta_flip(SPXLP *lp, double beta[/*1+m*/], int num,
+      const int list[], FVS *work);
+/* update values of basic variables on flips */
+
 #define spx_update_d _glp_spx_update_d
 double spx_update_d(SPXLP *lp, double d[/*1+n-m*/], int p, int q,
       const double trow[/*1+n-m*/], const double tcol[/*1+m*/]);
 /* update reduced costs of non-basic variables */
 
+#define spx_update_pi _glp_spx_update_pi
+double spx_update_pi(SPXLP *lp, double pi[/*1+m*/], int p, int q,
+      double dq, const FVS *rho, const double tcol[/*1+m*/]);
+/* update simplex multipliers */
+
 #define spx_change_basis _glp_spx_change_basis
 void spx_change_basis(SPXLP *lp, int p, int p_flag, int q);
 /* change current basis to adjacent one */
@@ -23,6 +23,7 @@
 
 #include "glpenv.h"
 #include "spxnt.h"
+#include "spxvec.h"
 
 /***********************************************************************
 *  spx_alloc_nt - allocate matrix N in sparse row-wise format
@@ -222,8 +223,7 @@ void spx_nt_prod(SPXLP *lp, SPXNT *nt, double y[/*1+n-m*/], int ign,
       int *NT_len = nt->len;
       int *NT_ind = nt->ind;
       double *NT_val = nt->val;
-      int i, j, ptr, end;
-      double t;
+      int i, j;
       if (ign)
       {  /* y := 0 */
          for (j = 1; j <= n-m; j++)
@@ -232,16 +232,46 @@ void spx_nt_prod(SPXLP *lp, SPXNT *nt, double y[/*1+n-m*/], int ign,
       for (i = 1; i <= m; i++)
       {  if (x[i] != 0.0)
          {  /* y := y + s * (i-th row of N) * x[i] */
-            t = s * x[i];
-            ptr = NT_ptr[i];
-            end = ptr + NT_len[i];
-            for (; ptr < end; ptr++)
-               y[NT_ind[ptr]] += NT_val[ptr] * t;
+            spx_vec_scatter(NT_ptr[i], NT_ptr[i] + NT_len[i], NT_ind,
+               NT_val, s * x[i], y);
          }
       }
       return;
 }
 
+/***********************************************************************
+*  spx_nt_prod_s - sparse version of spx_nt_prod
+*
+*  This routine computes the same product as the routine spx_nt_prod
+*  does, where the vector x is specified as a sparse vector, so only
+*  rows of N corresponding to its non-zero elements are visited. */
+
+void spx_nt_prod_s(SPXLP *lp, SPXNT *nt, double y[/*1+n-m*/], int ign,
+      double s, const FVS *x)
+{     int m = lp->m;
+      int n = lp->n;
+      int *NT_ptr = nt->ptr;
+      int *NT_len = nt->len;
+      int *NT_ind = nt->ind;
+      double *NT_val = nt->val;
+      int *x_ind = x->ind;
+      double *x_vec = x->vec;
+      int i, j, k;
+      xassert(x->n == m);
+      if (ign)
+      {  /* y := 0 */
+         for (j = 1; j <= n-m; j++)
+            y[j] = 0.0;
+      }
+      for (k = x->nnz; k >= 1; k--)
+      {  i = x_ind[k];
+         /* y := y + s * (i-th row of N) * x[i] */
+         spx_vec_scatter(NT_ptr[i], NT_ptr[i] + NT_len[i], NT_ind,
+            NT_val, s * x_vec[i], y);
+      }
+      return;
+}
+
 /***********************************************************************
 *  spx_free_nt - deallocate matrix N in sparse row-wise format
 *
@@ -0,0 +1,253 @@
+/* spxpar.c */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  Copyright (C) 2015 Andrew Makhorin, Department for Applied
+*  Informatics, Moscow Aviation Institute, Moscow, Russia. All rights
+*  reserved. E-mail: <mao@gnu.org>.
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "glpenv.h"
+#include "spxpar.h"
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+/***********************************************************************
+*  This module implements a team of threads, which the simplex solvers
+*  use to split long loops (pricing and weight updates) into parts run
+*  in parallel.
+*
+*  The threads are created once per call to the solver and wait for
+*  work between the iterations, so starting a loop costs only waking
+*  them up. The calling thread runs the first part itself.
+*
+*  Parts only read shared data and write disjoint locations, and never
+*  call the GLPK environment routines (the environment belongs to the
+*  calling thread). Results computed by the parts (for example, the best
+*  candidate) should be combined by the calling thread in the order of
+*  parts, which makes the result independent of the number of threads.
+*
+*  Without HAVE_PTHREAD no team is created, and the solvers run all
+*  loops serially. */
+
+/* minimal number of loop iterations per part */
+#define PAR_MIN 8192
+
+#ifdef HAVE_PTHREAD
+struct worker
+{     /* thread of the team */
+      SPXPAR *par;
+      /* team */
+      int t;
+      /* number of the part run by the thread */
+      pthread_t tid;
+};
+#endif
+
+struct SPXPAR
+{     int nthreads;
+      /* number of threads (including the calling thread) */
+#ifdef HAVE_PTHREAD
+      struct worker *w; /* struct worker w[nthreads]; */
+      /* w[0] is not used;
+       * w[t], 1 <= t < nthreads, is the thread running part t */
+      pthread_mutex_t mutex;
+      pthread_cond_t start;
+      /* signalled when a new loop is started */
+      pthread_cond_t done;
+      /* signalled when the last part of a loop is finished */
+      int gen;
+      /* number of loops started so far */
+      int quit;
+      /* flag telling the threads to exit */
+      int nt;
+      /* number of parts of the current loop */
+      int left;
+      /* number of parts of the current loop not finished yet (except
+       * part 0 run by the calling thread) */
+      void (*func)(void *info, int t, int nt);
+      void *info;
+      /* routine running one part of the current loop */
+#endif
+};
+
+#ifdef HAVE_PTHREAD
+static void *run_worker(void *arg)
+{     /* wait for loops and run their parts */
+      struct worker *w = arg;
+      SPXPAR *par = w->par;
+      int gen = 0;
+      pthread_mutex_lock(&par->mutex);
+      for (;;)
+      {  while (par->gen == gen && !par->quit)
+            pthread_cond_wait(&par->start, &par->mutex);
+         if (par->quit)
+            break;
+         gen = par->gen;
+         if (w->t < par->nt)
+         {  pthread_mutex_unlock(&par->mutex);
+            par->func(par->info, w->t, par->nt);
+            pthread_mutex_lock(&par->mutex);
+            if (--par->left == 0)
+               pthread_cond_signal(&par->done);
+         }
+      }
+      pthread_mutex_unlock(&par->mutex);
+      return NULL;
+}
+#endif
+
+/***********************************************************************
+*  spx_par_create - create team of threads
+*
+*  This routine creates a team of nthreads threads (including the
+*  calling thread) and returns a pointer to it. If nthreads <= 1 or
+*  threads are not available, the routine returns NULL, which means
+*  that all loops are run serially. */
+
+SPXPAR *spx_par_create(int nthreads)
+{
+#ifdef HAVE_PTHREAD
+      SPXPAR *par;
+      int t;
+      xassert(nthreads <= SPX_PAR_MAX);
+      if (nthreads <= 1)
+         return NULL;
+      par = talloc(1, SPXPAR);
+      par->w = talloc(nthreads, struct worker);
+      pthread_mutex_init(&par->mutex, NULL);
+      pthread_cond_init(&par->start, NULL);
+      pthread_cond_init(&par->done, NULL);
+      par->gen = par->quit = par->nt = par->left = 0;
+      par->func = NULL;
+      par->info = NULL;
+      for (t = 1; t < nthreads; t++)
+      {  par->w[t].par = par;
+         par->w[t].t = t;
+         if (pthread_create(&par->w[t].tid, NULL, run_worker,
+            &par->w[t]) != 0)
+            break;
+      }
+      par->nthreads = t;
+      if (par->nthreads <= 1)
+      {  spx_par_delete(par);
+         par = NULL;
+      }
+      return par;
+#else
+      xassert(nthreads <= SPX_PAR_MAX);
+      return NULL;
+#endif
+}
+
+/***********************************************************************
+*  spx_par_parts - determine number of parts to split loop into
+*
+*  This routine returns the number of parts, into which a loop of len
+*  iterations should be split. Short loops are not split, since waking
+*  up the threads would take more time than the loop itself. */
+
+int spx_par_parts(SPXPAR *par, int len)
+{     int nt;
+      if (par == NULL)
+         return 1;
+      nt = len / PAR_MIN;
+      if (nt > par->nthreads)
+         nt = par->nthreads;
+      if (nt < 1)
+         nt = 1;
+      return nt;
+}
+
+/***********************************************************************
+*  spx_par_run - run parts of loop on team of threads
+*
+*  This routine calls func(info, t, nt) for t = 0, ..., nt-1, where
+*  nt is the number of parts determined with spx_par_parts, and waits
+*  until all calls have returned. Part 0 is run by the calling thread,
+*  and other parts by the threads of the team. */
+
+void spx_par_run(SPXPAR *par, int nt, void (*func)(void *info, int t,
+      int nt), void *info)
+{
+#ifdef HAVE_PTHREAD
+      if (nt > 1)
+      {  xassert(par != NULL && nt <= par->nthreads);
+         pthread_mutex_lock(&par->mutex);
+         par->func = func;
+         par->info = info;
+         par->nt = nt;
+         par->left = nt - 1;
+         par->gen++;
+         pthread_cond_broadcast(&par->start);
+         pthread_mutex_unlock(&par->mutex);
+         func(info, 0, nt);
+         pthread_mutex_lock(&par->mutex);
+         while (par->left > 0)
+            pthread_cond_wait(&par->done, &par->mutex);
+         pthread_mutex_unlock(&par->mutex);
+         return;
+      }
+#endif
+      xassert(nt == 1);
+      xassert(par == par);
+      func(info, 0, 1);
+      return;
+}
+
+/***********************************************************************
+*  spx_par_range - determine range of loop indices for one part
+*
+*  This routine splits loop indices 1, ..., len into nt contiguous
+*  ranges of nearly equal length, and stores the range of part t in
+*  *beg (first index) and *end (index after the last one). */
+
+void spx_par_range(int len, int t, int nt, int *beg, int *end)
+{     *beg = 1 + (int)((double)len * (double)t / (double)nt);
+      *end = 1 + (int)((double)len * (double)(t+1) / (double)nt);
+      return;
+}
+
+/***********************************************************************
+*  spx_par_delete - delete team of threads
+*
+*  This routine tells the threads of the team to exit, waits for them,
+*  and frees the memory used by the team. */
+
+void spx_par_delete(SPXPAR *par)
+{
+#ifdef HAVE_PTHREAD
+      int t;
+      pthread_mutex_lock(&par->mutex);
+      par->quit = 1;
+      pthread_cond_broadcast(&par->start);
+      pthread_mutex_unlock(&par->mutex);
+      for (t = 1; t < par->nthreads; t++)
+         pthread_join(par->w[t].tid, NULL);
+      pthread_cond_destroy(&par->done);
+      pthread_cond_destroy(&par->start);
+      pthread_mutex_destroy(&par->mutex);
+      tfree(par->w);
+      tfree(par);
+#else
+      xassert(par != par);
+#endif
+      return;
+}
+
+/* eof */
@@ -0,0 +1,56 @@
+/* spxpar.h */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  Copyright (C) 2015 Andrew Makhorin, Department for Applied
+*  Informatics, Moscow Aviation Institute, Moscow, Russia. All rights
+*  reserved. E-mail: <mao@gnu.org>.
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#ifndef SPXPAR_H
+#define SPXPAR_H
+
+typedef struct SPXPAR SPXPAR;
+/* team of threads sharing work in the simplex solvers */
+
+#define SPX_PAR_MAX 256
+/* maximal number of threads in team */
+
+#define spx_par_create _glp_spx_par_create
+SPXPAR *spx_par_create(int nthreads);
+/* create team of threads */
+
+#define spx_par_parts _glp_spx_par_parts
+int spx_par_parts(SPXPAR *par, int len);
+/* determine number of parts to split loop into */
+
+#define spx_par_run _glp_spx_par_run
+void spx_par_run(SPXPAR *par, int nt, void (*func)(void *info, int t,
+      int nt), void *info);
+/* run parts of loop on team of threads */
+
+#define spx_par_range _glp_spx_par_range
+void spx_par_range(int len, int t, int nt, int *beg, int *end);
+/* determine range of loop indices for one part */
+
+#define spx_par_delete _glp_spx_par_delete
+void spx_par_delete(SPXPAR *par);
+/* delete team of threads */
+
+#endif
+
+/* eof */
@@ -83,6 +83,10 @@ struct csa
       SPXSE *se;
       /* projected steepest edge and Devex pricing data block (NULL if
        * not used) */
+      SPXPP *pp;
+      /* partial and multiple pricing data block (NULL if not used); if
+       * it is used, reduced costs d[j] are computed on demand, and the
+       * simplex multipliers are kept and updated in the array work */
       int num;
       /* number of eligible non-basic variables */
       int *list; /* int list[1+n-m]; */
@@ -90,7 +94,7 @@ struct csa
        * variables xN[j] */
       int q;
       /* xN[q] is a non-basic variable chosen to enter the basis */
-      double *tcol; /* double tcol[1+m]; */
+      FVS tcol; /* FVS tcol[1:m]; */
       /* q-th (pivot) column of the simplex table */
       int p;
       /* xB[p] is a basic variable chosen to leave the basis;
@@ -102,6 +106,8 @@ struct csa
        * basis should be set to the upper bound */
       double *trow; /* double trow[1+n-m]; */
       /* p-th (pivot) row of the simplex table */
+      FVS rho; /* FVS rho[1:m]; */
+      /* p-th row of the inverse inv(B); also used as working vector */
       double *work; /* double work[1+m]; */
       /* working array */
       int p_stat, d_stat;
@@ -124,6 +130,13 @@ struct csa
       /* iteration limit */
       int tm_lim;
       /* time limit, milliseconds */
+      const volatile int *stop;
+      /* if *stop is non-zero, terminate the search */
+      void (*prog_func)(const glp_prog *prog, void *info);
+      void *prog_info;
+      /* progress callback and its transit pointer */
+      int prog_frq;
+      /* progress report frequency, milliseconds */
       int out_frq;
       /* display output frequency, iterations */
       int out_dly;
@@ -142,6 +155,12 @@ struct csa
       /* simplex iteration count at most recent display output */
       int inv_cnt;
       /* basis factorization count since most recent display output */
+      int inv_tot;
+      /* basis factorization count since the beginning of the search */
+      double tm_prog;
+      /* time value at most recent progress report */
+      int it_prog;
+      /* simplex iteration count at most recent progress report */
 };
 
 /***********************************************************************
@@ -502,7 +521,7 @@ static void choose_pivot(struct csa *csa)
       SPXSE *se = csa->se;
       int *list = csa->list;
       int nnn, try, q, t, p_flag, p;
-      double *tcol = csa->work;
+      FVS *tcol = &csa->rho;
       /* initial number of eligible non-basic variables */
       nnn = csa->num;
       /* nothing has been chosen so far */
@@ -521,31 +540,31 @@ try:  /* choose non-basic variable xN[q] */
       }
       xassert(1 <= q && q <= n-m);
       /* compute q-th column of the simplex table */
-      spx_eval_tcol(lp, q, tcol);
+      spx_eval_tcol_s(lp, q, tcol);
       /* choose basic variable xB[p] */
       if (!csa->harris)
       {  /* textbook ratio test */
          p = spx_chuzr_std(lp, csa->phase, beta, q,
-            d[q] < 0.0 ? +1. : -1., tcol, &p_flag, csa->tol_piv,
+            d[q] < 0.0 ? +1. : -1., tcol->vec, &p_flag, csa->tol_piv,
             .30 * csa->tol_bnd, .30 * csa->tol_bnd1);
       }
       else
       {  /* Harris' two-pass ratio test */
          p = spx_chuzr_harris(lp, csa->phase, beta, q,
-            d[q] < 0.0 ? +1. : -1., tcol, &p_flag , csa->tol_piv,
+            d[q] < 0.0 ? +1. : -1., tcol->vec, &p_flag , csa->tol_piv,
             .50 * csa->tol_bnd, .50 * csa->tol_bnd1);
       }
       /* either keep previous choice or accept new choice depending on
        * which one is better */
       if (csa->q == 0 || p <= 0 ||
-         fabs(tcol[p]) > fabs(csa->tcol[csa->p]))
+         fabs(tcol->vec[p]) > fabs(csa->tcol.vec[csa->p]))
       {  csa->q = q;
-         memcpy(&csa->tcol[1], &tcol[1], m * sizeof(double));
+         fvs_copy_vec(&csa->tcol, tcol);
          csa->p = p;
          csa->p_flag = p_flag;
       }
       /* check if current choice is acceptable */
-      if (csa->p <= 0 || fabs(csa->tcol[csa->p]) >= 0.001)
+      if (csa->p <= 0 || fabs(csa->tcol.vec[csa->p]) >= 0.001)
          goto done;
       if (nnn == 1)
          goto done;
@@ -589,6 +608,93 @@ static double sum_infeas(SPXLP *lp, const double beta[/*1+m*/])
       return sum;
 }
 
+/***********************************************************************
+*  sum_dual_infeas - compute sum of dual infeasibilities
+*
+*  This routine computes the sum of reduced costs of non-basic variables
+*  which have wrong sign with respect to their active bounds. */
+
+static double sum_dual_infeas(SPXLP *lp, const double d[/*1+n-m*/])
+{     int m = lp->m;
+      int n = lp->n;
+      double *l = lp->l;
+      double *u = lp->u;
+      int *head = lp->head;
+      char *flag = lp->flag;
+      int j, k;
+      double sum = 0.0;
+      for (j = 1; j <= n-m; j++)
+      {  k = head[m+j]; /* x[k] = xN[j] */
+         if (l[k] == u[k])
+            continue;
+         if (d[j] < 0.0 && !flag[j])
+            sum -= d[j];
+         else if (d[j] > 0.0 && (flag[j] || l[k] == -DBL_MAX))
+            sum += d[j];
+      }
+      return sum;
+}
+
+/***********************************************************************
+*  progress - report search progress to the application
+*
+*  This routine passes a snapshot of the search progress to the progress
+*  callback every prog_frq milliseconds. If the flag spec is set, the
+*  snapshot is passed regardless of the frequency. */
+
+/***********************************************************************
+*  eval_all_d - compute all reduced costs (partial pricing)
+*
+*  If partial or multiple pricing is used, this routine computes
+*  reduced costs of all non-basic variables using the simplex
+*  multipliers kept in the array work. Otherwise, it does nothing,
+*  because the vector d is always up to date. */
+
+static void eval_all_d(struct csa *csa)
+{     SPXLP *lp = csa->lp;
+      int m = lp->m;
+      int n = lp->n;
+      int j;
+      if (csa->pp != NULL)
+      {  for (j = 1; j <= n-m; j++)
+            csa->d[j] = spx_eval_dj(lp, csa->work, j);
+      }
+      return;
+}
+
+static void progress(struct csa *csa, int spec)
+{     SPXLP *lp = csa->lp;
+      glp_prog prog;
+      double *save;
+      /* check if the progress report should be skipped */
+      if (csa->it_cnt == csa->it_prog) goto skip;
+      if (!spec &&
+         1000.0 * xdifftime(xtime(), csa->tm_prog) < csa->prog_frq)
+         goto skip;
+      prog.phase = csa->phase;
+      prog.it_cnt = csa->it_cnt;
+      /* compute original objective value */
+      save = lp->c;
+      lp->c = csa->c;
+      prog.obj = csa->dir * spx_eval_obj(lp, csa->beta);
+      lp->c = save;
+      prog.pinf = sum_infeas(lp, csa->beta);
+      /* reduced costs are meaningful for original objective only on
+       * phase II */
+      if (csa->phase == 2 && csa->d_st)
+      {  eval_all_d(csa);
+         prog.dinf = sum_dual_infeas(lp, csa->d);
+      }
+      else
+         prog.dinf = 0.0;
+      prog.gap = 0.0;
+      prog.inv_cnt = csa->inv_tot;
+      csa->prog_func(&prog, csa->prog_info);
+      csa->it_prog = csa->it_cnt;
+      csa->tm_prog = xtime();
+skip: return;
+}
+
 /***********************************************************************
 *  display - display search progress
 *
@@ -610,6 +716,9 @@ static double sum_infeas(SPXLP *lp, const double beta[/*1+m*/])
 static void display(struct csa *csa, int spec)
 {     int nnn, k;
       double obj, sum, *save;
+      /* report search progress to the application */
+      if (csa->prog_func != NULL)
+         progress(csa, spec);
       /* check if the display output should be skipped */
       if (csa->msg_lev < GLP_MSG_ON) goto skip;
       if (csa->out_dly > 0 &&
@@ -633,6 +742,7 @@ static void display(struct csa *csa, int spec)
             break;
          case 2:
             xassert(csa->d_st);
+            eval_all_d(csa);
             nnn = spx_chuzc_sel(csa->lp, csa->d, csa->tol_dj,
                csa->tol_dj1, NULL);
             break;
@@ -667,6 +777,9 @@ skip: return;
 *  GLP_ETMLIM
 *     Time limit has been exhausted.
 *
+*  GLP_ESTOP
+*     The search was terminated by the application.
+*
 *  GLP_EFAIL
 *     The solver failed to solve LP instance. */
 
@@ -682,11 +795,12 @@ static int primal_simplex(struct csa *csa)
       double *beta = csa->beta;
       double *d = csa->d;
       SPXSE *se = csa->se;
+      SPXPP *pp = csa->pp;
       int *list = csa->list;
-      double *tcol = csa->tcol;
+      double *tcol = csa->tcol.vec;
       double *trow = csa->trow;
       double *pi = csa->work;
-      double *rho = csa->work;
+      FVS *rho = &csa->rho;
       int msg_lev = csa->msg_lev;
       double tol_bnd = csa->tol_bnd;
       double tol_bnd1 = csa->tol_bnd1;
@@ -699,6 +813,7 @@ loop: /* main loop starts here */
       {  double cond;
          ret = spx_factorize(lp);
          csa->inv_cnt++;
+         csa->inv_tot++;
          if (ret != 0)
          {  if (msg_lev >= GLP_MSG_ERR)
                xprintf("Error: unable to factorize the basis matrix (%d"
@@ -772,8 +887,11 @@ loop: /* main loop starts here */
       /* compute reduced costs of non-basic variables d = (d[j]) */
       if (!csa->d_st)
       {  spx_eval_pi(lp, pi);
-         for (j = 1; j <= n-m; j++)
-            d[j] = spx_eval_dj(lp, pi, j);
+         /* (with partial pricing d[j] are computed on demand) */
+         if (pp == NULL)
+         {  for (j = 1; j <= n-m; j++)
+               d[j] = spx_eval_dj(lp, pi, j);
+         }
          csa->d_st = 1; /* just computed */
       }
       /* reset the reference space, if necessary */
@@ -819,15 +937,39 @@ loop: /* main loop starts here */
          ret = GLP_ETMLIM;
          goto fini;
       }
+      /* check if the search has been terminated by the application */
+      if (csa->stop != NULL && *csa->stop)
+      {  if (csa->beta_st != 1)
+            csa->beta_st = 0;
+         if (csa->d_st != 1)
+            csa->d_st = 0;
+         if (!(csa->beta_st && csa->d_st))
+            goto loop;
+         display(csa, 1);
+         if (msg_lev >= GLP_MSG_ALL)
+            xprintf("SEARCH TERMINATED BY APPLICATION\n");
+         csa->p_stat = (csa->phase == 2 ? GLP_FEAS : GLP_INFEAS);
+         csa->d_stat = GLP_UNDEF; /* will be set below */
+         ret = GLP_ESTOP;
+         goto fini;
+      }
       /* display the search progress */
       display(csa, 0);
       /* select eligible non-basic variables */
       switch (csa->phase)
       {  case 1:
-            csa->num = spx_chuzc_sel(lp, d, 1e-8, 0.0, list);
+            if (pp == NULL)
+               csa->num = spx_chuzc_sel(lp, d, 1e-8, 0.0, list);
+            else
+               csa->num = spx_chuzc_part(lp, pp, pi, d, 1e-8, 0.0,
+                  list);
             break;
          case 2:
-            csa->num = spx_chuzc_sel(lp, d, tol_dj, tol_dj1, list);
+            if (pp == NULL)
+               csa->num = spx_chuzc_sel(lp, d, tol_dj, tol_dj1, list);
+            else
+               csa->num = spx_chuzc_part(lp, pp, pi, d, tol_dj,
+                  tol_dj1, list);
             break;
          default:
             xassert(csa != csa);
@@ -902,35 +1044,51 @@ loop: /* main loop starts here */
          }
       }
       /* update values of basic variables for adjacent basis */
-      spx_update_beta(lp, beta, csa->p, csa->p_flag, csa->q, tcol);
+      spx_update_beta_s(lp, beta, csa->p, csa->p_flag, csa->q,
+         &csa->tcol);
       csa->beta_st = 2;
       /* p < 0 means that xN[q] jumps to its opposite bound */
       if (csa->p < 0)
          goto skip;
       /* xN[q] enters and xB[p] leaves the basis */
       /* compute p-th row of inv(B) */
-      spx_eval_rho(lp, csa->p, rho);
-      /* compute p-th (pivot) row of the simplex table */
-      if (at != NULL)
-         spx_eval_trow1(lp, at, rho, trow);
-      else
-         spx_nt_prod(lp, nt, trow, 1, -1.0, rho);
-      /* FIXME: tcol[p] and trow[q] should be close to each other */
-      xassert(trow[csa->q] != 0.0);
-      /* update reduced costs of non-basic variables for adjacent
-       * basis */
-      if (spx_update_d(lp, d, csa->p, csa->q, trow, tcol) <= 1e-9)
-      {  /* successful updating */
-         csa->d_st = 2;
-         if (csa->phase == 1)
-         {  /* adjust reduced cost of xN[q] in adjacent basis, since
-             * its penalty coefficient changes (see below) */
-            d[csa->q] -= c[head[csa->p]];
+      spx_eval_rho_s(lp, csa->p, rho);
+      if (pp != NULL)
+      {  /* update simplex multipliers for adjacent basis (reduced
+          * costs are computed on demand) */
+         if (spx_update_pi(lp, pi, csa->p, csa->q, d[csa->q], rho,
+            tcol) <= 1e-9)
+         {  /* successful updating */
+            csa->d_st = 2;
+         }
+         else
+         {  /* new simplex multipliers are inaccurate */
+            csa->d_st = 0;
          }
       }
       else
-      {  /* new reduced costs are inaccurate */
-         csa->d_st = 0;
+      {  /* compute p-th (pivot) row of the simplex table */
+         if (at != NULL)
+            spx_eval_trow1_s(lp, at, rho, trow);
+         else
+            spx_nt_prod_s(lp, nt, trow, 1, -1.0, rho);
+         /* FIXME: tcol[p] and trow[q] should be close to each other */
+         xassert(trow[csa->q] != 0.0);
+         /* update reduced costs of non-basic variables for adjacent
+          * basis */
+         if (spx_update_d(lp, d, csa->p, csa->q, trow, tcol) <= 1e-9)
+         {  /* successful updating */
+            csa->d_st = 2;
+            if (csa->phase == 1)
+            {  /* adjust reduced cost of xN[q] in adjacent basis, since
+                * its penalty coefficient changes (see below) */
+               d[csa->q] -= c[head[csa->p]];
+            }
+         }
+         else
+         {  /* new reduced costs are inaccurate */
+            csa->d_st = 0;
+         }
       }
       if (csa->phase == 1)
       {  /* xB[p] leaves the basis replacing xN[q], so set its penalty
@@ -978,6 +1136,12 @@ fini: /* restore original objective function */
          csa->num = spx_chuzc_sel(lp, d, tol_dj, tol_dj1, NULL);
          csa->d_stat = (csa->num == 0 ? GLP_FEAS : GLP_INFEAS);
       }
+      else if (pp != NULL && csa->p_stat != GLP_UNDEF)
+      {  /* with partial pricing some reduced costs may be out of date,
+          * so compute all of them for the final basis */
+         spx_eval_pi(lp, pi);
+         eval_all_d(csa);
+      }
       return ret;
 }
 
@@ -991,6 +1155,7 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       SPXNT nt;
 #endif
       SPXSE se;
+      SPXPP pp;
       int ret, *map, *daeh;
       /* build working LP and its initial basis */
       memset(csa, 0, sizeof(struct csa));
@@ -1016,15 +1181,23 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       /* build matrix A in row-wise format */
       csa->at = &at;
       csa->nt = NULL;
-      spx_alloc_at(csa->lp, csa->at);
-      spx_build_at(csa->lp, csa->at);
+      if (!spx_take_at(csa->lp, P, csa->at))
+      {  spx_alloc_at(csa->lp, csa->at);
+         spx_build_at(csa->lp, csa->at);
+      }
 #else
-      /* build matrix N in row-wise format for initial basis */
+      /* build matrix N in row-wise format for initial basis (it is
+       * not needed for partial pricing, which never computes rows of
+       * the simplex table) */
       csa->at = NULL;
-      csa->nt = &nt;
-      spx_alloc_nt(csa->lp, csa->nt);
-      spx_init_nt(csa->lp, csa->nt);
-      spx_build_nt(csa->lp, csa->nt);
+      if (parm->pricing == GLP_PT_PART || parm->pricing == GLP_PT_MULT)
+         csa->nt = NULL;
+      else
+      {  csa->nt = &nt;
+         spx_alloc_nt(csa->lp, csa->nt);
+         spx_init_nt(csa->lp, csa->nt);
+         spx_build_nt(csa->lp, csa->nt);
+      }
 #endif
       /* allocate and initialize working components */
       csa->phase = 0;
@@ -1039,13 +1212,21 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
          case GLP_PT_PSE:
             csa->se = &se;
             spx_alloc_se(csa->lp, csa->se);
+            se.par = spx_par_create(parm->nthreads);
+            break;
+         case GLP_PT_PART:
+         case GLP_PT_MULT:
+            csa->se = NULL;
+            csa->pp = &pp;
+            spx_alloc_pp(csa->lp, csa->pp, parm->pricing == GLP_PT_MULT);
             break;
          default:
             xassert(parm != parm);
       }
       csa->list = talloc(1+csa->lp->n-csa->lp->m, int);
-      csa->tcol = talloc(1+csa->lp->m, double);
+      fvs_alloc_vec(&csa->tcol, csa->lp->m);
       csa->trow = talloc(1+csa->lp->n-csa->lp->m, double);
+      fvs_alloc_vec(&csa->rho, csa->lp->m);
       csa->work = talloc(1+csa->lp->m, double);
       /* initialize control parameters */
       csa->msg_lev = parm->msg_lev;
@@ -1054,6 +1235,8 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
             csa->harris = 0;
             break;
          case GLP_RT_HAR:
+         case GLP_RT_FLIP:
+            /* long-step ratio test is used by dual simplex only */
             csa->harris = 1;
             break;
          default:
@@ -1066,6 +1249,10 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       csa->tol_piv = parm->tol_piv;
       csa->it_lim = parm->it_lim;
       csa->tm_lim = parm->tm_lim;
+      csa->stop = parm->stop;
+      csa->prog_func = parm->prog_func;
+      csa->prog_info = parm->prog_info;
+      csa->prog_frq = parm->prog_frq;
       csa->out_frq = parm->out_frq;
       csa->out_dly = parm->out_dly;
       /* initialize working parameters */
@@ -1073,6 +1260,9 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
       csa->it_beg = csa->it_cnt = P->it_cnt;
       csa->it_dpy = -1;
       csa->inv_cnt = 0;
+      csa->inv_tot = 0;
+      csa->tm_prog = csa->tm_beg;
+      csa->it_prog = -1;
       /* try to solve working LP */
       ret = primal_simplex(csa);
       /* return basis factorization back to problem object */
@@ -1116,7 +1306,11 @@ int spx_primal(glp_prob *P, const glp_smcp *parm)
          }
          xassert(P->some != 0);
       }
-skip: /* deallocate working objects and arrays */
+skip: /* keep constraint matrix of working LP to reuse it in the
+       * next call (optionally) */
+      if (P->compact)
+         spx_keep_lp(csa->lp, P, EXCL, map, csa->at);
+      /* deallocate working objects and arrays */
       spx_free_lp(csa->lp);
       tfree(map);
       tfree(csa->c);
@@ -1128,9 +1322,12 @@ skip: /* deallocate working objects and arrays */
       tfree(csa->d);
       if (csa->se != NULL)
          spx_free_se(csa->lp, csa->se);
+      if (csa->pp != NULL)
+         spx_free_pp(csa->lp, csa->pp);
       tfree(csa->list);
-      tfree(csa->tcol);
+      fvs_free_vec(&csa->tcol);
       tfree(csa->trow);
+      fvs_free_vec(&csa->rho);
       tfree(csa->work);
       /* return to calling program */
       return ret;
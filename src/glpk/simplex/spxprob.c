@@ -34,10 +34,35 @@
 *  (The working LP object should be allocated by the calling routine.)
 *
 *  If the flag excl is set, the routine assumes that non-basic fixed
-*  variables will be excluded from the working LP. */
+*  variables will be excluded from the working LP.
+*
+*  If the problem object keeps the constraint matrix of the working LP
+*  built by a previous call to the solver (see spx_keep_lp), and the
+*  same original variables are included in the working LP, the routine
+*  attaches that matrix to the working LP object, so the routines
+*  spx_alloc_lp and spx_build_lp do not allocate and build it again.
+*  Otherwise, the kept matrix is dropped as out of date. */
+
+static int same_wlp(glp_prob *P, int excl)
+{     /* check if kept working LP has the same variables */
+      GLPWLP *wlp = P->wlp;
+      int i, j;
+      if (wlp->excl != excl)
+         return 0;
+      for (i = 1; i <= P->m; i++)
+      {  if (wlp->incl[i] != !(excl && P->row[i]->stat == GLP_NS))
+            return 0;
+      }
+      for (j = 1; j <= P->n; j++)
+      {  if (wlp->incl[P->m+j] != !(excl && P->col[j]->stat == GLP_NS))
+            return 0;
+      }
+      return 1;
+}
 
 void spx_init_lp(SPXLP *lp, glp_prob *P, int excl)
-{     int i, j, m, n, nnz;
+{     GLPCSM *csc = prob_csc(P, 1);
+      int i, j, m, n, nnz;
       m = P->m;
       xassert(m > 0);
       n = 0;
@@ -62,8 +87,11 @@ void spx_init_lp(SPXLP *lp, glp_prob *P, int excl)
          if (excl && col->stat == GLP_NS)
          {  /* skip non-basic fixed structural variable */
             GLPAIJ *aij;
-            for (aij = col->ptr; aij != NULL; aij = aij->c_next)
-               nnz--;
+            if (csc != NULL)
+               nnz -= csc->ptr[j+1] - csc->ptr[j];
+            else
+               for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+                  nnz--;
          }
          else
          {  /* include structural variable in working LP */
@@ -76,6 +104,19 @@ void spx_init_lp(SPXLP *lp, glp_prob *P, int excl)
       xassert(n > 0);
       lp->n = n;
       lp->nnz = nnz;
+      /* attach kept constraint matrix, if possible */
+      if (P->wlp != NULL)
+      {  if (same_wlp(P, excl))
+         {  xassert(P->wlp->A->len == n);
+            xassert(P->wlp->A->ptr[n+1] == nnz+1);
+            lp->A_ptr = P->wlp->A->ptr;
+            lp->A_ind = P->wlp->A->ind;
+            lp->A_val = P->wlp->A->val;
+            lp->kept = 1;
+         }
+         else
+            prob_drop_wlp(P);
+      }
       return;
 }
 
@@ -83,15 +124,18 @@ void spx_init_lp(SPXLP *lp, glp_prob *P, int excl)
 *  spx_alloc_lp - allocate working LP arrays
 *
 *  This routine allocates the memory for all arrays in the working LP
-*  object. */
+*  object (except the constraint matrix, if it is kept in the original
+*  problem object). */
 
 void spx_alloc_lp(SPXLP *lp)
 {     int m = lp->m;
       int n = lp->n;
       int nnz = lp->nnz;
-      lp->A_ptr = talloc(1+n+1, int);
-      lp->A_ind = talloc(1+nnz, int);
-      lp->A_val = talloc(1+nnz, double);
+      if (!lp->kept)
+      {  lp->A_ptr = talloc(1+n+1, int);
+         lp->A_ind = talloc(1+nnz, int);
+         lp->A_val = talloc(1+nnz, double);
+      }
       lp->b = talloc(1+m, double);
       lp->c = talloc(1+n, double);
       lp->l = talloc(1+n, double);
@@ -110,6 +154,11 @@ void spx_alloc_lp(SPXLP *lp)
 *  routine changes the signs of the objective coefficients and constant
 *  term to opposite ones.
 *
+*  If the constraint matrix of the working LP is kept in the original
+*  problem object (see spx_init_lp), only the other components are
+*  converted, which takes O(m+n) time, plus the time needed to process
+*  the columns of excluded variables.
+*
 *  If the flag excl is set, original non-basic fixed variables are
 *  *not* included in the working LP. Otherwise, all (auxiliary and
 *  structural) original variables are included in the working LP. Note
@@ -152,7 +201,9 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
       double *c = lp->c;
       double *l = lp->l;
       double *u = lp->u;
-      int i, j, k, kk, ptr, end;
+      GLPCSM *csc = prob_csc(P, 1);
+      double *rii = NULL;
+      int i, j, k, kk, ptr, end, t;
       double dir, delta;
       /* working LP is always minimization */
       switch (P->dir)
@@ -185,10 +236,14 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
             map[i] = ++k;
             /* setup k-th column of working constraint matrix which is
              * i-th column of unity matrix */
-            A_ptr[k] = ptr;
-            A_ind[ptr] = i;
-            A_val[ptr] = 1.0;
-            ptr++;
+            if (lp->kept)
+               ptr = A_ptr[k+1];
+            else
+            {  A_ptr[k] = ptr;
+               A_ind[ptr] = i;
+               A_val[ptr] = 1.0;
+               ptr++;
+            }
             /* initialize right-hand side of i-th equality constraint
              * and setup zero objective coefficient at variable x[k] */
             b[i] = c[k] = 0.0;
@@ -216,6 +271,14 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
          }
       }
       /* process columns of original LP */
+      if (csc != NULL)
+      {  /* columns are taken from the compact storage; row scale
+          * factors are gathered once, so the rows are not visited for
+          * every element */
+         rii = talloc(1+m, double);
+         for (i = 1; i <= m; i++)
+            rii[i] = P->row[i]->rii;
+      }
       for (j = 1; j <= P->n; j++)
       {  GLPCOL *col = P->col[j];
          GLPAIJ *aij;
@@ -226,9 +289,17 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
             map[m+j] = 0;
             if (col->lb != 0.0)
             {  /* (note that sjj scale factor is cancelled) */
-               for (aij = col->ptr; aij != NULL; aij = aij->c_next)
-                  b[aij->row->i] +=
-                     (aij->row->rii * aij->val) * col->lb;
+               if (csc != NULL)
+               {  for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+                  {  i = csc->ind[t];
+                     b[i] += (rii[i] * csc->val[t]) * col->lb;
+                  }
+               }
+               else
+               {  for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+                     b[aij->row->i] +=
+                        (aij->row->rii * aij->val) * col->lb;
+               }
                c[0] += (dir * col->coef) * col->lb;
             }
          }
@@ -237,11 +308,23 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
             map[m+j] = ++k;
             /* setup k-th column of working constraint matrix which is
              * scaled j-th column of original constraint matrix (-A) */
-            A_ptr[k] = ptr;
-            for (aij = col->ptr; aij != NULL; aij = aij->c_next)
-            {  A_ind[ptr] = aij->row->i;
-               A_val[ptr] = - aij->row->rii * aij->val * col->sjj;
-               ptr++;
+            if (lp->kept)
+               ptr = A_ptr[k+1];
+            else if (csc != NULL)
+            {  A_ptr[k] = ptr;
+               for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+               {  A_ind[ptr] = i = csc->ind[t];
+                  A_val[ptr] = - rii[i] * csc->val[t] * col->sjj;
+                  ptr++;
+               }
+            }
+            else
+            {  A_ptr[k] = ptr;
+               for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+               {  A_ind[ptr] = aij->row->i;
+                  A_val[ptr] = - aij->row->rii * aij->val * col->sjj;
+                  ptr++;
+               }
             }
             /* setup scaled objective coefficient at variable x[k] */
             c[k] = dir * col->coef * col->sjj;
@@ -268,9 +351,12 @@ void spx_build_lp(SPXLP *lp, glp_prob *P, int excl, int shift,
             }
          }
       }
+      if (rii != NULL)
+         tfree(rii);
       xassert(k == n);
       xassert(ptr == nnz+1);
-      A_ptr[n+1] = ptr;
+      if (!lp->kept)
+         A_ptr[n+1] = ptr;
       /* shift bounds of all variables of working LP (optionally) */
       if (shift)
       {  for (kk = 1; kk <= m+P->n; kk++)
@@ -632,8 +718,18 @@ void spx_store_sol(SPXLP *lp, glp_prob *P, int shift,
              * would be non-basic in working LP */
             /* (note that sjj scale factor is cancelled) */
             dk = dir * col->coef;
-            for (aij = col->ptr; aij != NULL; aij = aij->c_next)
-               dk += (aij->row->rii * aij->val) * pi[aij->row->i];
+            if (P->csc != NULL)
+            {  /* the matrix may be shared, so use its copy */
+               GLPCSM *csc = P->csc;
+               int t;
+               for (t = csc->ptr[j]; t < csc->ptr[j+1]; t++)
+                  dk += (P->row[csc->ind[t]]->rii * csc->val[t]) *
+                     pi[csc->ind[t]];
+            }
+            else
+            {  for (aij = col->ptr; aij != NULL; aij = aij->c_next)
+                  dk += (aij->row->rii * aij->val) * pi[aij->row->i];
+            }
             col->dual = dir * dk;
          }
          else
@@ -657,16 +753,103 @@ void spx_store_sol(SPXLP *lp, glp_prob *P, int shift,
       return;
 }
 
+/***********************************************************************
+*  spx_take_at - attach kept row-wise constraint matrix
+*
+*  If the constraint matrix of the working LP is kept in the original
+*  problem object along with its row-wise copy, this routine attaches
+*  the copy to the object at, allocates its working array, and returns
+*  non-zero. Otherwise, the routine returns zero, in which case the
+*  object at should be allocated and built as usual. */
+
+int spx_take_at(SPXLP *lp, glp_prob *P, SPXAT *at)
+{     if (!(lp->kept && P->wlp->AT != NULL))
+         return 0;
+      at->ptr = P->wlp->AT->ptr;
+      at->ind = P->wlp->AT->ind;
+      at->val = P->wlp->AT->val;
+      at->work = talloc(1+lp->n, double);
+      return 1;
+}
+
+/***********************************************************************
+*  spx_keep_lp - keep constraint matrix in original problem object
+*
+*  This routine passes the constraint matrix of the working LP (and its
+*  row-wise copy at, if specified) to the original problem object to be
+*  reused by the next call to the solver, while the matrix, the scale
+*  factors and the set of original variables included in the working
+*  LP remain the same (see spx_init_lp). The routine should be called
+*  after the working LP has been solved, only if the compact storage is
+*  enabled (see glp_compact_matrix).
+*
+*  On exit the flag lp->kept is set, so the routines spx_free_lp and
+*  spx_free_at free only the arrays not passed to the problem object.
+*
+*  The parameters excl and map should be the same as in calls to the
+*  routines spx_init_lp and spx_build_lp. */
+
+static GLPCSM *make_csm(int len, int *ptr, int *ind, double *val)
+{     /* wrap arrays of working LP into compact matrix */
+      GLPCSM *csm;
+      csm = talloc(1, GLPCSM);
+      csm->len = len;
+      csm->ptr = ptr;
+      csm->ind = ind;
+      csm->val = val;
+      return csm;
+}
+
+void spx_keep_lp(SPXLP *lp, glp_prob *P, int excl, const int map[],
+      SPXAT *at)
+{     GLPWLP *wlp;
+      int kk;
+      xassert(P->compact);
+      if (!lp->kept)
+      {  /* pass matrix A to problem object */
+         prob_drop_wlp(P);
+         P->wlp = wlp = talloc(1, GLPWLP);
+         wlp->excl = excl;
+         wlp->incl = talloc(1+P->m+P->n, char);
+         wlp->incl[0] = 0;
+         for (kk = 1; kk <= P->m+P->n; kk++)
+            wlp->incl[kk] = (char)(map[kk] != 0);
+         wlp->A = make_csm(lp->n, lp->A_ptr, lp->A_ind, lp->A_val);
+         wlp->AT = NULL;
+         lp->kept = 1;
+         /* row-wise copy, if any, is passed below */
+      }
+      else
+      {  /* matrix A is already kept */
+         wlp = P->wlp;
+         xassert(wlp != NULL && wlp->A->ptr == lp->A_ptr);
+      }
+      if (at != NULL)
+      {  if (wlp->AT == NULL)
+         {  /* pass row-wise copy to problem object */
+            wlp->AT = make_csm(lp->m, at->ptr, at->ind, at->val);
+         }
+         else
+         {  /* row-wise copy is already kept */
+            xassert(wlp->AT->ptr == at->ptr);
+         }
+      }
+      return;
+}
+
 /***********************************************************************
 *  spx_free_lp - deallocate working LP arrays
 *
 *  This routine deallocates the memory used for arrays of the working
-*  LP object. */
+*  LP object (except the constraint matrix, if it is kept in the
+*  original problem object). */
 
 void spx_free_lp(SPXLP *lp)
-{     tfree(lp->A_ptr);
-      tfree(lp->A_ind);
-      tfree(lp->A_val);
+{     if (!lp->kept)
+      {  tfree(lp->A_ptr);
+         tfree(lp->A_ind);
+         tfree(lp->A_val);
+      }
       tfree(lp->b);
       tfree(lp->c);
       tfree(lp->l);
@@ -25,7 +25,7 @@
 #define SPXPROB_H
 
 #include "prob.h"
-#include "spxlp.h"
+#include "spxat.h"
 
 #define spx_init_lp _glp_spx_init_lp
 void spx_init_lp(SPXLP *lp, glp_prob *P, int excl);
@@ -55,6 +55,15 @@ void spx_store_sol(SPXLP *lp, glp_prob *P, int shift,
       const double pi[], const double d[]);
 /* convert working LP solution to original LP solution */
 
+#define spx_take_at _glp_spx_take_at
+int spx_take_at(SPXLP *lp, glp_prob *P, SPXAT *at);
+/* attach kept row-wise constraint matrix */
+
+#define spx_keep_lp _glp_spx_keep_lp
+void spx_keep_lp(SPXLP *lp, glp_prob *P, int excl, const int map[],
+      SPXAT *at);
+/* keep constraint matrix in original problem object */
+
 #define spx_free_lp _glp_spx_free_lp
 void spx_free_lp(SPXLP *lp);
 /* deallocate working LP arrays */
@@ -0,0 +1,243 @@
+/* spxvec.c */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  Copyright (C) 2015 Andrew Makhorin, Department for Applied
+*  Informatics, Moscow Aviation Institute, Moscow, Russia. All rights
+*  reserved. E-mail: <mao@gnu.org>.
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "spxvec.h"
+
+/***********************************************************************
+*  This module contains vector kernels used in the inner loops of the
+*  simplex solvers.
+*
+*  On x86 processors, if the code is compiled with GCC or Clang, every
+*  kernel has AVX2 and/or AVX-512 versions, which are chosen at run time
+*  depending on the instruction set supported by the processor. (The
+*  vector versions can be disabled by defining the macro SPX_NO_SIMD.)
+*  Otherwise, only the scalar versions are used.
+*
+*  All versions of a kernel produce bit-for-bit identical results, so
+*  the sequence of simplex iterations does not depend on the processor:
+*  products and sums are never fused, and inner products are summed up
+*  in the same order by the scalar and vector versions. */
+
+#if (defined(__GNUC__) && __GNUC__ >= 5 || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__)) && !defined(SPX_NO_SIMD)
+#define SIMD 1
+/* AVX-512 implies FMA, so the compiler must not fuse a*b+c */
+#ifdef __clang__
+#pragma STDC FP_CONTRACT OFF
+#else
+#pragma GCC optimize("fp-contract=off")
+#endif
+#include <immintrin.h>
+#define AVX2 __attribute__((target("avx2")))
+#define AVX512 __attribute__((target("avx512f")))
+#else
+#define SIMD 0
+#endif
+
+/***********************************************************************
+*  spx_vec_isa - determine instruction set used by vector kernels
+*
+*  This routine returns 2 if the kernels use AVX-512 instructions, 1 if
+*  they use AVX2 instructions, and 0 if only scalar code is used. */
+
+int spx_vec_isa(void)
+{
+#if SIMD
+      if (__builtin_cpu_supports("avx512f"))
+         return 2;
+      if (__builtin_cpu_supports("avx2"))
+         return 1;
+#endif
+      return 0;
+}
+
+/***********************************************************************
+*  spx_vec_axpy - compute dense update y := y + s * x
+*
+*  This routine computes y[k] := y[k] + s * x[k] for k = 1, ..., n. */
+
+#if SIMD
+AVX2 static void axpy_avx2(int n, double y[], double s,
+      const double x[])
+{     __m256d vs = _mm256_set1_pd(s);
+      int k;
+      for (k = 1; k+3 <= n; k += 4)
+         _mm256_storeu_pd(&y[k], _mm256_add_pd(_mm256_loadu_pd(&y[k]),
+            _mm256_mul_pd(_mm256_loadu_pd(&x[k]), vs)));
+      for (; k <= n; k++)
+         y[k] += x[k] * s;
+      return;
+}
+
+AVX512 static void axpy_avx512(int n, double y[], double s,
+      const double x[])
+{     __m512d vs = _mm512_set1_pd(s);
+      int k;
+      for (k = 1; k+7 <= n; k += 8)
+         _mm512_storeu_pd(&y[k], _mm512_add_pd(_mm512_loadu_pd(&y[k]),
+            _mm512_mul_pd(_mm512_loadu_pd(&x[k]), vs)));
+      for (; k <= n; k++)
+         y[k] += x[k] * s;
+      return;
+}
+#endif
+
+void spx_vec_axpy(int n, double y[/*1+n*/], double s,
+      const double x[/*1+n*/])
+{     int k;
+#if SIMD
+      switch (spx_vec_isa())
+      {  case 2:
+            axpy_avx512(n, y, s, x);
+            return;
+         case 1:
+            axpy_avx2(n, y, s, x);
+            return;
+      }
+#endif
+      for (k = 1; k <= n; k++)
+         y[k] += x[k] * s;
+      return;
+}
+
+/***********************************************************************
+*  spx_vec_scatter - compute sparse update y := y + s * v
+*
+*  This routine computes y[ind[k]] := y[ind[k]] + s * val[k] for
+*  k = ptr, ..., end-1, i.e. adds a sparse vector v multiplied by s to
+*  the dense vector y. The indices ind[ptr], ..., ind[end-1] must be
+*  distinct (as in a row or column of a sparse matrix). */
+
+#if SIMD
+AVX2 static void scatter_avx2(int ptr, int end, const int ind[],
+      const double val[], double s, double y[])
+{     __m256d vs = _mm256_set1_pd(s);
+      double t[4];
+      for (; ptr+3 < end; ptr += 4)
+      {  __m256d vy = _mm256_i32gather_pd(y,
+            _mm_loadu_si128((const __m128i *)&ind[ptr]), 8);
+         _mm256_storeu_pd(t, _mm256_add_pd(vy,
+            _mm256_mul_pd(_mm256_loadu_pd(&val[ptr]), vs)));
+         y[ind[ptr]] = t[0];
+         y[ind[ptr+1]] = t[1];
+         y[ind[ptr+2]] = t[2];
+         y[ind[ptr+3]] = t[3];
+      }
+      for (; ptr < end; ptr++)
+         y[ind[ptr]] += val[ptr] * s;
+      return;
+}
+
+AVX512 static void scatter_avx512(int ptr, int end, const int ind[],
+      const double val[], double s, double y[])
+{     __m512d vs = _mm512_set1_pd(s);
+      for (; ptr+7 < end; ptr += 8)
+      {  __m256i vi = _mm256_loadu_si256((const __m256i *)&ind[ptr]);
+         __m512d vy = _mm512_i32gather_pd(vi, y, 8);
+         vy = _mm512_add_pd(vy,
+            _mm512_mul_pd(_mm512_loadu_pd(&val[ptr]), vs));
+         _mm512_i32scatter_pd(y, vi, vy, 8);
+      }
+      for (; ptr < end; ptr++)
+         y[ind[ptr]] += val[ptr] * s;
+      return;
+}
+#endif
+
+void spx_vec_scatter(int ptr, int end, const int ind[],
+      const double val[], double s, double y[])
+{
+#if SIMD
+      if (end - ptr >= 4)
+      {  switch (spx_vec_isa())
+         {  case 2:
+               scatter_avx512(ptr, end, ind, val, s, y);
+               return;
+            case 1:
+               scatter_avx2(ptr, end, ind, val, s, y);
+               return;
+         }
+      }
+#endif
+      for (; ptr < end; ptr++)
+         y[ind[ptr]] += val[ptr] * s;
+      return;
+}
+
+/***********************************************************************
+*  spx_vec_gdot - compute sparse inner product v'* x
+*
+*  This routine computes the sum of val[k] * x[ind[k]] for k = ptr,
+*  ..., end-1, i.e. the inner product of a sparse vector v and a dense
+*  vector x.
+*
+*  Short vectors (less than 8 elements) are summed up sequentially.
+*  For longer vectors the products are accumulated in four partial
+*  sums (the k-th product goes to partial sum (k - ptr) mod 4), which
+*  are then added pairwise, and the remaining 0 to 3 products are added
+*  to the result sequentially. */
+
+#if SIMD
+AVX2 static double gdot_avx2(int ptr, int end, const int ind[],
+      const double val[], const double x[])
+{     __m256d acc = _mm256_setzero_pd();
+      double t[4], sum;
+      for (; ptr+3 < end; ptr += 4)
+         acc = _mm256_add_pd(acc, _mm256_mul_pd(
+            _mm256_loadu_pd(&val[ptr]), _mm256_i32gather_pd(x,
+            _mm_loadu_si128((const __m128i *)&ind[ptr]), 8)));
+      _mm256_storeu_pd(t, acc);
+      sum = (t[0] + t[1]) + (t[2] + t[3]);
+      for (; ptr < end; ptr++)
+         sum += val[ptr] * x[ind[ptr]];
+      return sum;
+}
+#endif
+
+double spx_vec_gdot(int ptr, int end, const int ind[],
+      const double val[], const double x[])
+{     double t[4], sum;
+      if (end - ptr < 8)
+      {  sum = 0.0;
+         for (; ptr < end; ptr++)
+            sum += val[ptr] * x[ind[ptr]];
+         return sum;
+      }
+#if SIMD
+      if (spx_vec_isa() > 0)
+         return gdot_avx2(ptr, end, ind, val, x);
+#endif
+      t[0] = t[1] = t[2] = t[3] = 0.0;
+      for (; ptr+3 < end; ptr += 4)
+      {  t[0] += val[ptr] * x[ind[ptr]];
+         t[1] += val[ptr+1] * x[ind[ptr+1]];
+         t[2] += val[ptr+2] * x[ind[ptr+2]];
+         t[3] += val[ptr+3] * x[ind[ptr+3]];
+      }
+      sum = (t[0] + t[1]) + (t[2] + t[3]);
+      for (; ptr < end; ptr++)
+         sum += val[ptr] * x[ind[ptr]];
+      return sum;
+}
+
+/* eof */
@@ -0,0 +1,48 @@
+/* spxvec.h */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  Copyright (C) 2015 Andrew Makhorin, Department for Applied
+*  Informatics, Moscow Aviation Institute, Moscow, Russia. All rights
+*  reserved. E-mail: <mao@gnu.org>.
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#ifndef SPXVEC_H
+#define SPXVEC_H
+
+#define spx_vec_isa _glp_spx_vec_isa
+int spx_vec_isa(void);
+/* determine instruction set used by vector kernels */
+
+#define spx_vec_axpy _glp_spx_vec_axpy
+void spx_vec_axpy(int n, double y[/*1+n*/], double s,
+      const double x[/*1+n*/]);
+/* compute dense update y := y + s * x */
+
+#define spx_vec_scatter _glp_spx_vec_scatter
+void spx_vec_scatter(int ptr, int end, const int ind[],
+      const double val[], double s, double y[]);
+/* compute sparse update y := y + s * v */
+
+#define spx_vec_gdot _glp_spx_vec_gdot
+double spx_vec_gdot(int ptr, int end, const int ind[],
+      const double val[], const double x[]);
+/* compute sparse inner product v'* x */
+
+#endif
+
+/* eof */
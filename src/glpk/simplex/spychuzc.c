@@ -219,4 +219,180 @@ int spy_chuzc_harris(SPXLP *lp, const double d[/*1+n-m*/],
 done: return q;
 }
 
+/***********************************************************************
+*  spy_chuzc_flip - choose non-basic var. (dual long-step ratio test)
+*
+*  This routine implements the dual long-step (bound flipping) ratio
+*  test to choose non-basic variable xN[q].
+*
+*  The parameters d, trow, tol_piv, tol, and tol1 have the same meaning
+*  as for the routine spy_chuzc_std (see above).
+*
+*  The parameter r specifies the bound violation of basic variable
+*  xB[p] chosen: r = lB[p] - beta[p] > 0 if xB[p] violates its lower
+*  bound, and r = uB[p] - beta[p] < 0 if it violates its upper bound.
+*  (Thus, s = sign(r) has the same meaning as in spy_chuzc_std.)
+*
+*  On increasing the dual ray parameter theta the dual objective grows
+*  with the slope |r| until the first dual basic variable lambdaN[j]
+*  reaches its zero bound. If xN[j] is double-bounded, the dual ray may
+*  pass over this breakpoint, provided that xN[j] is flipped to its
+*  opposite bound, which decreases the slope by |t[p,j]| * (u[j] -
+*  l[j]). The routine passes over breakpoints in increasing order of
+*  theta while the slope remains positive, and chooses xN[q] at the
+*  breakpoint, where the slope would become non-positive or where the
+*  variable cannot be flipped.
+*
+*  The pivot at that breakpoint may be very small, so Harris' technique
+*  is applied to the breakpoints not passed over: the routine chooses
+*  the one having the largest |t[p,j]| among those, whose theta does not
+*  exceed the smallest relaxed theta, at which some reduced cost would
+*  violate its zero bound by its tolerance. If the pivot chosen is still
+*  less than 0.001 in magnitude (the threshold used by the dual simplex
+*  to try another basic variable), the routine performs the ratio test
+*  without flips (see spy_chuzc_harris) and uses its choice, if the
+*  pivot is larger.
+*
+*  The array bp is a working array. On exit the routine stores indices
+*  j of non-basic variables xN[j], which should be flipped to their
+*  opposite bounds before changing the basis, in bp[1].j, ...,
+*  bp[nflip].j and returns q. If lambdaN[j] cannot reach zero for any
+*  j, the routine returns zero, and nflip is set to zero.
+*
+*  To avoid sorting all breakpoints, they are sorted by portions: only
+*  breakpoints with theta not exceeding some limit are sorted, and the
+*  limit is doubled if the slope remains positive after passing over
+*  all of them. */
+
+static int fcmp(const void *x1, const void *x2)
+{     /* order breakpoints by increasing theta, then by decreasing
+       * magnitude of the pivot */
+      const SPYBP *bp1 = x1, *bp2 = x2;
+      if (bp1->teta < bp2->teta)
+         return -1;
+      if (bp1->teta > bp2->teta)
+         return +1;
+      if (bp1->alfa > bp2->alfa)
+         return -1;
+      if (bp1->alfa < bp2->alfa)
+         return +1;
+      return 0;
+}
+
+int spy_chuzc_flip(SPXLP *lp, const double d[/*1+n-m*/],
+      double r, const double trow[/*1+n-m*/], double tol_piv,
+      double tol, double tol1, SPYBP bp[/*1+n-m*/], int *nflip)
+{     int m = lp->m;
+      int n = lp->n;
+      double *c = lp->c;
+      double *l = lp->l;
+      double *u = lp->u;
+      int *head = lp->head;
+      char *flag = lp->flag;
+      int j, k, q, t, tt, nbp, num1, num2;
+      double s, alfa, delta, teta, tmax, teta_lim, slope;
+      SPYBP tmp;
+      xassert(r != 0.0);
+      s = (r > 0.0 ? +1.0 : -1.0);
+      /* determine breakpoints (as in spy_chuzc_std) */
+      nbp = 0, teta_lim = DBL_MAX;
+      for (j = 1; j <= n-m; j++)
+      {  k = head[m+j]; /* x[k] = xN[j] */
+         /* if xN[j] is fixed variable, skip it */
+         if (l[k] == u[k])
+            continue;
+         alfa = s * trow[j];
+         if (alfa >= +tol_piv && !flag[j])
+         {  /* lambdaN[j] = d[j] >= 0 decreases down to zero */
+            delta = tol + tol1 * (c[k] >= 0.0 ? +c[k] : -c[k]);
+            teta = (d[j] < +delta ? 0.0 : d[j] / alfa);
+            tmax = (d[j] + delta) / alfa;
+         }
+         else if (alfa <= -tol_piv && (l[k] == -DBL_MAX || flag[j]))
+         {  /* lambdaN[j] = d[j] <= 0 increases up to zero */
+            delta = tol + tol1 * (c[k] >= 0.0 ? +c[k] : -c[k]);
+            teta = (d[j] > -delta ? 0.0 : d[j] / alfa);
+            tmax = (d[j] - delta) / alfa;
+         }
+         else
+         {  /* lambdaN[j] cannot reach zero on increasing theta */
+            continue;
+         }
+         xassert(teta >= 0.0);
+         alfa = (alfa >= 0.0 ? +alfa : -alfa);
+         nbp++;
+         bp[nbp].j = j;
+         bp[nbp].teta = teta;
+         bp[nbp].alfa = alfa;
+         bp[nbp].tmax = (tmax > teta ? tmax : teta);
+         if (l[k] == -DBL_MAX || u[k] == +DBL_MAX)
+            bp[nbp].dz = DBL_MAX;
+         else
+            bp[nbp].dz = alfa * (u[k] - l[k]);
+         if (teta_lim > teta)
+            teta_lim = teta;
+      }
+      if (nbp == 0)
+      {  /* theta may increase unlimitedly */
+         *nflip = 0;
+         return 0;
+      }
+      /* pass over breakpoints while the slope remains positive */
+      slope = (r >= 0.0 ? +r : -r);
+      if (teta_lim < 1e-3)
+         teta_lim = 1e-3;
+      num1 = 0;
+      for (;;)
+      {  /* move breakpoints with theta <= teta_lim to locations
+          * num1+1, ..., num2 and sort them */
+         num2 = num1;
+         for (t = num1+1; t <= nbp; t++)
+         {  if (bp[t].teta <= teta_lim)
+            {  num2++;
+               tmp = bp[num2], bp[num2] = bp[t], bp[t] = tmp;
+            }
+         }
+         if (num2 - num1 > 1)
+            qsort(&bp[num1+1], num2 - num1, sizeof(SPYBP), fcmp);
+         for (t = num1+1; t <= num2; t++)
+         {  if (bp[t].dz >= slope)
+               goto stop;
+            slope -= bp[t].dz;
+         }
+         num1 = num2;
+         if (num1 == nbp)
+         {  /* the slope remains positive after passing over all
+             * breakpoints; choose the last one */
+            t = nbp;
+            goto stop;
+         }
+         teta_lim *= 2.0;
+      }
+stop: /* prefer the first (best) breakpoint among ones with the same
+       * theta; all breakpoints before it are passed over */
+      while (t > 1 && bp[t-1].teta == bp[t].teta)
+         t--;
+      *nflip = t-1;
+      /* apply Harris' technique to breakpoints not passed over */
+      tmax = DBL_MAX;
+      for (tt = t; tt <= nbp; tt++)
+      {  if (tmax > bp[tt].tmax)
+            tmax = bp[tt].tmax;
+      }
+      q = t;
+      for (tt = t+1; tt <= nbp; tt++)
+      {  if (bp[tt].teta <= tmax && bp[q].alfa < bp[tt].alfa)
+            q = tt;
+      }
+      if (bp[q].alfa < 0.001)
+      {  /* the pivot is small; try the ratio test without flips */
+         j = spy_chuzc_harris(lp, d, s, trow, tol_piv, tol, tol1);
+         if (j != 0 && fabs(trow[j]) > bp[q].alfa)
+         {  *nflip = 0;
+            return j;
+         }
+      }
+      return bp[q].j;
+}
+
 /* eof */
@@ -38,6 +38,32 @@ int spy_chuzc_harris(SPXLP *lp, const double d[/*1+n-m*/],
       double tol, double tol1);
 /* choose non-basic variable (dual Harris' ratio test) */
 
+typedef struct SPYBP SPYBP;
+
+struct SPYBP
+{     /* breakpoint of the dual objective along the dual ray */
+      int j;
+      /* dual basic variable lambdaN[j], 1 <= j <= n-m, reaches its
+       * zero bound at this breakpoint */
+      double teta;
+      /* value of the dual ray parameter theta >= 0 at this breakpoint */
+      double alfa;
+      /* |t[p,j]|, the magnitude of the pivot candidate */
+      double tmax;
+      /* relaxed value of theta, at which lambdaN[j] violates its zero
+       * bound by its tolerance (used in Harris' technique) */
+      double dz;
+      /* decrease of the dual objective slope when passing over this
+       * breakpoint by flipping xN[j] to its opposite bound; DBL_MAX if
+       * xN[j] is not double-bounded and so cannot be flipped */
+};
+
+#define spy_chuzc_flip _glp_spy_chuzc_flip
+int spy_chuzc_flip(SPXLP *lp, const double d[/*1+n-m*/],
+      double r, const double trow[/*1+n-m*/], double tol_piv,
+      double tol, double tol1, SPYBP bp[/*1+n-m*/], int *nflip);
+/* choose non-basic variable (dual long-step ratio test) */
+
 #endif
 
 /* eof */
@@ -23,6 +23,7 @@
 
 #include "glpenv.h"
 #include "spychuzr.h"
+#include "spxvec.h"
 
 /***********************************************************************
 *  spy_chuzr_sel - select eligible basic variables
@@ -165,6 +166,7 @@ void spy_alloc_se(SPXLP *lp, SPYSE *se)
       se->refsp = talloc(1+n, char);
       se->gamma = talloc(1+m, double);
       se->work = talloc(1+m, double);
+      se->par = NULL;
       return;
 }
 
@@ -270,20 +272,38 @@ double spy_eval_gamma_i(SPXLP *lp, SPYSE *se, int i)
 *  total number of such variables.
 *
 *  On exit the routine returns p, the index of the basic variable xB[p]
-*  chosen. */
+*  chosen.
+*
+*  If the team of threads se->par is specified, long lists are split
+*  into parts scanned in parallel. The best candidates of the parts are
+*  compared in the order of parts, so the routine chooses the same xB[p]
+*  (the first one in the list among equally eligible variables) with
+*  any number of threads. */
 
-int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
-      int num, const int list[])
-{     int m = lp->m;
+struct chuzr
+{     /* parallel choice of basic variable */
+      SPXLP *lp;
+      SPYSE *se;
+      const double *beta;
+      int num;
+      const int *list;
+      int p[SPX_PAR_MAX];
+      double best[SPX_PAR_MAX];
+      /* best candidate found in each part; p = -1 means that the part
+       * contains a basic variable, which is not eligible */
+};
+
+static int chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[],
+      const int list[], int beg, int end, double *best_)
+{     /* choose basic variable among list[beg], ..., list[end-1] */
       double *l = lp->l;
       double *u = lp->u;
       int *head = lp->head;
       double *gamma = se->gamma;
       int i, k, p, t;
       double best, ri, temp;
-      xassert(0 < num && num <= m);
       p = 0, best = -1.0;
-      for (t = 1; t <= num; t++)
+      for (t = beg; t < end; t++)
       {  i = list[t];
          k = head[i]; /* x[k] = xB[i] */
          if (beta[i] < l[k])
@@ -291,7 +311,9 @@ int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
          else if (beta[i] > u[k])
             ri = u[k] - beta[i];
          else
-            xassert(t != t);
+         {  /* xB[i] is not eligible */
+            return -1;
+         }
          /* FIXME */
          if (gamma[i] < DBL_EPSILON)
             temp = 0.0;
@@ -300,7 +322,42 @@ int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
          if (best < temp)
             p = i, best = temp;
       }
-      xassert(p != 0);
+      *best_ = best;
+      return p;
+}
+
+static void chuzr_part(void *info, int t, int nt)
+{     /* scan t-th part of the list */
+      struct chuzr *w = info;
+      int beg, end;
+      spx_par_range(w->num, t, nt, &beg, &end);
+      w->p[t] = chuzr_pse(w->lp, w->se, w->beta, w->list, beg, end,
+         &w->best[t]);
+      return;
+}
+
+int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
+      int num, const int list[])
+{     int m = lp->m;
+      int p, t, nt;
+      double best;
+      xassert(0 < num && num <= m);
+      nt = spx_par_parts(se->par, num);
+      if (nt == 1)
+         p = chuzr_pse(lp, se, beta, list, 1, num+1, &best);
+      else
+      {  struct chuzr w;
+         w.lp = lp, w.se = se, w.beta = beta, w.num = num;
+         w.list = list;
+         spx_par_run(se->par, nt, chuzr_part, &w);
+         p = 0, best = -1.0;
+         for (t = 0; t < nt; t++)
+         {  xassert(w.p[t] >= 0);
+            if (best < w.best[t])
+               p = w.p[t], best = w.best[t];
+         }
+      }
+      xassert(p > 0);
       return p;
 }
 
@@ -336,7 +393,52 @@ int spy_chuzr_pse(SPXLP *lp, SPYSE *se, const double beta[/*1+m*/],
 *  non-basic variable corresponding to xB[p]) on entry to the routine,
 *  and returns e on exit. (If e happens to be large enough, the calling
 *  program may reset the reference space, since other weights also may
-*  be inaccurate.) */
+*  be inaccurate.)
+*
+*  If the team of threads se->par is specified, the weights gamma[i],
+*  i != p, are updated in parallel. (Every weight is computed exactly
+*  as in the serial case.) */
+
+struct update
+{     /* parallel update of weights */
+      SPXLP *lp;
+      SPYSE *se;
+      int p;
+      const double *tcol;
+      double gamma_p, delta_p;
+};
+
+static void update_gamma(struct update *w, int beg, int end)
+{     /* compute new gamma[i] for i = beg, ..., end-1, i != p */
+      int *head = w->lp->head;
+      char *refsp = w->se->refsp;
+      double *gamma = w->se->gamma;
+      double *u = w->se->work;
+      const double *tcol = w->tcol;
+      int i, k;
+      double r, t1, t2;
+      for (i = beg; i < end; i++)
+      {  if (i == w->p)
+            continue;
+         /* compute r[i] = T[i,q] / T[p,q] */
+         r = tcol[i] / tcol[w->p];
+         /* compute new gamma[i] */
+         t1 = gamma[i] + r * (r * w->gamma_p + u[i] + u[i]);
+         k = head[i]; /* x[k] = xB[i] */
+         t2 = (refsp[k] ? 1.0 : 0.0) + w->delta_p * r * r;
+         gamma[i] = (t1 >= t2 ? t1 : t2);
+      }
+      return;
+}
+
+static void update_part(void *info, int t, int nt)
+{     /* update t-th part of weights */
+      struct update *w = info;
+      int beg, end;
+      spx_par_range(w->lp->m, t, nt, &beg, &end);
+      update_gamma(w, beg, end);
+      return;
+}
 
 double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
       const double trow[/*1+n-m*/], const double tcol[/*1+m*/])
@@ -346,8 +448,9 @@ double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
       char *refsp = se->refsp;
       double *gamma = se->gamma;
       double *u = se->work;
-      int i, j, k, ptr, end;
-      double gamma_p, delta_p, e, r, t1, t2;
+      int i, j, k, nt;
+      double gamma_p, delta_p, e;
+      struct update w;
       xassert(se->valid);
       xassert(1 <= p && p <= m);
       xassert(1 <= q && q <= n-m);
@@ -363,10 +466,8 @@ double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
          {  gamma_p += trow[j] * trow[j];
             /* u := u + T[p,j] * N[j], where N[j] = A[k] is constraint
              * matrix column corresponding to xN[j] */
-            ptr = lp->A_ptr[k];
-            end = lp->A_ptr[k+1];
-            for (; ptr < end; ptr++)
-               u[lp->A_ind[ptr]] += trow[j] * lp->A_val[ptr];
+            spx_vec_scatter(lp->A_ptr[k], lp->A_ptr[k+1], lp->A_ind,
+               lp->A_val, trow[j], u);
          }
       }
       bfd_ftran(lp->bfd, u);
@@ -375,17 +476,13 @@ double spy_update_gamma(SPXLP *lp, SPYSE *se, int p, int q,
       /* compute new gamma[p] */
       gamma[p] = gamma_p / (tcol[p] * tcol[p]);
       /* compute new gamma[i] for all i != p */
-      for (i = 1; i <= m; i++)
-      {  if (i == p)
-            continue;
-         /* compute r[i] = T[i,q] / T[p,q] */
-         r = tcol[i] / tcol[p];
-         /* compute new gamma[i] */
-         t1 = gamma[i] + r * (r * gamma_p + u[i] + u[i]);
-         k = head[i]; /* x[k] = xB[i] */
-         t2 = (refsp[k] ? 1.0 : 0.0) + delta_p * r * r;
-         gamma[i] = (t1 >= t2 ? t1 : t2);
-      }
+      w.lp = lp, w.se = se, w.p = p, w.tcol = tcol;
+      w.gamma_p = gamma_p, w.delta_p = delta_p;
+      nt = spx_par_parts(se->par, m);
+      if (nt == 1)
+         update_gamma(&w, 1, m+1);
+      else
+         spx_par_run(se->par, nt, update_part, &w);
       return e;
 }
 
@@ -400,6 +497,8 @@ void spy_free_se(SPXLP *lp, SPYSE *se)
       tfree(se->refsp);
       tfree(se->gamma);
       tfree(se->work);
+      if (se->par != NULL)
+         spx_par_delete(se->par);
       return;
 }
 
@@ -25,6 +25,7 @@
 #define SPYCHUZR_H
 
 #include "spxlp.h"
+#include "spxpar.h"
 
 #define spy_chuzr_sel _glp_spy_chuzr_sel
 int spy_chuzr_sel(SPXLP *lp, const double beta[/*1+m*/], double tol,
@@ -53,6 +54,9 @@ struct SPYSE
        * (r[i] is bound violation for basic variable xB[i]) */
       double *work; /* double work[1+m]; */
       /* working array */
+      SPXPAR *par;
+      /* team of threads used to choose xB[p] and to update weights;
+       * NULL means that these loops are run serially */
 };
 
 #define spy_alloc_se _glp_spy_alloc_se
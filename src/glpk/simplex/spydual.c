@@ -99,12 +99,22 @@ struct csa
       /* p-th (pivot) row of the simplex table */
       int q;
       /* xN[q] is a non-basic variable chosen to enter the basis */
-      double *tcol; /* double tcol[1+m]; */
+      FVS tcol; /* FVS tcol[1:m]; */
       /* q-th (pivot) column of the simplex table */
+      FVS rho; /* FVS rho[1:m]; */
+      /* p-th row of the inverse inv(B) */
       double *work; /* double work[1+m]; */
       /* working array */
       double *work1; /* double work1[1+n-m]; */
       /* another working array */
+      SPYBP *bp; /* SPYBP bp[1+n-m]; */
+      /* break-points of the dual objective (long-step ratio test) */
+      int nflip;
+      /* number of non-basic variables to be flipped */
+      int *flip; /* int flip[1+n-m]; */
+      /* flip[1], ..., flip[nflip] are indices j of non-basic variables
+       * xN[j] which go to their opposite bounds on changing the basis
+       * (long-step ratio test) */
       int p_stat, d_stat;
       /* primal and dual solution statuses */
       /*--------------------------------------------------------------*/
@@ -116,7 +126,8 @@ struct csa
       int harris;
       /* dual ratio test technique:
        * 0 - textbook ratio test
-       * 1 - Harris' two pass ratio test */
+       * 1 - Harris' two pass ratio test
+       * 2 - long-step (bound flipping) ratio test */
       double tol_bnd, tol_bnd1;
       /* primal feasibility tolerances */
       double tol_dj, tol_dj1;
@@ -129,6 +140,13 @@ struct csa
       /* iteration limit */
       int tm_lim;
       /* time limit, milliseconds */
+      const volatile int *stop;
+      /* if *stop is non-zero, terminate the search */
+      void (*prog_func)(const glp_prog *prog, void *info);
+      void *prog_info;
+      /* progress callback and its transit pointer */
+      int prog_frq;
+      /* progress report frequency, milliseconds */
       int out_frq;
       /* display output frequency, iterations */
       int out_dly;
@@ -146,6 +164,12 @@ struct csa
       /* simplex iteration count at most recent display output */
       int inv_cnt;
       /* basis factorization count since most recent display output */
+      int inv_tot;
+      /* basis factorization count since the beginning of the search */
+      double tm_prog;
+      /* time value at most recent progress report */
+      int it_prog;
+      /* simplex iteration count at most recent progress report */
 };
 
 /***********************************************************************
@@ -511,6 +535,7 @@ static void choose_pivot(struct csa *csa)
       int m = lp->m;
       int n = lp->n;
       double *l = lp->l;
+      double *u = lp->u;
       int *head = lp->head;
       SPXAT *at = csa->at;
       SPXNT *nt = csa->nt;
@@ -518,9 +543,10 @@ static void choose_pivot(struct csa *csa)
       double *d = csa->d;
       SPYSE *se = csa->se;
       int *list = csa->list;
-      double *rho = csa->work;
+      FVS *rho = &csa->rho;
       double *trow = csa->work1;
-      int nnn, try, k, p, q, t;
+      SPYBP *bp = csa->bp;
+      int nnn, try, k, p, q, t, nflip;
       xassert(csa->beta_st);
       xassert(csa->d_st);
       /* initial number of eligible basic variables */
@@ -541,20 +567,25 @@ try:  /* choose basic variable xB[p] */
       }
       xassert(1 <= p && p <= m);
       /* compute p-th row of inv(B) */
-      spx_eval_rho(lp, p, rho);
+      spx_eval_rho_s(lp, p, rho);
       /* compute p-th row of the simplex table */
       if (at != NULL)
-         spx_eval_trow1(lp, at, rho, trow);
+         spx_eval_trow1_s(lp, at, rho, trow);
       else
-         spx_nt_prod(lp, nt, trow, 1, -1.0, rho);
+         spx_nt_prod_s(lp, nt, trow, 1, -1.0, rho);
       /* choose non-basic variable xN[q] */
       k = head[p]; /* x[k] = xB[p] */
-      if (!csa->harris)
+      nflip = 0;
+      if (csa->harris == 0)
          q = spy_chuzc_std(lp, d, beta[p] < l[k] ? +1. : -1., trow,
             csa->tol_piv, .30 * csa->tol_dj, .30 * csa->tol_dj1);
-      else
+      else if (csa->harris == 1)
          q = spy_chuzc_harris(lp, d, beta[p] < l[k] ? +1. : -1., trow,
             csa->tol_piv, .35 * csa->tol_dj, .35 * csa->tol_dj1);
+      else
+         q = spy_chuzc_flip(lp, d, beta[p] < l[k] ? l[k] - beta[p] :
+            u[k] - beta[p], trow, csa->tol_piv, .30 * csa->tol_dj,
+            .30 * csa->tol_dj1, bp, &nflip);
       /* either keep previous choice or accept new choice depending on
        * which one is better */
       if (csa->p == 0 || q == 0 ||
@@ -562,6 +593,9 @@ try:  /* choose basic variable xB[p] */
       {  csa->p = p;
          memcpy(&csa->trow[1], &trow[1], (n-m) * sizeof(double));
          csa->q = q;
+         csa->nflip = nflip;
+         for (t = 1; t <= nflip; t++)
+            csa->flip[t] = bp[t].j;
       }
       /* check if current choice is acceptable */
       if (csa->q == 0 || fabs(csa->trow[csa->q]) >= 0.001)
@@ -586,25 +620,38 @@ done: /* the choice has been made */
 }
 
 /***********************************************************************
-*  display - display search progress
-*
-*  This routine displays some information about the search progress
-*  that includes:
-*
-*  search phase;
-*
-*  number of simplex iterations performed by the solver;
-*
-*  original objective value (only on phase II);
-*
-*  sum of (scaled) dual infeasibilities for original bounds;
+*  sum_infeas - compute sum of primal infeasibilities
 *
-*  number of dual infeasibilities (phase I) or primal infeasibilities
-*  (phase II);
+*  This routine computes the sum of (scaled) primal infeasibilities of
+*  basic variables with respect to their original bounds. */
+
+static double sum_infeas(struct csa *csa)
+{     SPXLP *lp = csa->lp;
+      int m = lp->m;
+      int *head = lp->head;
+      double *l = csa->l; /* original lower bounds */
+      double *u = csa->u; /* original upper bounds */
+      double *beta = csa->beta;
+      int i, k;
+      double sum = 0.0;
+      for (i = 1; i <= m; i++)
+      {  k = head[i]; /* x[k] = xB[i] */
+         if (l[k] != -DBL_MAX && beta[i] < l[k])
+            sum += l[k] - beta[i];
+         if (u[k] != +DBL_MAX && beta[i] > u[k])
+            sum += beta[i] - u[k];
+      }
+      return sum;
+}
+
+/***********************************************************************
+*  sum_dual_infeas - compute sum of dual infeasibilities
 *
-*  number of basic factorizations since last display output. */
+*  This routine computes the sum of (scaled) dual infeasibilities of
+*  non-basic variables for the current search phase and stores the
+*  number of dual infeasibilities to the location nnn (phase I). */
 
-static void display(struct csa *csa, int spec)
+static double sum_dual_infeas(struct csa *csa, int *nnn)
 {     SPXLP *lp = csa->lp;
       int m = lp->m;
       int n = lp->n;
@@ -612,23 +659,14 @@ static void display(struct csa *csa, int spec)
       char *flag = lp->flag;
       double *l = csa->l; /* original lower bounds */
       double *u = csa->u; /* original upper bounds */
-      double *beta = csa->beta;
       double *d = csa->d;
-      int j, k, nnn;
-      double sum;
-      /* check if the display output should be skipped */
-      if (csa->msg_lev < GLP_MSG_ON) goto skip;
-      if (csa->out_dly > 0 &&
-         1000.0 * xdifftime(xtime(), csa->tm_beg) < csa->out_dly)
-         goto skip;
-      if (csa->it_cnt == csa->it_dpy) goto skip;
-      if (!spec && csa->it_cnt % csa->out_frq != 0) goto skip;
-      /* display search progress depending on search phase */
+      int j, k;
+      double sum = 0.0;
+      *nnn = 0;
       switch (csa->phase)
       {  case 1:
             /* compute sum and number of (scaled) dual infeasibilities
              * for original bounds */
-            sum = 0.0, nnn = 0;
             for (j = 1; j <= n-m; j++)
             {  k = head[m+j]; /* x[k] = xN[j] */
                if (d[j] > 0.0)
@@ -636,7 +674,7 @@ static void display(struct csa *csa, int spec)
                   if (l[k] == -DBL_MAX)
                   {  sum += d[j];
                      if (d[j] > +1e-7)
-                        nnn++;
+                        (*nnn)++;
                   }
                }
                else if (d[j] < 0.0)
@@ -644,19 +682,13 @@ static void display(struct csa *csa, int spec)
                   if (u[k] == +DBL_MAX)
                   {  sum -= d[j];
                      if (d[j] < -1e-7)
-                        nnn++;
+                        (*nnn)++;
                   }
                }
             }
-            /* on phase I variables have artificial bounds which are
-             * meaningless for original LP, so corresponding objective
-             * function value is also meaningless */
-            xprintf(" %6d: %23s inf = %11.3e (%d)",
-               csa->it_cnt, "", sum, nnn);
             break;
          case 2:
             /* compute sum of (scaled) dual infeasibilities */
-            sum = 0.0, nnn = 0;
             for (j = 1; j <= n-m; j++)
             {  k = head[m+j]; /* x[k] = xN[j] */
                if (d[j] > 0.0)
@@ -670,6 +702,91 @@ static void display(struct csa *csa, int spec)
                      sum -= d[j];
                }
             }
+            break;
+         default:
+            xassert(csa != csa);
+      }
+      return sum;
+}
+
+/***********************************************************************
+*  progress - report search progress to the application
+*
+*  This routine passes a snapshot of the search progress to the progress
+*  callback every prog_frq milliseconds. If the flag spec is set, the
+*  snapshot is passed regardless of the frequency. */
+
+static void progress(struct csa *csa, int spec)
+{     glp_prog prog;
+      int nnn;
+      /* check if the progress report should be skipped */
+      if (csa->it_cnt == csa->it_prog) goto skip;
+      if (!spec &&
+         1000.0 * xdifftime(xtime(), csa->tm_prog) < csa->prog_frq)
+         goto skip;
+      prog.phase = csa->phase;
+      prog.it_cnt = csa->it_cnt;
+      /* on phase I the objective value is meaningless */
+      if (csa->phase == 2)
+         prog.obj = (double)csa->dir * spx_eval_obj(csa->lp, csa->beta);
+      else
+         prog.obj = 0.0;
+      prog.pinf = sum_infeas(csa);
+      prog.dinf = sum_dual_infeas(csa, &nnn);
+      prog.gap = 0.0;
+      prog.inv_cnt = csa->inv_tot;
+      csa->prog_func(&prog, csa->prog_info);
+      csa->it_prog = csa->it_cnt;
+      csa->tm_prog = xtime();
+skip: return;
+}
+
+/***********************************************************************
+*  display - display search progress
+*
+*  This routine displays some information about the search progress
+*  that includes:
+*
+*  search phase;
+*
+*  number of simplex iterations performed by the solver;
+*
+*  original objective value (only on phase II);
+*
+*  sum of (scaled) dual infeasibilities for original bounds;
+*
+*  number of dual infeasibilities (phase I) or primal infeasibilities
+*  (phase II);
+*
+*  number of basic factorizations since last display output. */
+
+static void display(struct csa *csa, int spec)
+{     SPXLP *lp = csa->lp;
+      double *beta = csa->beta;
+      int nnn;
+      double sum;
+      /* report search progress to the application */
+      if (csa->prog_func != NULL)
+         progress(csa, spec);
+      /* check if the display output should be skipped */
+      if (csa->msg_lev < GLP_MSG_ON) goto skip;
+      if (csa->out_dly > 0 &&
+         1000.0 * xdifftime(xtime(), csa->tm_beg) < csa->out_dly)
+         goto skip;
+      if (csa->it_cnt == csa->it_dpy) goto skip;
+      if (!spec && csa->it_cnt % csa->out_frq != 0) goto skip;
+      /* compute sum of (scaled) dual infeasibilities */
+      sum = sum_dual_infeas(csa, &nnn);
+      /* display search progress depending on search phase */
+      switch (csa->phase)
+      {  case 1:
+            /* on phase I variables have artificial bounds which are
+             * meaningless for original LP, so corresponding objective
+             * function value is also meaningless */
+            xprintf(" %6d: %23s inf = %11.3e (%d)",
+               csa->it_cnt, "", sum, nnn);
+            break;
+         case 2:
             /* compute number of primal infeasibilities */
             nnn = spy_chuzr_sel(lp, beta, csa->tol_bnd, csa->tol_bnd1,
                NULL);
@@ -711,6 +828,9 @@ skip: return;
 *  GLP_ETMLIM
 *     Time limit has been exhausted.
 *
+*  GLP_ESTOP
+*     The search was terminated by the application.
+*
 *  GLP_EFAIL
 *     The solver failed to solve LP instance. */
 
@@ -728,7 +848,7 @@ static int dual_simplex(struct csa *csa)
       SPYSE *se = csa->se;
       int *list = csa->list;
       double *trow = csa->trow;
-      double *tcol = csa->tcol;
+      double *tcol = csa->tcol.vec;
       double *pi = csa->work;
       int msg_lev = csa->msg_lev;
       double tol_bnd = csa->tol_bnd;
@@ -743,6 +863,7 @@ loop: /* main loop starts here */
       {  double cond;
          ret = spx_factorize(lp);
          csa->inv_cnt++;
+         csa->inv_tot++;
          if (ret != 0)
          {  if (msg_lev >= GLP_MSG_ERR)
                xprintf("Error: unable to factorize the basis matrix (%d"
@@ -907,6 +1028,28 @@ loop: /* main loop starts here */
          ret = GLP_EITLIM;
          goto fini;
       }
+      /* check if the search has been terminated by the application */
+      if (csa->stop != NULL && *csa->stop)
+      {  if (csa->beta_st != 1)
+            csa->beta_st = 0;
+         if (csa->d_st != 1)
+            csa->d_st = 0;
+         if (!(csa->beta_st && csa->d_st))
+            goto loop;
+         display(csa, 1);
+         if (msg_lev >= GLP_MSG_ALL)
+            xprintf("SEARCH TERMINATED BY APPLICATION\n");
+         if (csa->phase == 1)
+         {  set_orig_bounds(csa);
+            check_flags(csa);
+            spx_eval_beta(lp, beta);
+         }
+         csa->num = spy_chuzr_sel(lp, beta, tol_bnd, tol_bnd1, list);
+         csa->p_stat = (csa->num == 0 ? GLP_FEAS : GLP_INFEAS);
+         csa->d_stat = (csa->phase == 1 ? GLP_INFEAS : GLP_FEAS);
+         ret = GLP_ESTOP;
+         goto fini;
+      }
       /* display the search progress */
       display(csa, 0);
       /* select eligible basic variables */
@@ -994,13 +1137,16 @@ loop: /* main loop starts here */
          }
       }
       /* compute q-th column of the simplex table */
-      spx_eval_tcol(lp, csa->q, tcol);
+      spx_eval_tcol_s(lp, csa->q, &csa->tcol);
       /* FIXME: tcol[p] and trow[q] should be close to each other */
       xassert(tcol[csa->p] != 0.0);
       /* update values of basic variables for adjacent basis */
       k = head[csa->p]; /* x[k] = xB[p] */
       p_flag = (l[k] != u[k] && beta[csa->p] > u[k]);
-      spx_update_beta(lp, beta, csa->p, p_flag, csa->q, tcol);
+      /* (long-step ratio test only) flip non-basic variables passed
+       * over to their opposite bounds */
+      spx_update_beta_flip(lp, beta, csa->nflip, csa->flip, &csa->rho);
+      spx_update_beta_s(lp, beta, csa->p, p_flag, csa->q, &csa->tcol);
       csa->beta_st = 2;
       /* update reduced costs of non-basic variables for adjacent
        * basis */
@@ -1083,8 +1229,10 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       /* build matrix A in row-wise format */
       csa->at = &at;
       csa->nt = NULL;
-      spx_alloc_at(csa->lp, csa->at);
-      spx_build_at(csa->lp, csa->at);
+      if (!spx_take_at(csa->lp, P, csa->at))
+      {  spx_alloc_at(csa->lp, csa->at);
+         spx_build_at(csa->lp, csa->at);
+      }
 #else
       /* build matrix N in row-wise format for initial basis */
       csa->at = NULL;
@@ -1101,20 +1249,28 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       csa->d_st = 0;
       switch (parm->pricing)
       {  case GLP_PT_STD:
+         case GLP_PT_PART:
+         case GLP_PT_MULT:
+            /* partial pricing is used by primal simplex only */
             csa->se = NULL;
             break;
          case GLP_PT_PSE:
             csa->se = &se;
             spy_alloc_se(csa->lp, csa->se);
+            se.par = spx_par_create(parm->nthreads);
             break;
          default:
             xassert(parm != parm);
       }
       csa->list = talloc(1+csa->lp->m, int);
       csa->trow = talloc(1+csa->lp->n-csa->lp->m, double);
-      csa->tcol = talloc(1+csa->lp->m, double);
+      fvs_alloc_vec(&csa->tcol, csa->lp->m);
+      fvs_alloc_vec(&csa->rho, csa->lp->m);
       csa->work = talloc(1+csa->lp->m, double);
       csa->work1 = talloc(1+csa->lp->n-csa->lp->m, double);
+      csa->bp = talloc(1+csa->lp->n-csa->lp->m, SPYBP);
+      csa->nflip = 0;
+      csa->flip = talloc(1+csa->lp->n-csa->lp->m, int);
       /* initialize control parameters */
       csa->msg_lev = parm->msg_lev;
       csa->dualp = (parm->meth == GLP_DUALP);
@@ -1125,6 +1281,9 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
          case GLP_RT_HAR:
             csa->harris = 1;
             break;
+         case GLP_RT_FLIP:
+            csa->harris = 2;
+            break;
          default:
             xassert(parm != parm);
       }
@@ -1145,6 +1304,10 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       }
       csa->it_lim = parm->it_lim;
       csa->tm_lim = parm->tm_lim;
+      csa->stop = parm->stop;
+      csa->prog_func = parm->prog_func;
+      csa->prog_info = parm->prog_info;
+      csa->prog_frq = parm->prog_frq;
       csa->out_frq = parm->out_frq;
       csa->out_dly = parm->out_dly;
       /* initialize working parameters */
@@ -1152,6 +1315,9 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
       csa->it_beg = csa->it_cnt = P->it_cnt;
       csa->it_dpy = -1;
       csa->inv_cnt = 0;
+      csa->inv_tot = 0;
+      csa->tm_prog = csa->tm_beg;
+      csa->it_prog = -1;
       /* try to solve working LP */
       ret = dual_simplex(csa);
       /* return basis factorization back to problem object */
@@ -1195,7 +1361,11 @@ int spy_dual(glp_prob *P, const glp_smcp *parm)
          }
          xassert(P->some != 0);
       }
-skip: /* deallocate working objects and arrays */
+skip: /* keep constraint matrix of working LP to reuse it in the
+       * next call (optionally) */
+      if (P->compact)
+         spx_keep_lp(csa->lp, P, EXCL, map, csa->at);
+      /* deallocate working objects and arrays */
       spx_free_lp(csa->lp);
       tfree(map);
       tfree(csa->b);
@@ -1211,9 +1381,12 @@ skip: /* deallocate working objects and arrays */
          spy_free_se(csa->lp, csa->se);
       tfree(csa->list);
       tfree(csa->trow);
-      tfree(csa->tcol);
+      fvs_free_vec(&csa->tcol);
+      fvs_free_vec(&csa->rho);
       tfree(csa->work);
       tfree(csa->work1);
+      tfree(csa->bp);
+      tfree(csa->flip);
       /* return to calling program */
       return ret >= 0 ? ret : GLP_EFAIL;
 }
@@ -0,0 +1,253 @@
+/* strhash.c (hash table of character strings) */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#include "glpenv.h"
+#include "strhash.h"
+
+struct STRHASH
+{     /* hash table with open addressing (linear probing) */
+      int size;
+      /* number of slots, a power of two */
+      int used;
+      /* number of occupied slots, used <= size / 2 */
+      struct slot *slot; /* struct slot slot[size]; */
+      /* array of slots */
+};
+
+struct slot
+{     /* slot of hash table */
+      unsigned int hash;
+      /* hash value of the key */
+      const char *key;
+      /* pointer to the key (the character string is supplied by the
+         application and must not change while the entry exists); NULL
+         means the slot is free */
+      void *link;
+      /* reserved for the application specific information */
+};
+
+static unsigned int hash_key(const char *key)
+{     /* FNV-1a hash followed by a final mixing step, so that keys
+         differing only in their last characters are not clustered */
+      unsigned int h = 2166136261U;
+      for (; *key != '\0'; key++)
+         h = (h ^ (unsigned char)*key) * 16777619U;
+      h ^= h >> 16, h *= 0x85EBCA6BU;
+      h ^= h >> 13, h *= 0xC2B2AE35U;
+      h ^= h >> 16;
+      return h;
+}
+
+static struct slot *alloc_slots(int size)
+{     /* allocate array of free slots */
+      struct slot *slot;
+      int k;
+      slot = xcalloc(size, sizeof(struct slot));
+      for (k = 0; k < size; k++)
+         slot[k].key = NULL;
+      return slot;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  strhash_create_table - create hash table
+*
+*  SYNOPSIS
+*
+*  #include "strhash.h"
+*  STRHASH *strhash_create_table(int n);
+*
+*  DESCRIPTION
+*
+*  The routine strhash_create_table creates an empty hash table, whose
+*  keys are character strings. The parameter n is the expected number
+*  of entries, which is only used to choose the initial size, because
+*  the table is enlarged automatically.
+*
+*  Unlike a binary search tree, the table finds a key in constant time
+*  on average, which matters when names are looked up millions of times
+*  (e.g. while reading a model from a file).
+*
+*  RETURNS
+*
+*  The routine returns a pointer to the hash table created. */
+
+STRHASH *strhash_create_table(int n)
+{     STRHASH *tab;
+      tab = xmalloc(sizeof(STRHASH));
+      tab->size = 16;
+      while (tab->size < 0x40000000 && tab->size / 2 <= n)
+         tab->size += tab->size;
+      tab->used = 0;
+      tab->slot = alloc_slots(tab->size);
+      return tab;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  strhash_insert - insert new entry into hash table
+*
+*  SYNOPSIS
+*
+*  #include "strhash.h"
+*  void strhash_insert(STRHASH *tab, const char *key, void *link);
+*
+*  DESCRIPTION
+*
+*  The routine strhash_insert inserts a new entry with the specified
+*  key and link into the hash table. The string key is not copied, so
+*  it must exist until the entry is deleted. Several entries may have
+*  the same key. */
+
+void strhash_insert(STRHASH *tab, const char *key, void *link)
+{     struct slot *slot;
+      unsigned int hash, mask;
+      int k;
+      xassert(key != NULL);
+      if (2 * (tab->used + 1) > tab->size)
+      {  /* enlarge the table keeping the load factor at most 1/2 */
+         struct slot *old = tab->slot;
+         int size = tab->size;
+         xassert(size <= 0x20000000);
+         tab->size += tab->size;
+         tab->slot = alloc_slots(tab->size);
+         mask = tab->size - 1;
+         for (k = 0; k < size; k++)
+         {  if (old[k].key == NULL) continue;
+            for (hash = old[k].hash & mask; tab->slot[hash].key != NULL;
+               hash = (hash + 1) & mask) /* nop */;
+            tab->slot[hash] = old[k];
+         }
+         xfree(old);
+      }
+      hash = hash_key(key);
+      mask = tab->size - 1;
+      for (k = hash & mask; tab->slot[k].key != NULL; k = (k + 1) & mask)
+         /* nop */;
+      slot = &tab->slot[k];
+      slot->hash = hash;
+      slot->key = key;
+      slot->link = link;
+      tab->used++;
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  strhash_find - find entry in hash table
+*
+*  SYNOPSIS
+*
+*  #include "strhash.h"
+*  void *strhash_find(STRHASH *tab, const char *key);
+*
+*  RETURNS
+*
+*  The routine strhash_find returns the link of an entry, which has the
+*  specified key. If there are several such entries, the routine
+*  returns one of them. If no such entry exists, the routine returns
+*  NULL. */
+
+void *strhash_find(STRHASH *tab, const char *key)
+{     struct slot *slot;
+      unsigned int hash, mask;
+      int k;
+      hash = hash_key(key);
+      mask = tab->size - 1;
+      for (k = hash & mask; ; k = (k + 1) & mask)
+      {  slot = &tab->slot[k];
+         if (slot->key == NULL)
+            break;
+         if (slot->hash == hash && strcmp(slot->key, key) == 0)
+            return slot->link;
+      }
+      return NULL;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  strhash_delete - delete entry from hash table
+*
+*  SYNOPSIS
+*
+*  #include "strhash.h"
+*  void strhash_delete(STRHASH *tab, const char *key, void *link);
+*
+*  DESCRIPTION
+*
+*  The routine strhash_delete deletes the entry with the specified key
+*  and link from the hash table. The entry must exist.
+*
+*  Entries following the deleted one in its probe sequence are moved
+*  back, so no deleted marks are left in the table. */
+
+void strhash_delete(STRHASH *tab, const char *key, void *link)
+{     unsigned int hash, mask;
+      int i, j, k;
+      hash = hash_key(key);
+      mask = tab->size - 1;
+      for (i = hash & mask; ; i = (i + 1) & mask)
+      {  xassert(tab->slot[i].key != NULL);
+         if (tab->slot[i].link == link && tab->slot[i].hash == hash &&
+             strcmp(tab->slot[i].key, key) == 0)
+            break;
+      }
+      for (j = i; ; )
+      {  j = (j + 1) & mask;
+         if (tab->slot[j].key == NULL)
+            break;
+         /* the entry in slot j can fill slot i only if its home slot
+            k is not in the cyclic range (i, j] */
+         k = tab->slot[j].hash & mask;
+         if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+         tab->slot[i] = tab->slot[j];
+         i = j;
+      }
+      tab->slot[i].key = NULL;
+      tab->used--;
+      return;
+}
+
+/***********************************************************************
+*  NAME
+*
+*  strhash_delete_table - delete hash table
+*
+*  SYNOPSIS
+*
+*  #include "strhash.h"
+*  void strhash_delete_table(STRHASH *tab);
+*
+*  DESCRIPTION
+*
+*  The routine strhash_delete_table deletes the hash table and frees
+*  all the memory allocated to it. The keys are not freed. */
+
+void strhash_delete_table(STRHASH *tab)
+{     xfree(tab->slot);
+      xfree(tab);
+      return;
+}
+
+/* eof */
@@ -0,0 +1,47 @@
+/* strhash.h (hash table of character strings) */
+
+/***********************************************************************
+*  This code is part of GLPK (GNU Linear Programming Kit).
+*
+*  GLPK is free software: you can redistribute it and/or modify it
+*  under the terms of the GNU General Public License as published by
+*  the Free Software Foundation, either version 3 of the License, or
+*  (at your option) any later version.
+*
+*  GLPK is distributed in the hope that it will be useful, but WITHOUT
+*  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+*  or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+*  License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with GLPK. If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+
+#ifndef STRHASH_H
+#define STRHASH_H
+
+typedef struct STRHASH STRHASH;
+
+#define strhash_create_table _glp_strhash_create_table
+STRHASH *strhash_create_table(int n);
+/* create hash table */
+
+#define strhash_insert _glp_strhash_insert
+void strhash_insert(STRHASH *tab, const char *key, void *link);
+/* insert new entry into hash table */
+
+#define strhash_find _glp_strhash_find
+void *strhash_find(STRHASH *tab, const char *key);
+/* find entry in hash table */
+
+#define strhash_delete _glp_strhash_delete
+void strhash_delete(STRHASH *tab, const char *key, void *link);
+/* delete entry from hash table */
+
+#define strhash_delete_table _glp_strhash_delete_table
+void strhash_delete_table(STRHASH *tab);
+/* delete hash table */
+
+#endif
+
+/* eof */
@@ -10,8 +10,19 @@
 #include <stdio.h>
 #include "zio.h"
 
-static FILE *file[FOPEN_MAX];
-static int initialized = 0;
+#ifndef TLS
+#if defined(_MSC_VER)
+#define TLS __declspec(thread)
+#else
+#define TLS __thread
+#endif
+#endif
+
+/* the descriptor table is kept per thread (as in glpenv.h), so .gz
+ * files may be read and written concurrently on different threads;
+ * a descriptor is always opened, used, and closed by one thread */
+static TLS FILE *file[FOPEN_MAX];
+static TLS int initialized = 0;
 
 static void initialize(void)
 {     int fd;
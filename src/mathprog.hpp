@@ -186,8 +186,8 @@ namespace NodeGLPK {
                 worker = new GenerateWorker(callback, mp, V8TOCSTRING(info[0]));
             else
                 worker = new GenerateWorker(callback, mp, NULL);
+            GLP_SOLVER_QUEUE(worker, 0);
             mp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static NAN_METHOD(GenerateSync) {
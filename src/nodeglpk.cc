@@ -1,8 +1,13 @@
 
 #include <node.h>
+#include "pool.hpp"
+#include "progress.hpp"
+#include "solution.hpp"
+#include "file.hpp"
 #include "tree.hpp"
 #include "problem.hpp"
 #include "mathprog.hpp"
+#include "batch.hpp"
 #include "common.h"
 #include "glpk/glpk.h"
 
@@ -90,9 +95,12 @@ extern "C" {
         
         GLP_DEFINE_CONSTANT(exports, GLP_PT_STD, PT_STD);
         GLP_DEFINE_CONSTANT(exports, GLP_PT_PSE, PT_PSE);
+        GLP_DEFINE_CONSTANT(exports, GLP_PT_PART, PT_PART);
+        GLP_DEFINE_CONSTANT(exports, GLP_PT_MULT, PT_MULT);
         
         GLP_DEFINE_CONSTANT(exports, GLP_RT_STD, RT_STD);
         GLP_DEFINE_CONSTANT(exports, GLP_RT_HAR, RT_HAR);
+        GLP_DEFINE_CONSTANT(exports, GLP_RT_FLIP, RT_FLIP);
         
         GLP_DEFINE_CONSTANT(exports, GLP_ORD_NONE, ORD_NONE);
         GLP_DEFINE_CONSTANT(exports, GLP_ORD_QMD, ORD_QMD);
@@ -174,10 +182,17 @@ extern "C" {
         
         GLP_DEFINE_CONSTANT(exports, GLP_MPS_DECK, MPS_DECK);
         GLP_DEFINE_CONSTANT(exports, GLP_MPS_FILE, MPS_FILE);
+
+        GLP_DEFINE_CONSTANT(exports, GLP_BIN_NAMES, BIN_NAMES);
+        GLP_DEFINE_CONSTANT(exports, GLP_BIN_BASIS, BIN_BASIS);
+        GLP_DEFINE_CONSTANT(exports, GLP_BIN_SCALE, BIN_SCALE);
         
+        SolverPool::Init(exports);
         Problem::Init(exports);
         Tree::Init(exports);
+        Solution::Init(exports);
         Mathprog::Init(exports);
+        Batch::Init(exports);
     }
     
 }
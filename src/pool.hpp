@@ -0,0 +1,211 @@
+#ifndef _pool_hpp
+#define _pool_hpp
+
+#include <node.h>
+#include <queue>
+#include <vector>
+
+#include "common.h"
+
+#define GLP_SOLVER_QUEUE(WORKER, PRIORITY)\
+    if (!SolverPool::Queue(WORKER, PRIORITY)) {\
+        WORKER->Destroy();\
+        Nan::ThrowError("the solver queue is full");\
+        return;\
+    }
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    // Long running solver jobs are executed on a dedicated set of threads instead of the
+    // libuv threadpool, so a long intopt can't starve fs/dns/crypto requests.
+    class SolverPool {
+    public:
+        static void Init(Handle<Object> exports){
+            uv_mutex_init(&mutex);
+            uv_cond_init(&cond);
+            uv_async_init(Nan::GetCurrentEventLoop(), &async, Complete);
+            uv_unref((uv_handle_t*)&async);
+
+            uv_cpu_info_t* cpus;
+            int count;
+            if (uv_cpu_info(&cpus, &count) == 0) {
+                size = count > 0 ? count : 1;
+                uv_free_cpu_info(cpus, count);
+            }
+
+            exports->Set(Nan::New<String>("setSolverPool").ToLocalChecked(), Nan::New<FunctionTemplate>(SetSolverPool)->GetFunction());
+            exports->Set(Nan::New<String>("getSolverPool").ToLocalChecked(), Nan::New<FunctionTemplate>(GetSolverPool)->GetFunction());
+        }
+
+        // Must be called from the main thread. Jobs with a higher priority are started first,
+        // jobs with the same priority in FIFO order. A job re-queued from its own WorkComplete
+        // (intopt callbacks) is already admitted and bypasses the queue depth limit.
+        static bool Queue(Nan::AsyncWorker* worker, int priority, bool admitted = false){
+            Reap();
+            uv_mutex_lock(&mutex);
+            if (!admitted && (depth > 0) && ((int)pending.size() >= depth)) {
+                uv_mutex_unlock(&mutex);
+                return false;
+            }
+            pending.push(Job(worker, priority, seq++));
+            if ((threads < size) && ((int)pending.size() > threads - running)) {
+                uv_thread_t tid;
+                if (uv_thread_create(&tid, Run, NULL) == 0) threads++;
+            }
+            uv_cond_signal(&cond);
+            uv_mutex_unlock(&mutex);
+
+            if (outstanding++ == 0) uv_ref((uv_handle_t*)&async);
+            return true;
+        }
+
+        static int Size(){
+            uv_mutex_lock(&mutex);
+            int ret = size;
+            uv_mutex_unlock(&mutex);
+            return ret;
+        }
+
+    private:
+        struct Job {
+            Job(Nan::AsyncWorker* worker, int priority, unsigned long seq)
+            : worker(worker), priority(priority), seq(seq) {}
+
+            bool operator<(const Job& other) const {
+                if (priority != other.priority) return priority < other.priority;
+                return seq > other.seq;
+            }
+
+            Nan::AsyncWorker* worker;
+            int priority;
+            unsigned long seq;
+        };
+
+        static void Run(void* arg){
+            uv_mutex_lock(&mutex);
+            for (;;) {
+                while (pending.empty() && (threads <= size))
+                    uv_cond_wait(&cond, &mutex);
+                if (threads > size) break;
+
+                Job job = pending.top();
+                pending.pop();
+                running++;
+                uv_mutex_unlock(&mutex);
+
+                job.worker->Execute();
+
+                uv_mutex_lock(&mutex);
+                running--;
+                done.push_back(job.worker);
+                uv_async_send(&async);
+            }
+            // a surplus thread exits after the pool shrinks; the main thread joins it
+            threads--;
+            exited.push_back(uv_thread_self());
+            uv_async_send(&async);
+            uv_mutex_unlock(&mutex);
+        }
+
+        // Must be called from the main thread.
+        static void Reap(){
+            std::vector<uv_thread_t> list;
+            uv_mutex_lock(&mutex);
+            list.swap(exited);
+            uv_mutex_unlock(&mutex);
+
+            for (size_t i = 0; i < list.size(); i++)
+                uv_thread_join(&list[i]);
+        }
+
+        static NAUV_WORK_CB(Complete) {
+            std::vector<Nan::AsyncWorker*> list;
+            uv_mutex_lock(&mutex);
+            list.swap(done);
+            uv_mutex_unlock(&mutex);
+            Reap();
+
+            for (size_t i = 0; i < list.size(); i++) {
+                list[i]->WorkComplete();
+                list[i]->Destroy();
+                if (--outstanding == 0) uv_unref((uv_handle_t*)&async);
+            }
+        }
+
+        static NAN_METHOD(SetSolverPool) {
+            V8CHECK(info.Length() != 1, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsObject(), "Wrong arguments");
+
+            int newSize = size, newDepth = depth;
+            Local<Object> obj = info[0]->ToObject();
+            Local<Array> props = obj->GetPropertyNames();
+            for(uint32_t i = 0; i < props->Length(); i++){
+                Local<Value> key = props->Get(i);
+                Local<Value> val = obj->Get(key);
+                std::string keystr = std::string(V8TOCSTRING(key));
+                if (keystr == "size"){
+                    V8CHECK(!val->IsInt32() || (val->Int32Value() < 1), "size: should be a positive int32");
+                    newSize = val->Int32Value();
+                } else if (keystr == "queueDepth"){
+                    V8CHECK(!val->IsInt32() || (val->Int32Value() < 0), "queueDepth: should be a non negative int32");
+                    newDepth = val->Int32Value();
+                } else {
+                    std::string error("Unknow field: ");
+                    error += keystr;
+                    V8CHECK(true, error.c_str());
+                }
+            }
+
+            Reap();
+            uv_mutex_lock(&mutex);
+            size = newSize;
+            depth = newDepth;
+            while ((threads < size) && ((int)pending.size() > threads - running)) {
+                uv_thread_t tid;
+                if (uv_thread_create(&tid, Run, NULL) != 0) break;
+                threads++;
+            }
+            uv_cond_broadcast(&cond);
+            uv_mutex_unlock(&mutex);
+        }
+
+        static NAN_METHOD(GetSolverPool) {
+            Local<Object> ret = Nan::New<Object>();
+            uv_mutex_lock(&mutex);
+            GLP_SET_FIELD_INT32(ret, "size", size);
+            GLP_SET_FIELD_INT32(ret, "queueDepth", depth);
+            GLP_SET_FIELD_INT32(ret, "threads", threads);
+            GLP_SET_FIELD_INT32(ret, "running", running);
+            GLP_SET_FIELD_INT32(ret, "pending", (int)pending.size());
+            uv_mutex_unlock(&mutex);
+
+            info.GetReturnValue().Set(ret);
+        }
+
+        static uv_mutex_t mutex;
+        static uv_cond_t cond;
+        static uv_async_t async;
+        static std::priority_queue<Job> pending;
+        static std::vector<Nan::AsyncWorker*> done;
+        static std::vector<uv_thread_t> exited;
+        static int size, depth, threads, running, outstanding;
+        static unsigned long seq;
+    };
+
+    uv_mutex_t SolverPool::mutex;
+    uv_cond_t SolverPool::cond;
+    uv_async_t SolverPool::async;
+    std::priority_queue<SolverPool::Job> SolverPool::pending;
+    std::vector<Nan::AsyncWorker*> SolverPool::done;
+    std::vector<uv_thread_t> SolverPool::exited;
+    int SolverPool::size = 1;
+    int SolverPool::depth = 0;
+    int SolverPool::threads = 0;
+    int SolverPool::running = 0;
+    int SolverPool::outstanding = 0;
+    unsigned long SolverPool::seq = 0;
+}
+
+#endif
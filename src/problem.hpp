@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <vector>
 
 #include "glpk/glpk.h"
 #include "common.h"
@@ -37,6 +38,7 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "loadMatrix", LoadMatrix);
             Nan::SetPrototypeMethod(tpl, "simplexSync", SimplexSync);
             Nan::SetPrototypeMethod(tpl, "simplex", Simplex);
+            Nan::SetPrototypeMethod(tpl, "solveScenarios", SolveScenarios);
             Nan::SetPrototypeMethod(tpl, "getObjVal", GetObjVal);
             Nan::SetPrototypeMethod(tpl, "getColPrim", GetColPrim);
             Nan::SetPrototypeMethod(tpl, "setObjName", SetObjName);
@@ -46,9 +48,11 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "setMatCol", SetMatCol);
             Nan::SetPrototypeMethod(tpl, "getMatCol", GetMatCol);
             Nan::SetPrototypeMethod(tpl, "sortMatrix", SortMatrix);
+            Nan::SetPrototypeMethod(tpl, "compactMatrix", CompactMatrix);
             Nan::SetPrototypeMethod(tpl, "delRows", DelRows);
             Nan::SetPrototypeMethod(tpl, "delCols", DelCols);
             Nan::SetPrototypeMethod(tpl, "erase", Erase);
+            Nan::SetPrototypeMethod(tpl, "clone", Clone);
             Nan::SetPrototypeMethod(tpl, "delete", Delete);
             Nan::SetPrototypeMethod(tpl, "getNumRows", GetNumRows);
             Nan::SetPrototypeMethod(tpl, "getNumCols", GetNumCols);
@@ -62,6 +66,8 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "createIndex", CreateIndex);
             Nan::SetPrototypeMethod(tpl, "findRow", FindRow);
             Nan::SetPrototypeMethod(tpl, "findCol", FindCol);
+            Nan::SetPrototypeMethod(tpl, "findRows", FindRows);
+            Nan::SetPrototypeMethod(tpl, "findCols", FindCols);
             Nan::SetPrototypeMethod(tpl, "deleteIndex", DeleteIndex);
             Nan::SetPrototypeMethod(tpl, "setRii", SetRii);
             Nan::SetPrototypeMethod(tpl, "setSjj", SetSjj);
@@ -111,6 +117,10 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "readProb", ReadProb);
             Nan::SetPrototypeMethod(tpl, "writeProbSync", WriteProbSync);
             Nan::SetPrototypeMethod(tpl, "writeProb", WriteProb);
+            Nan::SetPrototypeMethod(tpl, "readBinSync", ReadBinSync);
+            Nan::SetPrototypeMethod(tpl, "readBin", ReadBin);
+            Nan::SetPrototypeMethod(tpl, "writeBinSync", WriteBinSync);
+            Nan::SetPrototypeMethod(tpl, "writeBin", WriteBin);
             Nan::SetPrototypeMethod(tpl, "readLp", ReadLp);
             Nan::SetPrototypeMethod(tpl, "readLpSync", ReadLpSync);
             Nan::SetPrototypeMethod(tpl, "writeLpSync", WriteLpSync);
@@ -149,6 +159,27 @@ namespace NodeGLPK {
             Nan::SetPrototypeMethod(tpl, "getRowBind", GetRowBind);
             Nan::SetPrototypeMethod(tpl, "getColBind", GetColBind);
             Nan::SetPrototypeMethod(tpl, "warmUp", WarmUp);
+            Nan::SetPrototypeMethod(tpl, "getRowPrims", GetRowPrims);
+            Nan::SetPrototypeMethod(tpl, "getRowDuals", GetRowDuals);
+            Nan::SetPrototypeMethod(tpl, "getColPrims", GetColPrims);
+            Nan::SetPrototypeMethod(tpl, "getColDuals", GetColDuals);
+            Nan::SetPrototypeMethod(tpl, "getRowStats", GetRowStats);
+            Nan::SetPrototypeMethod(tpl, "getColStats", GetColStats);
+            Nan::SetPrototypeMethod(tpl, "iptRowPrims", IptRowPrims);
+            Nan::SetPrototypeMethod(tpl, "iptRowDuals", IptRowDuals);
+            Nan::SetPrototypeMethod(tpl, "iptColPrims", IptColPrims);
+            Nan::SetPrototypeMethod(tpl, "iptColDuals", IptColDuals);
+            Nan::SetPrototypeMethod(tpl, "mipRowVals", MipRowVals);
+            Nan::SetPrototypeMethod(tpl, "mipColVals", MipColVals);
+            Nan::SetPrototypeMethod(tpl, "setRowsBnds", SetRowsBnds);
+            Nan::SetPrototypeMethod(tpl, "setColsBnds", SetColsBnds);
+            Nan::SetPrototypeMethod(tpl, "setObjCoefs", SetObjCoefs);
+            Nan::SetPrototypeMethod(tpl, "setColKinds", SetColKinds);
+            Nan::SetPrototypeMethod(tpl, "setRowNames", SetRowNames);
+            Nan::SetPrototypeMethod(tpl, "setColNames", SetColNames);
+            Nan::SetPrototypeMethod(tpl, "setPriority", SetPriority);
+            Nan::SetPrototypeMethod(tpl, "getPriority", GetPriority);
+            Nan::SetPrototypeMethod(tpl, "cancel", Cancel);
             
             constructor.Reset(tpl);
             exports->Set(Nan::New<String>("Problem").ToLocalChecked(), tpl->GetFunction());
@@ -204,6 +235,17 @@ namespace NodeGLPK {
                 } else if (keystr == "presolve"){
                     V8CHECKBOOL(!val->IsInt32(), "presolve: should be int32");
                     scmp->presolve = val->Int32Value();
+                } else if (keystr == "cbProgress"){
+                    V8CHECKBOOL(!val->IsFunction(), "cbProgress: should be a function");
+                    SolverProgress::Release(scmp);
+                    scmp->prog_func = SolverProgress::Call;
+                    scmp->prog_info = new Nan::Callback(Local<Function>::Cast(val));
+                } else if (keystr == "cbInterval"){
+                    V8CHECKBOOL(!val->IsInt32() || (val->Int32Value() < 0), "cbInterval: should be a non negative int32");
+                    scmp->prog_frq = val->Int32Value();
+                } else if (keystr == "threads"){
+                    V8CHECKBOOL(!val->IsInt32() || (val->Int32Value() < 1) || (val->Int32Value() > 256), "threads: should be int32 between 1 and 256");
+                    scmp->nthreads = val->Int32Value();
                 } else {
                     std::string error("Unknow field: ");
                     error += keystr;
@@ -216,6 +258,8 @@ namespace NodeGLPK {
         explicit Problem(): node::ObjectWrap(){
             handle = glp_create_prob();
             thread = false;
+            priority = 0;
+            cancel = 0;
         }
 
         ~Problem(){
@@ -231,71 +275,94 @@ namespace NodeGLPK {
             )
         }
 
+        // Returns a new Problem holding a copy of this one, including the basis and the last
+        // solutions. Names are copied unless false is given. The constraint matrix is not
+        // copied: both problems share its compact copy until either of them changes it.
+        static NAN_METHOD(Clone) {
+            V8CHECK(info.Length() > 1, "Wrong number of arguments");
+            V8CHECK(info.Length() == 1 && !info[0]->IsBoolean(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+
+            int names = (info.Length() == 0 || info[0]->BooleanValue()) ? GLP_ON : GLP_OFF;
+            Local<Object> ret = Nan::New<FunctionTemplate>(constructor)->GetFunction()->NewInstance();
+            Problem* copy = ObjectWrap::Unwrap<Problem>(ret);
+            copy->priority = lp->priority;
+            GLP_CATCH_RET(glp_copy_prob(copy->handle, lp->handle, names);)
+            info.GetReturnValue().Set(ret);
+        }
+
         static NAN_METHOD(LoadMatrix) {
             V8CHECK(info.Length() != 4, "Wrong number of arguments");
             V8CHECK(!info[0]->IsInt32() || !info[1]->IsInt32Array()
                     || !info[2]->IsInt32Array() || !info[3]->IsFloat64Array(), "Wrong arguments");
             
-            Local<Int32Array> ia = Local<Int32Array>::Cast(info[1]);
-            Local<Int32Array> ja = Local<Int32Array>::Cast(info[2]);
-            Local<Float64Array> ar = Local<Float64Array>::Cast(info[3]);
-            
-            int* pia = new int[ia->Length()];
-            int* pja = new int[ja->Length()];
-            double* par = new double[ar->Length()];
+            Nan::TypedArrayContents<int> ia(info[1]);
+            Nan::TypedArrayContents<int> ja(info[2]);
+            Nan::TypedArrayContents<double> ar(info[3]);
             
-            for (size_t i = 0; i < ia->Length(); i++) pia[i] = ia->Get(i)->Int32Value();
-            for (size_t i = 0; i < ja->Length(); i++) pja[i] = ja->Get(i)->Int32Value();
-            for (size_t i = 0; i < ar->Length(); i++) par[i] = ar->Get(i)->NumberValue();
+            int ne = info[0]->Int32Value();
+            V8CHECK(ne < 0 || (ne > 0 && (ia.length() <= (size_t)ne || ja.length() <= (size_t)ne
+                    || ar.length() <= (size_t)ne)), "Invalid arrays length");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
-            GLP_CATCH(glp_load_matrix(lp->handle, info[0]->Int32Value(), pia, pja, par);)
-            
-            delete[] pia;
-            delete[] pja;
-            delete[] par;
+            GLP_CATCH(glp_load_matrix(lp->handle, ne, *ia, *ja, *ar);)
         }
 
         static NAN_METHOD(SimplexSync) {
             V8CHECK(info.Length() > 1, "Wrong number of arguments");
             
-            GLP_CATCH_RET(
-                      glp_smcp scmp;
-                      glp_init_smcp(&scmp);
-                      if (info.Length() == 1)
-                          if (!SmcpInit(&scmp, info[0])) return;
-                      
-                      Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
-                      V8CHECK(!lp->handle, "object deleted");
-                      V8CHECK(lp->thread, "an async operation is inprogress");
-                      
-                      glp_simplex(lp->handle, &scmp);
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+            
+            glp_smcp scmp;
+            glp_init_smcp(&scmp);
+            lp->thread = true;
+            GLP_CATCH(
+                      if (info.Length() == 0 || SmcpInit(&scmp, info[0]))
+                          glp_simplex(lp->handle, &scmp);
             )
+            lp->thread = false;
+            SolverProgress::Release(&scmp);
         }
         
         class SimplexWorker : public Nan::AsyncWorker {
         public:
             SimplexWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0), progress(NULL){
                 glp_init_smcp(&smcp);
             }
+            ~SimplexWorker(){
+                if (progress) delete progress;
+                else SolverProgress::Release(&smcp);
+            }
             void WorkComplete() {
                 lp->thread = false;
+                if (progress) progress->Flush();
                 Nan::AsyncWorker::WorkComplete();
             }
             void Execute () {
                 try {
-                    glp_simplex(lp->handle, &smcp);
+                    ret = glp_simplex(lp->handle, &smcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+            void HandleOKCallback(){
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), Solution::Capture(lp->handle, GLP_SOL)};
+                callback->Call(3, info);
+            }
         public:
             Problem *lp;
             glp_smcp smcp;
+            int ret;
+            SolverProgress *progress;
         };
         
         static NAN_METHOD(Simplex) {
@@ -312,49 +379,275 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel = 0;
+            worker->smcp.stop = &lp->cancel;
+            worker->progress = SolverProgress::Detach(&worker->smcp);
+            GLP_SOLVER_QUEUE(worker, lp->priority);
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
-        
+
+        // Solves the same matrix for a series of right-hand side and/or objective vectors. Each
+        // scenario starts from the optimal basis of the previous one, the factorization is kept
+        // valid because only bounds and costs change. Inputs and results are packed row-major,
+        // the value of row i in scenario s is at s * m + (i - 1). A scenario rhs value replaces the
+        // lower bound of a GLP_LO row, the upper bound of a GLP_UP row and both bounds of a GLP_FX
+        // row; rhs is rejected if the problem has double-bounded or free rows, whose right-hand
+        // side is not a single value. The original bounds and costs are restored on every path.
+        class ScenariosWorker : public Nan::AsyncWorker {
+        public:
+            ScenariosWorker(Nan::Callback *callback, Problem *lp)
+            : Nan::AsyncWorker(callback), lp(lp), count(0), m(0), n(0), progress(NULL){
+                glp_init_smcp(&smcp);
+            }
+            ~ScenariosWorker(){
+                if (progress) delete progress;
+                else SolverProgress::Release(&smcp);
+            }
+            void WorkComplete() {
+                lp->thread = false;
+                if (progress) progress->Flush();
+                Nan::AsyncWorker::WorkComplete();
+            }
+            void Execute () {
+                glp_prob *P = lp->handle;
+                std::vector<int> type(m + 1), rstat(m + 1), cstat(n + 1);
+                std::vector<double> lb(m + 1), ub(m + 1), coef(n + 1);
+                bool saved = false, backup = false;
+                int k = 0, i, j;
+
+                try {
+                    for (i = 1; i <= m; i++) {
+                        type[i] = glp_get_row_type(P, i);
+                        lb[i] = glp_get_row_lb(P, i);
+                        ub[i] = glp_get_row_ub(P, i);
+                    }
+                    for (j = 0; j <= n; j++) coef[j] = glp_get_obj_coef(P, j);
+                    backup = true;
+
+                    for (; k < count; k++) {
+                        if (!rhs.empty()) {
+                            const double *b = &rhs[(size_t)k * m];
+                            for (i = 1; i <= m; i++) {
+                                switch (type[i]) {
+                                    case GLP_LO: glp_set_row_bnds(P, i, GLP_LO, b[i - 1], 0.0); break;
+                                    case GLP_UP: glp_set_row_bnds(P, i, GLP_UP, 0.0, b[i - 1]); break;
+                                    case GLP_FX: glp_set_row_bnds(P, i, GLP_FX, b[i - 1], b[i - 1]); break;
+                                }
+                            }
+                        }
+                        if (!obj.empty()) {
+                            const double *c = &obj[(size_t)k * n];
+                            for (j = 1; j <= n; j++) glp_set_obj_coef(P, j, c[j - 1]);
+                        }
+
+                        ret[k] = glp_simplex(P, &smcp);
+                        status[k] = glp_get_status(P);
+                        val[k] = glp_get_obj_val(P);
+                        for (j = 1; j <= n; j++) colPrim[(size_t)k * n + j - 1] = glp_get_col_prim(P, j);
+                        for (i = 1; i <= m; i++) rowDual[(size_t)k * m + i - 1] = glp_get_row_dual(P, i);
+                        if (ret[k] == GLP_ESTOP) {
+                            k++;
+                            break;
+                        }
+
+                        // presolve would discard the basis chained between scenarios
+                        smcp.presolve = GLP_OFF;
+                        if (ret[k] == 0 && status[k] == GLP_OPT) {
+                            for (i = 1; i <= m; i++) rstat[i] = glp_get_row_stat(P, i);
+                            for (j = 1; j <= n; j++) cstat[j] = glp_get_col_stat(P, j);
+                            saved = true;
+                        } else if (saved) {
+                            for (i = 1; i <= m; i++) glp_set_row_stat(P, i, rstat[i]);
+                            for (j = 1; j <= n; j++) glp_set_col_stat(P, j, cstat[j]);
+                        }
+                    }
+                    for (; k < count; k++) {
+                        ret[k] = GLP_ESTOP;
+                        status[k] = GLP_UNDEF;
+                    }
+
+                    Restore(type, lb, ub, coef);
+                } catch (std::string s){
+                    SetErrorMessage(s.c_str());
+                    // don't leave the last scenario's bounds and costs in the problem
+                    if (backup) {
+                        try {
+                            Restore(type, lb, ub, coef);
+                        } catch (std::string) {
+                        }
+                    }
+                }
+            }
+            void Restore(const std::vector<int> &type, const std::vector<double> &lb,
+                         const std::vector<double> &ub, const std::vector<double> &coef){
+                glp_prob *P = lp->handle;
+                if (!rhs.empty())
+                    for (int i = 1; i <= m; i++) glp_set_row_bnds(P, i, type[i], lb[i], ub[i]);
+                if (!obj.empty())
+                    for (int j = 1; j <= n; j++) glp_set_obj_coef(P, j, coef[j]);
+            }
+            void HandleOKCallback(){
+                Local<Object> result = Nan::New<Object>();
+                result->Set(Nan::New<String>("ret").ToLocalChecked(), Pack<Int32Array>(ret));
+                result->Set(Nan::New<String>("status").ToLocalChecked(), Pack<Int32Array>(status));
+                result->Set(Nan::New<String>("obj").ToLocalChecked(), Pack<Float64Array>(val));
+                result->Set(Nan::New<String>("colPrim").ToLocalChecked(), Pack<Float64Array>(colPrim));
+                result->Set(Nan::New<String>("rowDual").ToLocalChecked(), Pack<Float64Array>(rowDual));
+                Local<Value> info[] = {Nan::Null(), result};
+                callback->Call(2, info);
+            }
+            template<class ARRAY, class T> static Local<ARRAY> Pack(const std::vector<T> &data){
+                Local<ArrayBuffer> buf = ArrayBuffer::New(Isolate::GetCurrent(), data.size() * sizeof(T));
+                if (!data.empty()) memcpy(buf->GetContents().Data(), &data[0], data.size() * sizeof(T));
+                return ARRAY::New(buf, 0, data.size());
+            }
+        public:
+            Problem *lp;
+            glp_smcp smcp;
+            int count, m, n;
+            std::vector<double> rhs, obj;
+            std::vector<int> ret, status;
+            std::vector<double> val, colPrim, rowDual;
+            SolverProgress *progress;
+        };
+
+        static NAN_METHOD(SolveScenarios) {
+            V8CHECK(info.Length() != 3, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsObject() || !(info[1]->IsObject() || info[1]->IsNull())
+                    || !info[2]->IsFunction(), "Wrong arguments");
+
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+
+            int m = glp_get_num_rows(lp->handle), n = glp_get_num_cols(lp->handle), count = -1;
+            Local<Value> rhs = Nan::Undefined(), obj = Nan::Undefined();
+            Local<Object> scenarios = info[0]->ToObject();
+            Local<Array> props = scenarios->GetPropertyNames();
+            for(uint32_t i = 0; i < props->Length(); i++){
+                Local<Value> key = props->Get(i);
+                Local<Value> val = scenarios->Get(key);
+                std::string keystr = std::string(V8TOCSTRING(key));
+                if (keystr == "count"){
+                    V8CHECK(!val->IsInt32() || (val->Int32Value() < 0), "count: should be a non negative int32");
+                    count = val->Int32Value();
+                } else if (keystr == "rhs"){
+                    V8CHECK(!val->IsFloat64Array(), "rhs: should be a Float64Array");
+                    rhs = val;
+                } else if (keystr == "obj"){
+                    V8CHECK(!val->IsFloat64Array(), "obj: should be a Float64Array");
+                    obj = val;
+                } else {
+                    std::string error("Unknow field: ");
+                    error += keystr;
+                    V8CHECK(true, error.c_str());
+                }
+            }
+            V8CHECK(count < 0, "count: missing");
+            V8CHECK(rhs->IsUndefined() && obj->IsUndefined(), "rhs or obj should be given");
+            if (!rhs->IsUndefined()) {
+                for (int i = 1; i <= m; i++) {
+                    int type = glp_get_row_type(lp->handle, i);
+                    if ((type == GLP_DB) || (type == GLP_FR)) {
+                        char error[128];
+                        snprintf(error, sizeof(error), "rhs: row %d is %s, only GLP_LO, GLP_UP and GLP_FX rows take a scenario value",
+                                 i, type == GLP_DB ? "double-bounded" : "free");
+                        Nan::ThrowError(error);
+                        return;
+                    }
+                }
+            }
+
+            Nan::Callback *callback = new Nan::Callback(info[2].As<Function>());
+            ScenariosWorker *worker = new ScenariosWorker(callback, lp);
+            worker->count = count;
+            worker->m = m;
+            worker->n = n;
+            if (!rhs->IsUndefined()) {
+                Nan::TypedArrayContents<double> data(rhs);
+                if (data.length() < (size_t)count * m) {
+                    worker->Destroy();
+                    Nan::ThrowError("rhs: should hold count * rows values");
+                    return;
+                }
+                worker->rhs.assign(*data, *data + (size_t)count * m);
+            }
+            if (!obj->IsUndefined()) {
+                Nan::TypedArrayContents<double> data(obj);
+                if (data.length() < (size_t)count * n) {
+                    worker->Destroy();
+                    Nan::ThrowError("obj: should hold count * cols values");
+                    return;
+                }
+                worker->obj.assign(*data, *data + (size_t)count * n);
+            }
+
+            // new costs keep the basis primal feasible, new right-hand sides keep it dual feasible
+            worker->smcp.meth = rhs->IsUndefined() ? GLP_PRIMAL : GLP_DUALP;
+            if (info[1]->IsObject() && !SmcpInit(&worker->smcp, info[1])){
+                worker->Destroy();
+                return;
+            }
+            worker->ret.resize(count);
+            worker->status.resize(count);
+            worker->val.resize(count);
+            worker->colPrim.resize((size_t)count * n);
+            worker->rowDual.resize((size_t)count * m);
+
+            lp->cancel = 0;
+            worker->smcp.stop = &lp->cancel;
+            worker->progress = SolverProgress::Detach(&worker->smcp);
+            GLP_SOLVER_QUEUE(worker, lp->priority);
+            lp->thread = true;
+        }
+
         static NAN_METHOD(ExactSync) {
             V8CHECK(info.Length() > 1, "Wrong number of arguments");
             
-            GLP_CATCH_RET(
-                      glp_smcp scmp;
-                      glp_init_smcp(&scmp);
-                      if (info.Length() == 1) {
-                          if (info[0]->IsObject())
-                              if(!SmcpInit(&scmp, info[0])) return;
-                      }
-                      
-                      Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
-                      V8CHECK(!lp->handle, "object deleted");
-                      V8CHECK(lp->thread, "an async operation is inprogress");
-                          
-                      glp_exact(lp->handle, &scmp);
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+            
+            // the progress callback (if any) is released on every path, as in SimplexSync
+            glp_smcp scmp;
+            glp_init_smcp(&scmp);
+            lp->thread = true;
+            GLP_CATCH(
+                      if (info.Length() == 0 || !info[0]->IsObject() || SmcpInit(&scmp, info[0]))
+                          glp_exact(lp->handle, &scmp);
             )
+            lp->thread = false;
+            SolverProgress::Release(&scmp);
         }
         
         class ExactWorker : public Nan::AsyncWorker {
         public:
             ExactWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0){
                 glp_init_smcp(&smcp);
             }
+            ~ExactWorker(){
+                SolverProgress::Release(&smcp);
+            }
             void WorkComplete() {
                 lp->thread = false;
                 Nan::AsyncWorker::WorkComplete();
             }
             void Execute () {
                 try {
-                    glp_exact(lp->handle, &smcp);
+                    ret = glp_exact(lp->handle, &smcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+            void HandleOKCallback(){
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), Solution::Capture(lp->handle, GLP_SOL)};
+                callback->Call(3, info);
+            }
         public:
             Problem *lp;
             glp_smcp smcp;
+            int ret;
         };
         
         static NAN_METHOD(Exact) {
@@ -371,8 +664,10 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel = 0;
+            worker->smcp.stop = &lp->cancel;
+            GLP_SOLVER_QUEUE(worker, lp->priority);
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static bool IptcpInit(glp_iptcp* iptcp, Local<Value> value){
@@ -389,6 +684,14 @@ namespace NodeGLPK {
                 } else if (keystr == "ordAlg"){
                     V8CHECKBOOL(!val->IsInt32(), "ordAlg: should be int32");
                     iptcp->ord_alg = val->Int32Value();
+                } else if (keystr == "cbProgress"){
+                    V8CHECKBOOL(!val->IsFunction(), "cbProgress: should be a function");
+                    SolverProgress::Release(iptcp);
+                    iptcp->prog_func = SolverProgress::Call;
+                    iptcp->prog_info = new Nan::Callback(Local<Function>::Cast(val));
+                } else if (keystr == "cbInterval"){
+                    V8CHECKBOOL(!val->IsInt32() || (val->Int32Value() < 0), "cbInterval: should be a non negative int32");
+                    iptcp->prog_frq = val->Int32Value();
                 } else {
                     std::string error("Unknow field: ");
                     error += keystr;
@@ -402,41 +705,52 @@ namespace NodeGLPK {
             
             V8CHECK(info.Length() > 1, "Wrong number of arguments");
             
-            GLP_CATCH_RET(
-                      glp_iptcp iptcp;
-                      glp_init_iptcp(&iptcp);
-                      if (info.Length() == 1)
-                         if (!IptcpInit(&iptcp, info[0])) return;
-                      
-                      Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
-                      V8CHECK(!lp->handle, "object deleted");
-                      V8CHECK(lp->thread, "an async operation is inprogress");
-                          
-                      glp_interior(lp->handle, &iptcp);
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+            
+            glp_iptcp iptcp;
+            glp_init_iptcp(&iptcp);
+            lp->thread = true;
+            GLP_CATCH(
+                      if (info.Length() == 0 || IptcpInit(&iptcp, info[0]))
+                          glp_interior(lp->handle, &iptcp);
             )
+            lp->thread = false;
+            SolverProgress::Release(&iptcp);
         }
         
         class InteriorWorker : public Nan::AsyncWorker {
         public:
             InteriorWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), ret(0), progress(NULL){
                 glp_init_iptcp(&iptcp);
             }
+            ~InteriorWorker(){
+                if (progress) delete progress;
+                else SolverProgress::Release(&iptcp);
+            }
             void WorkComplete() {
                 lp->thread = false;
+                if (progress) progress->Flush();
                 Nan::AsyncWorker::WorkComplete();
             }
             void Execute () {
                 try {
-                    glp_interior(lp->handle, &iptcp);
+                    ret = glp_interior(lp->handle, &iptcp);
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
+            void HandleOKCallback(){
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), Solution::Capture(lp->handle, GLP_IPT)};
+                callback->Call(3, info);
+            }
         public:
             Problem *lp;
             glp_iptcp iptcp;
-            
+            int ret;
+            SolverProgress *progress;
         };
         
         static NAN_METHOD(Interior) {
@@ -453,8 +767,11 @@ namespace NodeGLPK {
                 worker->Destroy();
                 return;
             }
+            lp->cancel = 0;
+            worker->iptcp.stop = &lp->cancel;
+            worker->progress = SolverProgress::Detach(&worker->iptcp);
+            GLP_SOLVER_QUEUE(worker, lp->priority);
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static bool MpscpInit(glp_mpscp *mpscp, Local<Value> value){
@@ -471,6 +788,9 @@ namespace NodeGLPK {
                     } else if (keystr == "tolMps"){
                         V8CHECKBOOL(!val->IsNumber(), "tolMps: should be number");
                         mpscp->tol_mps = val->NumberValue();
+                    } else if (keystr == "threads"){
+                        V8CHECKBOOL(!val->IsInt32() || (val->Int32Value() < 1) || (val->Int32Value() > 256), "threads: should be int32 between 1 and 256");
+                        mpscp->nthreads = val->Int32Value();
                     } else if (keystr == "objName"){
                         V8CHECKBOOL(!val->IsString(), "objName: should be a string");
                         std::string objname = std::string(V8TOCSTRING(val));
@@ -488,8 +808,10 @@ namespace NodeGLPK {
         
         static NAN_METHOD(ReadMpsSync) {
             V8CHECK(info.Length() != 3, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull() || info[1]->IsUndefined()) || !info[2]->IsString(), "Wrong arguments");
+            V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull() || info[1]->IsUndefined()) || !FileArg::Check(info[2]), "Wrong arguments");
             
+            FileArg file;
+            if (!file.Init(info[2])) return;
             GLP_CATCH_RET(
                 glp_mpscp mpscp;
                 glp_init_mpscp(&mpscp);
@@ -500,7 +822,7 @@ namespace NodeGLPK {
                 V8CHECK(!lp->handle, "object deleted");
                 V8CHECK(lp->thread, "an async operation is inprogress");
                           
-                int ret = glp_read_mps(lp->handle, info[0]->Int32Value(), &mpscp, V8TOCSTRING(info[2]));
+                int ret = glp_read_mps(lp->handle, info[0]->Int32Value(), &mpscp, file.Name());
                 if (mpscp.obj_name) delete[] mpscp.obj_name;
                 info.GetReturnValue().Set(ret);
             )
@@ -508,8 +830,8 @@ namespace NodeGLPK {
         
         class ReadMpsWorker : public Nan::AsyncWorker {
         public:
-            ReadMpsWorker(Nan::Callback *callback, Problem *lp, int fmt, std::string file)
-            : Nan::AsyncWorker(callback), fmt(fmt), lp(lp), file(file){
+            ReadMpsWorker(Nan::Callback *callback, Problem *lp, int fmt)
+            : Nan::AsyncWorker(callback), fmt(fmt), lp(lp){
                 glp_init_mpscp(&mpscp);
             }
             
@@ -522,48 +844,50 @@ namespace NodeGLPK {
             }
             void Execute () {
                 try {
-                    ret = glp_read_mps(lp->handle, fmt, &mpscp, file.c_str());
+                    ret = glp_read_mps(lp->handle, fmt, &mpscp, file.Name());
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
             void HandleOKCallback() {
-                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
-                callback->Call(2, info);
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};
+                callback->Call(file.Output() ? 3 : 2, info);
             }
             
         public:
             int ret, fmt;
             Problem *lp;
             glp_mpscp mpscp;
-            std::string file;
+            FileArg file;
         };
         
         static NAN_METHOD(ReadMps) {
             V8CHECK(info.Length() != 4, "Wrong number of arguments");
             V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull())
-                    || !info[2]->IsString() || !info[3]->IsFunction(), "Wrong arguments");
+                    || !FileArg::Check(info[2]) || !info[3]->IsFunction(), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
             Nan::Callback *callback = new Nan::Callback(info[3].As<Function>());
-            ReadMpsWorker *worker = new ReadMpsWorker(callback, lp, info[0]->Int32Value(), V8TOCSTRING(info[2]));
-            if (!MpscpInit(&worker->mpscp, info[1])){
+            ReadMpsWorker *worker = new ReadMpsWorker(callback, lp, info[0]->Int32Value());
+            if (!MpscpInit(&worker->mpscp, info[1]) || !worker->file.Init(info[2], true)){
                 worker->Destroy();
                 return;
             }
+            GLP_SOLVER_QUEUE(worker, lp->priority);
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static NAN_METHOD(WriteMpsSync) {
             std::string objname;
             
             V8CHECK(info.Length() != 3, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull() || info[1]->IsUndefined()) || !info[2]->IsString(), "Wrong arguments");
+            V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull() || info[1]->IsUndefined()) || !FileArg::Check(info[2]), "Wrong arguments");
             
+            FileArg file;
+            if (!file.Init(info[2])) return;
             GLP_CATCH_RET(
               glp_mpscp mpscp;
               glp_init_mpscp(&mpscp);
@@ -574,14 +898,18 @@ namespace NodeGLPK {
               V8CHECK(!lp->handle, "object deleted");
               V8CHECK(lp->thread, "an async operation is inprogress");
                           
-              info.GetReturnValue().Set(glp_write_mps(lp->handle, info[0]->Int32Value(), &mpscp, V8TOCSTRING(info[2])));
+              int ret = glp_write_mps(lp->handle, info[0]->Int32Value(), &mpscp, file.Name());
+              if (file.Output())
+                  info.GetReturnValue().Set(file.Content(ret));
+              else
+                  info.GetReturnValue().Set(ret);
             )
         }
         
         class WriteMpsWorker : public Nan::AsyncWorker {
         public:
-            WriteMpsWorker(Nan::Callback *callback, Problem *lp, int fmt, std::string file)
-            : Nan::AsyncWorker(callback), fmt(fmt), lp(lp), file(file){
+            WriteMpsWorker(Nan::Callback *callback, Problem *lp, int fmt)
+            : Nan::AsyncWorker(callback), fmt(fmt), lp(lp){
                 glp_init_mpscp(&mpscp);
             }
             
@@ -594,35 +922,35 @@ namespace NodeGLPK {
             }
             void Execute () {
                 try {
-                    ret = glp_write_mps(lp->handle, fmt, &mpscp, file.c_str());
+                    ret = glp_write_mps(lp->handle, fmt, &mpscp, file.Name());
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
             void HandleOKCallback() {
-                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
-                callback->Call(2, info);
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};
+                callback->Call(file.Output() ? 3 : 2, info);
             }
             
         public:
             int ret, fmt;
             Problem *lp;
             glp_mpscp mpscp;
-            std::string file;
+            FileArg file;
         };
         
         static NAN_METHOD(WriteMps) {
             V8CHECK(info.Length() != 4, "Wrong number of arguments");
             V8CHECK(!info[0]->IsInt32() || !(info[1]->IsObject() || info[1]->IsNull())
-                    || !info[2]->IsString() || !info[3]->IsFunction(), "Wrong arguments");
+                    || !FileArg::Check(info[2]) || !info[3]->IsFunction(), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
             Nan::Callback *callback = new Nan::Callback(info[3].As<Function>());
-            WriteMpsWorker *worker = new WriteMpsWorker(callback, lp, info[0]->Int32Value(), V8TOCSTRING(info[2]));
-            if (!MpscpInit(&worker->mpscp, info[1])){
+            WriteMpsWorker *worker = new WriteMpsWorker(callback, lp, info[0]->Int32Value());
+            if (!MpscpInit(&worker->mpscp, info[1]) || !worker->file.Init(info[2], true)){
                 worker->Destroy();
                 return;
             }
@@ -644,7 +972,7 @@ namespace NodeGLPK {
         };
         
         
-        static bool IocpInit(glp_iocp *iocp, Local<Value> value){
+        static bool IocpInit(glp_iocp *iocp, Local<Value> value, Nan::Callback **progress = NULL, int *interval = NULL){
             if (value->IsObject()){
                 Local<Object> obj = value->ToObject();
                 Local<Array> props = obj->GetPropertyNames();
@@ -727,6 +1055,15 @@ namespace NodeGLPK {
                     } else if (keystr == "cbReasons"){
                         V8CHECKBOOL(!val->IsInt32(), "cbReason: should be int32");
                         iocp->cb_reasons = val->Int32Value();
+                    } else if (keystr == "cbProgress"){
+                        V8CHECKBOOL(!progress, "cbProgress: only supported by intopt");
+                        V8CHECKBOOL(!val->IsFunction(), "cbProgress: should be a function");
+                        if (*progress) delete *progress;
+                        *progress = new Nan::Callback(Local<Function>::Cast(val));
+                    } else if (keystr == "cbInterval"){
+                        V8CHECKBOOL(!interval, "cbInterval: only supported by intopt");
+                        V8CHECKBOOL(!val->IsInt32() || (val->Int32Value() < 0), "cbInterval: should be a non negative int32");
+                        *interval = val->Int32Value();
                     } else {
                         std::string error("Unknow field: ");
                         error += keystr;
@@ -756,19 +1093,37 @@ namespace NodeGLPK {
             )
         }
         
+        // When a cbProgress function is given, node selections and new incumbents are handled on
+        // the solver thread and summarized to cbProgress at most every cbInterval ms, only the
+        // reasons requested by cbFunc/cbReasons interrupt the search to run on the main thread.
         class IntoptWorker : public Nan::AsyncWorker {
         public:
             IntoptWorker(Nan::Callback *callback, Problem *lp)
-            : Nan::AsyncWorker(callback), lp(lp){
+            : Nan::AsyncWorker(callback), lp(lp), progress(NULL), interval(1000), async(NULL){
                 glp_init_iocp(&parm);
                 glp_init_mip_ctx(&ctx);
                 ctx.parm = &parm;
                 state = 0;
+                uv_mutex_init(&mutex);
             }
             
             ~IntoptWorker(){
                 if (parm.cb_info) delete (Nan::Callback*)parm.cb_info;
                 if (parm.save_sol) delete[] parm.save_sol;
+                if (progress) delete progress;
+                uv_mutex_destroy(&mutex);
+            }
+            
+            void StartProgress(){
+                reasons = parm.cb_func ? parm.cb_reasons : 0;
+                if (!parm.cb_func) parm.cb_func = IgnoreCallback;
+                parm.cb_reasons = reasons | GLP_FSELECT | GLP_FBINGO;
+                found = 0;
+                last = start = uv_hrtime();
+                memset(&snap, 0, sizeof(snap));
+                async = new uv_async_t;
+                uv_async_init(Nan::GetCurrentEventLoop(), async, SendProgress);
+                async->data = this;
             }
             
             void Execute () {
@@ -779,6 +1134,8 @@ namespace NodeGLPK {
                         state = 1;
                         glp_intopt_start(lp->handle, &ctx);
                     }
+                    while (!ctx.done && Coalesce())
+                        glp_intopt_run(&ctx);
                 } catch (std::string s){
                     ctx.done = 1;
                     SetErrorMessage(s.c_str());
@@ -787,6 +1144,7 @@ namespace NodeGLPK {
             void WorkComplete() {
                 lp->thread = false;
                 Nan::HandleScope scope;
+                if (async) Progress();
                 if (ctx.done) {
                     state = 2;
                     glp_intopt_stop(lp->handle, &ctx);
@@ -800,23 +1158,103 @@ namespace NodeGLPK {
                 } else {
                     parm.cb_func(ctx.tree, parm.cb_info);
                     lp->thread = true;
-                    Nan::AsyncQueueWorker(this);
+                    SolverPool::Queue(this, lp->priority, true);
                 }
             }
             
             void HandleOKCallback(){
-                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ctx.ret)};
-                callback->Call(2, info);
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ctx.ret), Solution::Capture(lp->handle, GLP_MIP)};
+                callback->Call(3, info);
             }
             
             void Destroy() {
-                if (state == 2) delete this;
+                if (state != 2) return;
+                if (async) uv_close((uv_handle_t*)async, CloseProgress);
+                delete this;
             }
+        private:
+            // Solver thread: returns true if the search can go on without a trip to the main thread.
+            bool Coalesce(){
+                if (!async) return false;
+                glp_tree *T = ctx.tree;
+                int reason = glp_ios_reason(T);
+                if (reason == GLP_IBINGO) found++;
+                uint64_t now = uv_hrtime();
+                if ((now - last) >= (uint64_t)interval * 1000000) {
+                    glp_prob *mip = glp_ios_get_prob(T);
+                    int p = glp_ios_best_node(T);
+                    uv_mutex_lock(&mutex);
+                    glp_ios_tree_size(T, &snap.active, &snap.nodes, &snap.total);
+                    snap.status = glp_mip_status(mip);
+                    snap.obj = glp_mip_obj_val(mip);
+                    snap.bound = p ? glp_ios_node_bound(T, p) : snap.obj;
+                    snap.gap = glp_ios_mip_gap(T);
+                    snap.incumbents += found;
+                    snap.elapsed = (double)(now - start) / 1e6;
+                    snap.pending = true;
+                    uv_mutex_unlock(&mutex);
+                    uv_async_send(async);
+                    found = 0;
+                    last = now;
+                }
+                return !(reasons & (1 << reason));
+            }
+            
+            // Main thread: delivers the latest summary, if any, to cbProgress.
+            void Progress(){
+                uv_mutex_lock(&mutex);
+                Snapshot copy = snap;
+                snap.pending = false;
+                snap.incumbents = 0;
+                uv_mutex_unlock(&mutex);
+                if (!copy.pending) return;
+                
+                Nan::HandleScope scope;
+                Local<Object> ev = Nan::New<Object>();
+                GLP_SET_FIELD_INT32(ev, "active", copy.active);
+                GLP_SET_FIELD_INT32(ev, "nodes", copy.nodes);
+                GLP_SET_FIELD_INT32(ev, "total", copy.total);
+                GLP_SET_FIELD_INT32(ev, "incumbents", copy.incumbents);
+                GLP_SET_FIELD_INT32(ev, "status", copy.status);
+                GLP_SET_FIELD_DOUBLE(ev, "bound", copy.bound);
+                if (copy.status == GLP_FEAS) {
+                    GLP_SET_FIELD_DOUBLE(ev, "obj", copy.obj);
+                    GLP_SET_FIELD_DOUBLE(ev, "gap", copy.gap);
+                }
+                GLP_SET_FIELD_DOUBLE(ev, "elapsed", copy.elapsed);
+                Local<Value> info[] = {ev};
+                progress->Call(1, info);
+            }
+            
+            static NAUV_WORK_CB(SendProgress) {
+                ((IntoptWorker*)async->data)->Progress();
+            }
+            
+            static void CloseProgress(uv_handle_t* handle) {
+                delete (uv_async_t*)handle;
+            }
+            
+            static void IgnoreCallback(glp_tree *T, void *info){
+            }
+            
+            struct Snapshot {
+                int active, nodes, total, incumbents, status;
+                double obj, bound, gap, elapsed;
+                bool pending;
+            };
         public:
             int state;
             Problem *lp;
             glp_iocp parm;
             glp_mip_ctx ctx;
+            Nan::Callback *progress;
+            int interval;
+        private:
+            int reasons, found;
+            uint64_t start, last;
+            uv_async_t *async;
+            uv_mutex_t mutex;
+            Snapshot snap;
         };
         
         static NAN_METHOD(Intopt) {
@@ -829,29 +1267,40 @@ namespace NodeGLPK {
             
             Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
             IntoptWorker *worker = new IntoptWorker(callback, lp);
-            if (!IocpInit(&worker->parm, info[0])){
+            if (!IocpInit(&worker->parm, info[0], &worker->progress, &worker->interval)){
+                worker->state = 2;
                 worker->Destroy();
                 return;
             }
+            if (worker->progress) worker->StartProgress();
+            lp->cancel = 0;
+            worker->parm.stop = &lp->cancel;
+            if (!SolverPool::Queue(worker, lp->priority)){
+                worker->state = 2;
+                worker->Destroy();
+                Nan::ThrowError("the solver queue is full");
+                return;
+            }
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static NAN_METHOD(ReadLpSync) {
             V8CHECK(info.Length() != 1, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsString(), "Wrong arguments");
+            V8CHECK(!FileArg::Check(info[0]), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
-            info.GetReturnValue().Set(glp_read_lp(lp->handle, NULL, V8TOCSTRING(info[0])));
+            FileArg file;
+            if (!file.Init(info[0])) return;
+            GLP_CATCH_RET(info.GetReturnValue().Set(glp_read_lp(lp->handle, NULL, file.Name()));)
         }
         
         class ReadLpWorker : public Nan::AsyncWorker {
         public:
-            ReadLpWorker(Nan::Callback *callback, Problem *lp, std::string file)
-            : Nan::AsyncWorker(callback), lp(lp), file(file){
+            ReadLpWorker(Nan::Callback *callback, Problem *lp)
+            : Nan::AsyncWorker(callback), lp(lp){
                 
             }
             void WorkComplete() {
@@ -860,51 +1309,67 @@ namespace NodeGLPK {
             }
             void Execute () {
                 try {
-                    ret = glp_read_lp(lp->handle, NULL, file.c_str());
+                    ret = glp_read_lp(lp->handle, NULL, file.Name());
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
             void HandleOKCallback() {
-                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
-                callback->Call(2, info);
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};
+                callback->Call(file.Output() ? 3 : 2, info);
             }
             
         public:
             int ret;
             Problem *lp;
-            std::string file;
+            FileArg file;
         };
         
         static NAN_METHOD(ReadLp) {
             V8CHECK(info.Length() != 2, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsString() || !info[1]->IsFunction(), "Wrong arguments");
+            V8CHECK(!FileArg::Check(info[0]) || !info[1]->IsFunction(), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
             Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
-            ReadLpWorker *worker = new ReadLpWorker(callback, lp, V8TOCSTRING(info[0]));
+            ReadLpWorker *worker = new ReadLpWorker(callback, lp);
+            if (!worker->file.Init(info[0], true)){
+                worker->Destroy();
+                return;
+            }
+            if (worker->file.Stream()) {
+                GLP_SOLVER_QUEUE(worker, lp->priority);
+            } else {
+                Nan::AsyncQueueWorker(worker);
+            }
             lp->thread = true;
-            Nan::AsyncQueueWorker(worker);
         }
         
         static NAN_METHOD(WriteLpSync) {
             V8CHECK(info.Length() != 1, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsString(), "Wrong arguments");
+            V8CHECK(!FileArg::Check(info[0]), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
-            GLP_CATCH_RET(info.GetReturnValue().Set(glp_write_lp(lp->handle, NULL, V8TOCSTRING(info[0])));)
+            FileArg file;
+            if (!file.Init(info[0])) return;
+            GLP_CATCH_RET(
+                int ret = glp_write_lp(lp->handle, NULL, file.Name());
+                if (file.Output())
+                    info.GetReturnValue().Set(file.Content(ret));
+                else
+                    info.GetReturnValue().Set(ret);
+            )
         }
         
         class WriteLpWorker : public Nan::AsyncWorker {
         public:
-            WriteLpWorker(Nan::Callback *callback, Problem *lp, std::string file)
-            : Nan::AsyncWorker(callback), lp(lp), file(file){
+            WriteLpWorker(Nan::Callback *callback, Problem *lp)
+            : Nan::AsyncWorker(callback), lp(lp){
                 
             }
             void WorkComplete() {
@@ -913,31 +1378,35 @@ namespace NodeGLPK {
             }
             void Execute () {
                 try {
-                    ret = glp_write_lp(lp->handle, NULL, file.c_str());
+                    ret = glp_write_lp(lp->handle, NULL, file.Name());
                 } catch (std::string s){
                     SetErrorMessage(s.c_str());
                 }
             }
             void HandleOKCallback() {
-                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret)};
-                callback->Call(2, info);
+                Local<Value> info[] = {Nan::Null(), Nan::New<Int32>(ret), file.Content(ret)};
+                callback->Call(file.Output() ? 3 : 2, info);
             }
         public:
             int ret;
             Problem *lp;
-            std::string file;
+            FileArg file;
         };
         
         static NAN_METHOD(WriteLp) {
             V8CHECK(info.Length() != 2, "Wrong number of arguments");
-            V8CHECK(!info[0]->IsString() || !info[1]->IsFunction(), "Wrong arguments");
+            V8CHECK(!FileArg::Check(info[0]) || !info[1]->IsFunction(), "Wrong arguments");
             
             Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
             V8CHECK(!lp->handle, "object deleted");
             V8CHECK(lp->thread, "an async operation is inprogress");
             
             Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
-            WriteLpWorker *worker = new WriteLpWorker(callback, lp, V8TOCSTRING(info[0]));
+            WriteLpWorker *worker = new WriteLpWorker(callback, lp);
+            if (!worker->file.Init(info[0], true)){
+                worker->Destroy();
+                return;
+            }
             lp->thread = true;
             Nan::AsyncQueueWorker(worker);
         }
@@ -980,19 +1449,18 @@ namespace NodeGLPK {
             int ret = 0;
             GLP_CATCH(
                 if (info[0]->IsInt32Array()) {
-                    Local<Int32Array> list = Local<Int32Array>::Cast(info[0]);
-                    count = list->Length();
+                    Nan::TypedArrayContents<int> list(info[0]);
+                    count = list.length();
                     if (count > 1) {
-                        plist = new int[count];
-                        for (size_t i = 0; i < count; i++) plist[i] = list->Get(i)->Int32Value();
+                        plist = *list;
                         count--;
-                    }
+                    } else
+                        count = 0;
                 }
                       
                 ret = glp_print_ranges(lp->handle, count, plist, info[1]->Int32Value(), V8TOCSTRING(info[2]));
                       
             )
-            if (plist) delete[] plist;
             info.GetReturnValue().Set(ret);
         }
         
@@ -1043,16 +1511,14 @@ namespace NodeGLPK {
             V8CHECK(lp->thread, "an async operation is inprogress");
             
             size_t len = 0;
-            Local<Int32Array> list;
-            if (info[0]->IsInt32Array()) {
-                list = Local<Int32Array>::Cast(info[0]);
-                len = list->Length();
-            }
+            Nan::TypedArrayContents<int> list(info[0]);
+            if (info[0]->IsInt32Array())
+                len = list.length();
             
             Nan::Callback *callback = new Nan::Callback(info[3].As<Function>());
             PrintRangesWorker *worker = new PrintRangesWorker(callback, lp, len, info[1]->Int32Value(), V8TOCSTRING(info[2]));
             if (len > 0) {
-                for (size_t i = 0; i < len; i++) worker->list[i] = list->Get(i)->Int32Value();
+                memcpy(worker->list, *list, len * sizeof(int));
                 worker->len--;
             }
             
@@ -1210,6 +1676,32 @@ namespace NodeGLPK {
         
         
         
+        static NAN_METHOD(SetPriority) {
+            V8CHECK(info.Length() != 1, "Wrong number of arguments");
+            V8CHECK(!info[0]->IsInt32(), "Wrong arguments");
+            
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            
+            lp->priority = info[0]->Int32Value();
+        }
+        
+        static NAN_METHOD(GetPriority) {
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            
+            info.GetReturnValue().Set(lp->priority);
+        }
+        
+        // Asks the running async simplex, exact, interior or intopt to stop; it is checked by the
+        // solver between iterations and the callback then receives glp.ESTOP.
+        static NAN_METHOD(Cancel) {
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            
+            lp->cancel = 1;
+        }
+        
         GLP_BIND_VOID_STR(Problem, SetProbName, glp_set_prob_name);
         
         GLP_BIND_STR(Problem, GetProbName, glp_get_prob_name);
@@ -1254,6 +1746,8 @@ namespace NodeGLPK {
         
         GLP_BIND_VOID(Problem, SortMatrix, glp_sort_matrix);
         
+        GLP_BIND_VOID_INT32(Problem, CompactMatrix, glp_compact_matrix);
+        
         GLP_BIND_VOID_INT32ARRAY(Problem, DelRows, glp_del_rows);
         
         GLP_BIND_VOID_INT32ARRAY(Problem, DelCols, glp_del_cols);
@@ -1278,12 +1772,29 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE(Problem, GetNumNz, glp_get_num_nz);
         
-        GLP_BIND_VOID(Problem, CreateIndex, glp_create_index);
+        // createIndex(keep): a kept index survives erase and the read methods, which maintain it
+        static NAN_METHOD(CreateIndex) {
+            V8CHECK(info.Length() > 1, "Wrong number of arguments");
+            V8CHECK((info.Length() == 1) && !info[0]->IsBoolean(), "Wrong arguments");
+            
+            Problem* lp = ObjectWrap::Unwrap<Problem>(info.Holder());
+            V8CHECK(!lp->handle, "object deleted");
+            V8CHECK(lp->thread, "an async operation is inprogress");
+            
+            GLP_CATCH_RET(
+                glp_create_index(lp->handle);
+                if (info.Length() == 1) glp_keep_index(lp->handle, info[0]->BooleanValue() ? GLP_ON : GLP_OFF);
+            )
+        }
         
         GLP_BIND_VALUE_STR(Problem, FindRow, glp_find_row);
         
         GLP_BIND_VALUE_STR(Problem, FindCol, glp_find_col);
         
+        GLP_BIND_BULK_FIND(Problem, FindRows, glp_find_row);
+        
+        GLP_BIND_BULK_FIND(Problem, FindCols, glp_find_col);
+        
         GLP_BIND_VOID(Problem, DeleteIndex, glp_delete_index);
         
         GLP_BIND_VOID_INT32_DOUBLE(Problem, SetRii, glp_set_rii);
@@ -1353,11 +1864,17 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE(Problem, GetNumBin, glp_get_num_bin);
         
-        GLP_BIND_VALUE_INT32_STR(Problem, ReadProbSync, glp_read_prob);
+        GLP_BIND_VALUE_INT32_FILE(Problem, ReadProbSync, glp_read_prob);
         GLP_ASYNC_INT32_INT32_STR(Problem, ReadProb, glp_read_prob);
         
-        GLP_BIND_VALUE_INT32_STR(Problem, WriteProbSync, glp_write_prob);
+        GLP_BIND_VALUE_INT32_FILE(Problem, WriteProbSync, glp_write_prob);
         GLP_ASYNC_INT32_INT32_STR(Problem, WriteProb, glp_write_prob);
+
+        GLP_BIND_VALUE_INT32_FILE(Problem, ReadBinSync, glp_read_bin);
+        GLP_ASYNC_INT32_INT32_STR(Problem, ReadBin, glp_read_bin);
+
+        GLP_BIND_VALUE_INT32_FILE(Problem, WriteBinSync, glp_write_bin);
+        GLP_ASYNC_INT32_INT32_STR(Problem, WriteBin, glp_write_bin);
         
         GLP_BIND_VALUE(Problem, MipStatus, glp_mip_status);
         
@@ -1367,31 +1884,31 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, MipColVal, glp_mip_col_val);
         
-        GLP_BIND_VALUE_STR(Problem, PrintSolSync, glp_print_sol);
+        GLP_BIND_VALUE_FILE(Problem, PrintSolSync, glp_print_sol);
         GLP_ASYNC_INT32_STR(Problem, PrintSol, glp_print_sol);
         
-        GLP_BIND_VALUE_STR(Problem, ReadSolSync, glp_read_sol);
+        GLP_BIND_VALUE_FILE(Problem, ReadSolSync, glp_read_sol);
         GLP_ASYNC_INT32_STR(Problem, ReadSol, glp_read_sol);
         
-        GLP_BIND_VALUE_STR(Problem, WriteSolSync, glp_write_sol);
+        GLP_BIND_VALUE_FILE(Problem, WriteSolSync, glp_write_sol);
         GLP_ASYNC_INT32_STR(Problem, WriteSol, glp_write_sol);
         
-        GLP_BIND_VALUE_STR(Problem, PrintIptSync, glp_print_ipt);
+        GLP_BIND_VALUE_FILE(Problem, PrintIptSync, glp_print_ipt);
         GLP_ASYNC_INT32_STR(Problem, PrintIpt, glp_print_ipt);
         
-        GLP_BIND_VALUE_STR(Problem, ReadIptSync, glp_read_ipt);
+        GLP_BIND_VALUE_FILE(Problem, ReadIptSync, glp_read_ipt);
         GLP_ASYNC_INT32_STR(Problem, ReadIpt, glp_read_ipt);
         
-        GLP_BIND_VALUE_STR(Problem, WriteIptSync, glp_write_ipt);
+        GLP_BIND_VALUE_FILE(Problem, WriteIptSync, glp_write_ipt);
         GLP_ASYNC_INT32_STR(Problem, WriteIpt, glp_write_ipt);
         
-        GLP_BIND_VALUE_STR(Problem, PrintMipSync, glp_print_mip);
+        GLP_BIND_VALUE_FILE(Problem, PrintMipSync, glp_print_mip);
         GLP_ASYNC_INT32_STR(Problem, PrintMip, glp_print_mip);
         
-        GLP_BIND_VALUE_STR(Problem, ReadMipSync, glp_read_mip);
+        GLP_BIND_VALUE_FILE(Problem, ReadMipSync, glp_read_mip);
         GLP_ASYNC_INT32_STR(Problem, ReadMip, glp_read_mip);
         
-        GLP_BIND_VALUE_STR(Problem, WriteMipSync, glp_write_mip);
+        GLP_BIND_VALUE_FILE(Problem, WriteMipSync, glp_write_mip);
         GLP_ASYNC_INT32_STR(Problem, WriteMip, glp_write_mip);
         
         GLP_BIND_VALUE(Problem, BfExists, glp_bf_exists);
@@ -1406,6 +1923,42 @@ namespace NodeGLPK {
         
         GLP_BIND_VALUE_INT32(Problem, GetColBind, glp_get_col_bind);
         
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, GetRowPrims, glp_get_row_prim, glp_get_num_rows);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, GetRowDuals, glp_get_row_dual, glp_get_num_rows);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, GetColPrims, glp_get_col_prim, glp_get_num_cols);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, GetColDuals, glp_get_col_dual, glp_get_num_cols);
+        
+        GLP_BIND_BULK_INT32ARRAY(Problem, GetRowStats, glp_get_row_stat, glp_get_num_rows);
+        
+        GLP_BIND_BULK_INT32ARRAY(Problem, GetColStats, glp_get_col_stat, glp_get_num_cols);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, IptRowPrims, glp_ipt_row_prim, glp_get_num_rows);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, IptRowDuals, glp_ipt_row_dual, glp_get_num_rows);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, IptColPrims, glp_ipt_col_prim, glp_get_num_cols);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, IptColDuals, glp_ipt_col_dual, glp_get_num_cols);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, MipRowVals, glp_mip_row_val, glp_get_num_rows);
+        
+        GLP_BIND_BULK_FLOAT64ARRAY(Problem, MipColVals, glp_mip_col_val, glp_get_num_cols);
+        
+        GLP_BIND_BULK_SET_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(Problem, SetRowsBnds, glp_set_row_bnds, glp_get_num_rows);
+        
+        GLP_BIND_BULK_SET_INT32ARRAY_FLOAT64ARRAY_FLOAT64ARRAY(Problem, SetColsBnds, glp_set_col_bnds, glp_get_num_cols);
+        
+        GLP_BIND_BULK_SET_FLOAT64ARRAY(Problem, SetObjCoefs, glp_set_obj_coef, glp_get_num_cols);
+        
+        GLP_BIND_BULK_SET_INT32ARRAY(Problem, SetColKinds, glp_set_col_kind, glp_get_num_cols);
+        
+        GLP_BIND_BULK_SET_NAMES(Problem, SetRowNames, glp_set_row_name, glp_get_num_rows);
+        
+        GLP_BIND_BULK_SET_NAMES(Problem, SetColNames, glp_set_col_name, glp_get_num_cols);
+        
         GLP_BIND_DELETE(Problem, Delete, glp_delete_prob);
         
         //void glp_ftran(glp_prob *P, double x[]);
@@ -1439,6 +1992,8 @@ namespace NodeGLPK {
     public:
         glp_prob *handle;
         bool thread;
+        int priority;
+        volatile int cancel;
     };
     
     Nan::Persistent<FunctionTemplate> Problem::constructor;
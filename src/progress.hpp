@@ -0,0 +1,105 @@
+#ifndef _progress_hpp
+#define _progress_hpp
+
+#include <node.h>
+
+#include "glpk/glpk.h"
+#include "common.h"
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    // Delivers glp_prog snapshots from a solver thread to a cbProgress function. Only the most
+    // recent snapshot is kept, so a slow listener never blocks the solve.
+    class SolverProgress {
+    public:
+        explicit SolverProgress(Nan::Callback *callback): callback(callback), pending(false){
+            uv_mutex_init(&mutex);
+            async = new uv_async_t;
+            uv_async_init(Nan::GetCurrentEventLoop(), async, Send);
+            async->data = this;
+        }
+
+        ~SolverProgress(){
+            delete callback;
+            uv_mutex_destroy(&mutex);
+            uv_close((uv_handle_t*)async, Close);
+        }
+
+        // Replaces the synchronous callback installed by SmcpInit/IptcpInit with a channel
+        // posting to the main thread, returns NULL if no cbProgress was given.
+        template<class PARM> static SolverProgress* Detach(PARM *parm){
+            if (parm->prog_func != Call) return NULL;
+            SolverProgress *progress = new SolverProgress((Nan::Callback*)parm->prog_info);
+            parm->prog_func = Post;
+            parm->prog_info = progress;
+            return progress;
+        }
+
+        template<class PARM> static void Release(PARM *parm){
+            if (parm->prog_func == Call) delete (Nan::Callback*)parm->prog_info;
+            parm->prog_func = NULL;
+            parm->prog_info = NULL;
+        }
+
+        // Main thread: delivers the pending snapshot, if any.
+        void Flush(){
+            uv_mutex_lock(&mutex);
+            glp_prog copy = snap;
+            bool ready = pending;
+            pending = false;
+            uv_mutex_unlock(&mutex);
+            if (!ready) return;
+
+            Nan::HandleScope scope;
+            Emit(callback, &copy);
+        }
+
+        // prog_func of synchronous solves, runs on the main thread.
+        static void Call(const glp_prog *prog, void *info){
+            Nan::HandleScope scope;
+            Emit((Nan::Callback*)info, prog);
+        }
+
+        // prog_func of asynchronous solves, runs on the solver thread.
+        static void Post(const glp_prog *prog, void *info){
+            SolverProgress *self = (SolverProgress*)info;
+            uv_mutex_lock(&self->mutex);
+            self->snap = *prog;
+            self->pending = true;
+            uv_mutex_unlock(&self->mutex);
+            uv_async_send(self->async);
+        }
+
+    private:
+        static void Emit(Nan::Callback *callback, const glp_prog *prog){
+            Local<Object> ev = Nan::New<Object>();
+            GLP_SET_FIELD_INT32(ev, "phase", prog->phase);
+            GLP_SET_FIELD_INT32(ev, "itCnt", prog->it_cnt);
+            GLP_SET_FIELD_DOUBLE(ev, "obj", prog->obj);
+            GLP_SET_FIELD_DOUBLE(ev, "pInf", prog->pinf);
+            GLP_SET_FIELD_DOUBLE(ev, "dInf", prog->dinf);
+            GLP_SET_FIELD_DOUBLE(ev, "gap", prog->gap);
+            GLP_SET_FIELD_INT32(ev, "invCnt", prog->inv_cnt);
+            Local<Value> info[] = {ev};
+            callback->Call(1, info);
+        }
+
+        static NAUV_WORK_CB(Send) {
+            ((SolverProgress*)async->data)->Flush();
+        }
+
+        static void Close(uv_handle_t* handle) {
+            delete (uv_async_t*)handle;
+        }
+
+        Nan::Callback *callback;
+        uv_async_t *async;
+        uv_mutex_t mutex;
+        glp_prog snap;
+        bool pending;
+    };
+}
+
+#endif
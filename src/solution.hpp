@@ -0,0 +1,90 @@
+#ifndef _solution_hpp
+#define _solution_hpp
+
+#include <node.h>
+
+#include "glpk/glpk.h"
+#include "common.h"
+
+#define GLP_SOLUTION_FIELD(OBJ, KEY, VALUE)\
+OBJ->ForceSet(Nan::New<String>(KEY).ToLocalChecked(), VALUE, static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+namespace NodeGLPK {
+
+    using namespace v8;
+
+    // Snapshot of a solution handed to the callback of an async solve. It owns its arrays, so
+    // the Problem can be modified or solved again while the snapshot is still in use. Arrays
+    // are 1-based like the rest of the API, element 0 is unused.
+    class Solution {
+    public:
+        static void Init(Handle<Object> exports){
+            Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>();
+            tpl->SetClassName(Nan::New("Solution").ToLocalChecked());
+            constructor.Reset(tpl);
+        }
+
+        // Must be called on the main thread while no other operation runs on the problem.
+        static Local<Object> Capture(glp_prob *lp, int kind){
+            int m = glp_get_num_rows(lp), n = glp_get_num_cols(lp);
+            Local<Object> ret = Nan::New<FunctionTemplate>(constructor)->GetFunction()->NewInstance();
+
+            GLP_SOLUTION_FIELD(ret, "kind", Nan::New<Int32>(kind));
+            switch (kind) {
+                case GLP_SOL: {
+                    GLP_SOLUTION_FIELD(ret, "status", Nan::New<Int32>(glp_get_status(lp)));
+                    GLP_SOLUTION_FIELD(ret, "primStat", Nan::New<Int32>(glp_get_prim_stat(lp)));
+                    GLP_SOLUTION_FIELD(ret, "dualStat", Nan::New<Int32>(glp_get_dual_stat(lp)));
+                    GLP_SOLUTION_FIELD(ret, "obj", Nan::New<Number>(glp_get_obj_val(lp)));
+                    GLP_SOLUTION_FIELD(ret, "rowPrim", Float64(lp, m, glp_get_row_prim));
+                    GLP_SOLUTION_FIELD(ret, "rowDual", Float64(lp, m, glp_get_row_dual));
+                    GLP_SOLUTION_FIELD(ret, "colPrim", Float64(lp, n, glp_get_col_prim));
+                    GLP_SOLUTION_FIELD(ret, "colDual", Float64(lp, n, glp_get_col_dual));
+                    GLP_SOLUTION_FIELD(ret, "rowStat", Int32(lp, m, glp_get_row_stat));
+                    GLP_SOLUTION_FIELD(ret, "colStat", Int32(lp, n, glp_get_col_stat));
+                    break;
+                }
+                case GLP_IPT: {
+                    GLP_SOLUTION_FIELD(ret, "status", Nan::New<Int32>(glp_ipt_status(lp)));
+                    GLP_SOLUTION_FIELD(ret, "obj", Nan::New<Number>(glp_ipt_obj_val(lp)));
+                    GLP_SOLUTION_FIELD(ret, "rowPrim", Float64(lp, m, glp_ipt_row_prim));
+                    GLP_SOLUTION_FIELD(ret, "rowDual", Float64(lp, m, glp_ipt_row_dual));
+                    GLP_SOLUTION_FIELD(ret, "colPrim", Float64(lp, n, glp_ipt_col_prim));
+                    GLP_SOLUTION_FIELD(ret, "colDual", Float64(lp, n, glp_ipt_col_dual));
+                    break;
+                }
+                case GLP_MIP: {
+                    GLP_SOLUTION_FIELD(ret, "status", Nan::New<Int32>(glp_mip_status(lp)));
+                    GLP_SOLUTION_FIELD(ret, "obj", Nan::New<Number>(glp_mip_obj_val(lp)));
+                    GLP_SOLUTION_FIELD(ret, "rowPrim", Float64(lp, m, glp_mip_row_val));
+                    GLP_SOLUTION_FIELD(ret, "colPrim", Float64(lp, n, glp_mip_col_val));
+                    break;
+                }
+            }
+            return ret;
+        }
+
+    private:
+        static Local<Float64Array> Float64(glp_prob *lp, int count, double (*get)(glp_prob*, int)){
+            Local<ArrayBuffer> buf = ArrayBuffer::New(Isolate::GetCurrent(), (count + 1) * sizeof(double));
+            double *data = (double*)buf->GetContents().Data();
+            data[0] = 0.0;
+            for (int i = 1; i <= count; i++) data[i] = get(lp, i);
+            return Float64Array::New(buf, 0, count + 1);
+        }
+
+        static Local<Int32Array> Int32(glp_prob *lp, int count, int (*get)(glp_prob*, int)){
+            Local<ArrayBuffer> buf = ArrayBuffer::New(Isolate::GetCurrent(), (count + 1) * sizeof(int));
+            int *data = (int*)buf->GetContents().Data();
+            data[0] = 0;
+            for (int i = 1; i <= count; i++) data[i] = get(lp, i);
+            return Int32Array::New(buf, 0, count + 1);
+        }
+
+        static Nan::Persistent<FunctionTemplate> constructor;
+    };
+
+    Nan::Persistent<FunctionTemplate> Solution::constructor;
+}
+
+#endif
@@ -130,26 +130,15 @@ namespace NodeGLPK {
             V8CHECK(!tree->handle, "object deleted");
             V8CHECK(tree->thread, "an async operation is inprogress");
             
-            Local<Int32Array> ind = Local<Int32Array>::Cast(info[3]);
-            Local<Float64Array> val = Local<Float64Array>::Cast(info[4]);
+            Nan::TypedArrayContents<int> ind(info[3]);
+            Nan::TypedArrayContents<double> val(info[4]);
             
-            unsigned int count = ind->Length();
-            V8CHECK((count < 1) || (count != val->Length()), "Invalid arrays length");
-            
-            int* pind = (int*)malloc(count * sizeof(int));
-            double* pval = (double*)malloc(count * sizeof(double));
-            
-            for (unsigned int i = 0; i < count; i++){
-                pind[i] = ind->Int32Value();
-                pval[i] = val->NumberValue();
-            }
+            size_t count = ind.length();
+            V8CHECK((count < 1) || (count != val.length()), "Invalid arrays length");
             
             count--;
             GLP_CATCH(info.GetReturnValue().Set(glp_ios_add_row(tree->handle, V8TOCSTRING(info[0]), info[1]->Int32Value(),
-                info[2]->Int32Value(), count, pind, pval, info[5]->Int32Value(), info[6]->NumberValue()));)
-            
-            free(pind);
-            free(pval);
+                info[2]->Int32Value(), (int)count, *ind, *val, info[5]->Int32Value(), info[6]->NumberValue()));)
         }
         
         GLP_BIND_VOID_INT32(Tree, DelRow, glp_ios_del_row);
@@ -170,15 +159,12 @@ namespace NodeGLPK {
             V8CHECK(!tree->handle, "object deleted");
             V8CHECK(tree->thread, "an async operation is inprogress");
             
-            Local<Float64Array> x = Local<Float64Array>::Cast(info[0]);
+            Nan::TypedArrayContents<double> x(info[0]);
             
-            int count = (int)x->Length();
+            int count = (int)x.length();
             GLP_CATCH_RET(V8CHECK(count != (glp_get_num_cols(glp_ios_get_prob(tree->handle)) + 1), "Invalid arrays length");)
             
-            double* px = (double*)malloc(count * sizeof(double));
-            for (int i = 0; i < count; i++) px[i] = x->NumberValue();
-            GLP_CATCH(info.GetReturnValue().Set(glp_ios_heur_sol(tree->handle, px));)
-            free(px);
+            GLP_CATCH(info.GetReturnValue().Set(glp_ios_heur_sol(tree->handle, *x));)
         }
     public:
         static Nan::Persistent<FunctionTemplate> constructor;